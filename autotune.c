@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "pid_controller.h"
+#include "valve_simulator.h"
+#include "plant.h"
+#include "relay_autotune.h"
+#include "step_metrics.h"
+
+// Relay-feedback auto-tuning of the valve loop in one run
+// Usage: autotune [rule] [setpoint] [relay_amplitude] [hysteresis]
+// 1) A relay drives the valve around the setpoint until the limit cycle is measured
+// 2) Gains from the chosen rule are loaded into the PID with a bumpless switchover
+// 3) The tuned loop holds the setpoint, then takes a 25% step (scored by step_metrics)
+
+#define SAMPLE_TIME      0.01f
+#define MAX_RELAY_TIME   60.0f  // Give up if no steady limit cycle by then
+#define HOLD_TIME        5.0f   // Tuned loop at the experiment setpoint
+#define STEP_TIME        10.0f  // Then the step
+#define STEP_SIZE        25.0f
+#define SETTLING_BAND    0.01f
+#define RISE_FRACTION    0.95f
+
+// Manual Day 4 gains, for comparison
+#define MANUAL_KP 5.0f
+#define MANUAL_KI 4.0f
+#define MANUAL_KD 0.1f
+
+static float clamp_command(float command) {
+    if (command < 0.0f) command = 0.0f;
+    if (command > 100.0f) command = 100.0f;
+    return command;
+}
+
+// Closed loop from the switchover: hold, then step; optionally log every sample
+static void run_tuned(PIDController* pid, const PlantInterface* plant, float step_setpoint,
+                      float start_time, StepMetrics* metrics, FILE* log) {
+    long hold_steps = (long)(HOLD_TIME / SAMPLE_TIME);
+    long total_steps = hold_steps + (long)(STEP_TIME / SAMPLE_TIME);
+
+    step_metrics_init(metrics, SETTLING_BAND, RISE_FRACTION, 0.0f, 100.0f);
+    for (long k = 0; k < total_steps; k++) {
+        if (k == hold_steps) pid_set_setpoint(pid, step_setpoint);
+
+        float measurement = plant->get_position(plant->state);
+        float command = clamp_command(pid_compute(pid, measurement));
+        step_metrics_update(metrics, pid, measurement, command);
+        plant->update(plant->state, command, SAMPLE_TIME);
+
+        if (log != NULL) {
+            float position = plant->get_position(plant->state);
+            fprintf(log, "%.2f,%.1f,%.1f,%.1f,%.1f\n", start_time + k * SAMPLE_TIME,
+                    pid->setpoint, position, pid->setpoint - position, command);
+        }
+    }
+}
+
+static void print_usage(const char* name) {
+    printf("Usage: %s [rule] [setpoint] [relay_amplitude] [hysteresis]\n", name);
+    printf("Rules:");
+    for (int r = 0; r < TUNE_RULE_COUNT; r++) printf(" %s", relay_autotune_rule_name(r));
+    printf("\nExample: %s tl 50 10 1.0\n", name);
+}
+
+int main(int argc, char* argv[])
+{
+    TuningRule rule = TUNE_TYREUS_LUYBEN;
+    float setpoint = 50.0f;
+    float amplitude = 10.0f;
+    float hysteresis = 1.0f; // Well above the sensor noise
+
+    if (argc >= 2)
+        {
+            int r = relay_autotune_rule_from_name(argv[1]);
+            if (r < 0)
+                {
+                    print_usage(argv[0]);
+                    return -1;
+                }
+            rule = (TuningRule)r;
+        }
+    if (argc >= 3) setpoint = atof(argv[2]);
+    if (argc >= 4) amplitude = atof(argv[3]);
+    if (argc >= 5) hysteresis = atof(argv[4]);
+
+    if (setpoint <= 0.0f || setpoint >= 100.0f || amplitude <= 0.0f || hysteresis < 0.0f)
+        {
+            printf("Error: need 0 < setpoint < 100, amplitude > 0, hysteresis >= 0\n");
+            return -1;
+        }
+
+    ValveSimulator valve;
+    PlantInterface plant;
+    valve_init(&valve, 0.2f, 0.0f); // Same valve as main.c
+    plant_from_valve(&plant, &valve);
+
+    char filename[100];
+    sprintf(filename, "autotune_%s.csv", relay_autotune_rule_name(rule));
+    FILE* log = fopen(filename, "w");
+    if (log == NULL)
+        {
+            printf("Error opening log file!\n");
+            return -1;
+        }
+    fprintf(log, "Time,Setpoint,Position,Error,Command\n");
+
+    // 1) Relay experiment, starting with the setpoint as the bias guess
+    RelayAutotune tune;
+    relay_autotune_init(&tune, setpoint, setpoint, amplitude, hysteresis, SAMPLE_TIME);
+
+    printf("Relay Auto-Tune\n");
+    printf("- Setpoint: %.1f%%, relay amplitude: %.1f%%, hysteresis: %.2f%%\n",
+           setpoint, amplitude, hysteresis);
+
+    long max_samples = (long)(MAX_RELAY_TIME / SAMPLE_TIME);
+    while (!tune.done && tune.samples < max_samples)
+        {
+            float command = relay_autotune_update(&tune, plant.get_position(plant.state));
+            plant.update(plant.state, command, SAMPLE_TIME);
+
+            float position = plant.get_position(plant.state);
+            fprintf(log, "%.2f,%.1f,%.1f,%.1f,%.1f\n", (tune.samples - 1) * SAMPLE_TIME,
+                    setpoint, position, setpoint - position, command);
+        }
+    if (!tune.done)
+        {
+            printf("Error: no steady limit cycle after %.0f s (try a larger amplitude)!\n", MAX_RELAY_TIME);
+            fclose(log);
+            return -1;
+        }
+
+    float experiment_time = tune.samples * SAMPLE_TIME;
+    printf("- Limit cycle: %d cycles in %.2f s, amplitude %.2f%% (fundamental %.2f%%), bias %.1f%%\n",
+           tune.cycles, experiment_time, tune.oscillation, tune.harmonic, tune.bias);
+    printf("- Ultimate gain Ku = %.3f, ultimate period Pu = %.3f s\n\n", tune.ultimate_gain, tune.ultimate_period);
+
+    // 2) Every rule from the same experiment, each started bumplessly from the
+    //    valve state at the switchover and scored on the same step
+    float step_setpoint = (setpoint + STEP_SIZE <= 100.0f) ? setpoint + STEP_SIZE : setpoint - STEP_SIZE;
+    printf("Step %.1f%% -> %.1f%% after %.0f s of holding\n", setpoint, step_setpoint, HOLD_TIME);
+    printf("Rule    Kp      Ki       Kd      Rise(s)  Over(%%)  Settle(s)  IAE\n");
+    printf("------  ------  -------  ------  -------  -------  ---------  -------\n");
+
+    StepMetrics metrics;
+    PIDController pid;
+    for (int r = 0; r <= TUNE_RULE_COUNT; r++)
+        {
+            ValveSimulator trial = valve;
+            PlantInterface trial_plant;
+            plant_from_valve(&trial_plant, &trial);
+
+            pid_init(&pid, MANUAL_KP, MANUAL_KI, MANUAL_KD, SAMPLE_TIME);
+            if (r < TUNE_RULE_COUNT) relay_autotune_apply(&tune, (TuningRule)r, &pid);
+            else pid_set_setpoint(&pid, setpoint); // Manual gains, cold start
+
+            run_tuned(&pid, &trial_plant, step_setpoint, experiment_time, &metrics, NULL);
+            printf("%-6s  %-6.3f  %-7.3f  %-6.3f  %-7.2f  %-7.2f  %-9.2f  %.3f%s\n",
+                   r < TUNE_RULE_COUNT ? relay_autotune_rule_name((TuningRule)r) : "manual",
+                   pid.kp, pid.ki, pid.kd, metrics.rise_time, metrics.overshoot,
+                   metrics.settling_time, metrics.iae, r == (int)rule ? "  <- selected" : "");
+        }
+
+    // 3) The selected rule on the real loop (continuing the log)
+    pid_init(&pid, MANUAL_KP, MANUAL_KI, MANUAL_KD, SAMPLE_TIME);
+    relay_autotune_apply(&tune, rule, &pid);
+    PIDController probe = pid;
+    float first_pid_command = clamp_command(pid_compute(&probe, tune.last_measurement));
+    run_tuned(&pid, &plant, step_setpoint, experiment_time, &metrics, log);
+    fclose(log);
+
+    printf("\n=== Switchover (%s) ===\n", relay_autotune_rule_name(rule));
+    printf("Last relay command: %.1f%%, PID command at the same measurement: %.1f%%\n",
+           tune.command, first_pid_command);
+    printf("\n=== Step Response ===\n");
+    step_metrics_print(&metrics);
+    printf("\nRelay and tuned loop logged to %s\n", filename);
+    return 0;
+}
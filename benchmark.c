@@ -0,0 +1,532 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pid_controller.h"
+#include "pid_bank.h"
+#include "plant_bank.h"
+#include "gain_schedule.h"
+#include "pid_params.h"
+#include "valve_simulator.h"
+
+// Hot-path microbenchmarks
+// Every case reports nanoseconds per call (best of several repetitions) and
+// calls per second. Results go to a CSV that later runs compare against.
+
+#define BENCH_REPETITIONS  7
+#define BENCH_MIN_NS       50000000ull // Each repetition runs at least 50 ms
+#define BENCH_MAX_CASES    64
+#define MEASUREMENT_COUNT  1024        // Must be a power of two
+#define DEFAULT_THRESHOLD  10.0        // Percent slowdown flagged as regression
+
+typedef struct {
+    char name[64];
+    double ns_per_call;
+    double calls_per_sec;
+} BenchResult;
+
+// Work function: perform `iterations` operations, return number of calls made
+typedef long (*BenchFunction)(void* context, long iterations);
+
+static volatile float sink;
+static float measurements[MEASUREMENT_COUNT];
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Time a work function: grow the iteration count until one run takes
+// BENCH_MIN_NS, then keep the fastest of BENCH_REPETITIONS runs
+static BenchResult bench_run(const char* name, BenchFunction fn, void* context) {
+    BenchResult result;
+    long iterations = 1000;
+
+    for (;;) {
+        uint64_t t0 = now_ns();
+        fn(context, iterations);
+        uint64_t elapsed = now_ns() - t0;
+        if (elapsed >= BENCH_MIN_NS) break;
+        iterations *= (elapsed < BENCH_MIN_NS / 10) ? 10 : 2;
+    }
+
+    double best = 1e30;
+    for (int r = 0; r < BENCH_REPETITIONS; r++) {
+        uint64_t t0 = now_ns();
+        long calls = fn(context, iterations);
+        uint64_t elapsed = now_ns() - t0;
+        double ns = (double)elapsed / (double)calls;
+        if (ns < best) best = ns;
+    }
+
+    snprintf(result.name, sizeof(result.name), "%s", name);
+    result.ns_per_call = best;
+    result.calls_per_sec = 1e9 / best;
+    return result;
+}
+
+// --- pid_compute in each feature combination ---
+
+static long bench_pid_compute(void* context, long iterations) {
+    PIDController* pid = (PIDController*)context;
+    float acc = 0.0f;
+    for (long i = 0; i < iterations; i++) {
+        // Periodic setpoint moves keep the ramp kernel busy
+        if ((i & 4095) == 0) pid_set_setpoint_ramped(pid, (i & 4096) ? 75.0f : 50.0f);
+        acc += pid_compute(pid, measurements[i & (MEASUREMENT_COUNT - 1)]);
+    }
+    sink = acc;
+    return iterations;
+}
+
+// --- live parameter hot-swap ---
+
+typedef struct {
+    PIDController pid;
+    PidParamsExchange exchange;
+    PidParams params[2];
+} HotSwapBench;
+
+// pid_compute with a poll every tick; a new set is published every 4096 ticks
+static long bench_hot_swap(void* context, long iterations) {
+    HotSwapBench* b = (HotSwapBench*)context;
+    float acc = 0.0f;
+    for (long i = 0; i < iterations; i++) {
+        if ((i & 4095) == 0) pid_params_publish(&b->exchange, &b->params[(i >> 12) & 1]);
+        pid_params_poll(&b->exchange, &b->pid);
+        acc += pid_compute(&b->pid, measurements[i & (MEASUREMENT_COUNT - 1)]);
+    }
+    sink = acc;
+    return iterations;
+}
+
+// --- valve_update ---
+
+static long bench_valve_update(void* context, long iterations) {
+    ValveSimulator* valve = (ValveSimulator*)context;
+    for (long i = 0; i < iterations; i++) {
+        valve_update(valve, measurements[i & (MEASUREMENT_COUNT - 1)], 0.01f);
+    }
+    sink = valve->position;
+    return iterations;
+}
+
+// --- gain schedule lookups ---
+
+typedef struct {
+    GainSchedule schedule;
+    PIDController pid;
+    PIDBank bank;
+    int channels;
+} ScheduleBench;
+
+// Scheduled pid_compute: bumpless lookup before every step
+static long bench_schedule_scalar(void* context, long iterations) {
+    ScheduleBench* b = (ScheduleBench*)context;
+    float acc = 0.0f;
+    for (long i = 0; i < iterations; i++) {
+        float measurement = measurements[i & (MEASUREMENT_COUNT - 1)];
+        gain_schedule_apply(&b->schedule, &b->pid, measurement);
+        acc += pid_compute(&b->pid, measurement);
+    }
+    sink = acc;
+    return iterations;
+}
+
+// Lookup alone over a bank, per channel
+static long bench_schedule_bank(void* context, long iterations) {
+    ScheduleBench* b = (ScheduleBench*)context;
+    long ticks = iterations / b->channels + 1;
+    for (long t = 0; t < ticks; t++) {
+        gain_schedule_apply_bank(&b->schedule, &b->bank, measurements + (t & 1) * 512, b->channels);
+    }
+    sink = b->bank.kp[0];
+    return ticks * b->channels;
+}
+
+// --- closed loop over N channels ---
+
+typedef struct {
+    int channels;
+    PIDController* pids;
+    ValveSimulator* valves;
+    PIDBank bank;
+    PlantBank plants;
+    float* inputs;
+    float* outputs;
+} ClosedLoopBench;
+
+static void closed_loop_setup(ClosedLoopBench* b, int channels) {
+    b->channels = channels;
+    b->pids = malloc(sizeof(PIDController) * channels);
+    b->valves = malloc(sizeof(ValveSimulator) * channels);
+    b->inputs = malloc(sizeof(float) * channels);
+    b->outputs = malloc(sizeof(float) * channels);
+    if (b->pids == NULL || b->valves == NULL || b->inputs == NULL || b->outputs == NULL ||
+        pid_bank_init(&b->bank, channels) != 0 || plant_bank_init(&b->plants, channels, 0.01f) != 0) {
+        printf("Error allocating %d channels!\n", channels);
+        exit(-1);
+    }
+
+    for (int i = 0; i < channels; i++) {
+        pid_init(&b->pids[i], 5.0f, 4.0f, 0.1f, 0.01f);
+        pid_set_setpoint(&b->pids[i], 25.0f + (float)(i % 50));
+        pid_bank_load(&b->bank, i, &b->pids[i]);
+        valve_init(&b->valves[i], 0.2f, 0.0f);
+        b->valves[i].disturbance = 0.0f;
+        plant_bank_load_valve(&b->plants, i, &b->valves[i]);
+    }
+}
+
+static void closed_loop_teardown(ClosedLoopBench* b) {
+    pid_bank_free(&b->bank);
+    plant_bank_free(&b->plants);
+    free(b->pids);
+    free(b->valves);
+    free(b->inputs);
+    free(b->outputs);
+}
+
+static float clamp_command(float c) {
+    if (c < 0.0f) c = 0.0f;
+    if (c > 100.0f) c = 100.0f;
+    return c;
+}
+
+// Scalar loop: pid_compute + clamp + valve_update per channel
+static long bench_closed_loop_scalar(void* context, long iterations) {
+    ClosedLoopBench* b = (ClosedLoopBench*)context;
+    long ticks = iterations / b->channels + 1;
+    for (long t = 0; t < ticks; t++) {
+        for (int i = 0; i < b->channels; i++) {
+            float c = pid_compute(&b->pids[i], b->valves[i].position);
+            valve_update(&b->valves[i], clamp_command(c), 0.01f);
+        }
+    }
+    sink = b->valves[0].position;
+    return ticks * b->channels;
+}
+
+// Batched loop: pid_bank_compute over all channels, then the valves
+static long bench_closed_loop_bank(void* context, long iterations) {
+    ClosedLoopBench* b = (ClosedLoopBench*)context;
+    long ticks = iterations / b->channels + 1;
+    for (long t = 0; t < ticks; t++) {
+        for (int i = 0; i < b->channels; i++) b->inputs[i] = b->valves[i].position;
+        pid_bank_compute(&b->bank, b->inputs, b->outputs, b->channels);
+        for (int i = 0; i < b->channels; i++) {
+            valve_update(&b->valves[i], clamp_command(b->outputs[i]), 0.01f);
+        }
+    }
+    sink = b->valves[0].position;
+    return ticks * b->channels;
+}
+
+// Fully batched loop: pid_bank_compute, clamp, plant_bank_update
+static long bench_closed_loop_soa(void* context, long iterations) {
+    ClosedLoopBench* b = (ClosedLoopBench*)context;
+    long ticks = iterations / b->channels + 1;
+    for (long t = 0; t < ticks; t++) {
+        pid_bank_compute(&b->bank, b->plants.position, b->outputs, b->channels);
+        for (int i = 0; i < b->channels; i++) b->outputs[i] = clamp_command(b->outputs[i]);
+        plant_bank_update(&b->plants, b->outputs, b->channels);
+    }
+    sink = b->plants.position[0];
+    return ticks * b->channels;
+}
+
+// --- plant_bank_update, ns per channel-step ---
+
+typedef struct {
+    PlantBank plants;
+    float* commands;
+    int channels;
+} PlantBench;
+
+static void plant_bench_setup(PlantBench* b, int channels, int full_model) {
+    PlantParams params;
+    b->channels = channels;
+    b->commands = malloc(sizeof(float) * channels);
+    if (b->commands == NULL || plant_bank_init(&b->plants, channels, 0.001f) != 0) {
+        printf("Error allocating %d channels!\n", channels);
+        exit(-1);
+    }
+    plant_params_default(&params);
+    if (full_model) {
+        params.model = PLANT_SECOND_ORDER;
+        params.natural_frequency = 60.0f;
+        params.damping = 0.7f;
+        params.deadband = 0.2f;
+        params.backlash = 1.0f;
+        params.max_rate = 200.0f;
+        params.load_gain = 0.5f;
+        params.load_stiffness = 0.05f;
+    }
+    for (int i = 0; i < channels; i++) {
+        plant_bank_configure(&b->plants, i, &params);
+        b->commands[i] = measurements[i & (MEASUREMENT_COUNT - 1)];
+        b->plants.load[i] = (float)(i % 7);
+    }
+}
+
+static void plant_bench_teardown(PlantBench* b) {
+    plant_bank_free(&b->plants);
+    free(b->commands);
+}
+
+static long bench_plant_bank(void* context, long iterations) {
+    PlantBench* b = (PlantBench*)context;
+    long ticks = iterations / b->channels + 1;
+    for (long t = 0; t < ticks; t++) {
+        // Flip half the commands every 256 steps so the plants keep moving
+        if ((t & 255) == 0) {
+            for (int i = 0; i < b->channels; i += 2) b->commands[i] = 100.0f - b->commands[i];
+        }
+        plant_bank_update(&b->plants, b->commands, b->channels);
+    }
+    sink = b->plants.position[0];
+    return ticks * b->channels;
+}
+
+// --- result files ---
+
+static int write_results(const char* path, const BenchResult* results, int count) {
+    FILE* f = fopen(path, "w");
+    if (f == NULL) return -1;
+    fprintf(f, "Name,NsPerCall,CallsPerSec\n");
+    for (int i = 0; i < count; i++) {
+        fprintf(f, "%s,%.3f,%.0f\n", results[i].name, results[i].ns_per_call, results[i].calls_per_sec);
+    }
+    fclose(f);
+    return 0;
+}
+
+static int read_results(const char* path, BenchResult* results, int max_count) {
+    FILE* f = fopen(path, "r");
+    if (f == NULL) return -1;
+
+    char line[256];
+    int count = 0;
+    if (fgets(line, sizeof(line), f) == NULL) {
+        fclose(f);
+        return 0;
+    }
+    while (count < max_count && fgets(line, sizeof(line), f) != NULL) {
+        BenchResult* r = &results[count];
+        if (sscanf(line, "%63[^,],%lf,%lf", r->name, &r->ns_per_call, &r->calls_per_sec) == 3) {
+            count++;
+        }
+    }
+    fclose(f);
+    return count;
+}
+
+// Print current vs baseline; returns number of regressions beyond threshold
+static int compare_results(const BenchResult* current, int count,
+                           const BenchResult* baseline, int baseline_count,
+                           double threshold) {
+    int regressions = 0;
+
+    printf("\nCase                              Baseline(ns)  Current(ns)  Change\n");
+    printf("--------------------------------  ------------  -----------  --------\n");
+    for (int i = 0; i < count; i++) {
+        const BenchResult* base = NULL;
+        for (int j = 0; j < baseline_count; j++) {
+            if (strcmp(baseline[j].name, current[i].name) == 0) base = &baseline[j];
+        }
+        if (base == NULL) {
+            printf("%-32s  %-12s  %-11.3f  (new)\n", current[i].name, "-", current[i].ns_per_call);
+            continue;
+        }
+
+        double change = (current[i].ns_per_call - base->ns_per_call) / base->ns_per_call * 100.0;
+        int regressed = change > threshold;
+        if (regressed) regressions++;
+        printf("%-32s  %-12.3f  %-11.3f  %+7.1f%%%s\n", current[i].name,
+               base->ns_per_call, current[i].ns_per_call, change,
+               regressed ? "  << REGRESSION" : "");
+    }
+    return regressions;
+}
+
+static void print_usage(const char* name) {
+    printf("Usage: %s [--output results.csv] [--compare baseline.csv] [--threshold pct]\n", name);
+}
+
+int main(int argc, char* argv[])
+{
+    const char* output_path = "bench_results.csv";
+    const char* baseline_path = NULL;
+    double threshold = DEFAULT_THRESHOLD;
+
+    for (int i = 1; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) output_path = argv[++i];
+            else if (strcmp(argv[i], "--compare") == 0 && i + 1 < argc) baseline_path = argv[++i];
+            else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) threshold = atof(argv[++i]);
+            else
+                {
+                    print_usage(argv[0]);
+                    return -1;
+                }
+        }
+
+    // Read the baseline before anything is written: it may be the output file
+    BenchResult baseline[BENCH_MAX_CASES];
+    int baseline_count = 0;
+    if (baseline_path != NULL)
+        {
+            baseline_count = read_results(baseline_path, baseline, BENCH_MAX_CASES);
+            if (baseline_count < 0)
+                {
+                    printf("Error reading baseline %s!\n", baseline_path);
+                    return -1;
+                }
+        }
+
+    // Deterministic measurement stream around the operating point
+    unsigned int state = 12345u;
+    for (int i = 0; i < MEASUREMENT_COUNT; i++)
+        {
+            state = state * 1664525u + 1013904223u;
+            measurements[i] = 40.0f + (float)(state >> 8) / (float)(1u << 24) * 40.0f;
+        }
+
+    BenchResult results[BENCH_MAX_CASES];
+    int count = 0;
+
+    printf("Hot-Path Benchmarks\n\n");
+    printf("Case                              ns/call   calls/s\n");
+    printf("--------------------------------  --------  ------------\n");
+
+    // pid_compute: filter (F), rate limit (L), ramp (R)
+    static const char* combo_names[8] = {
+        "pid_compute/plain", "pid_compute/F", "pid_compute/L", "pid_compute/FL",
+        "pid_compute/R", "pid_compute/RF", "pid_compute/RL", "pid_compute/RFL"
+    };
+    for (int combo = 0; combo < 8; combo++)
+        {
+            PIDController pid;
+            pid_init(&pid, 5.0f, 4.0f, 0.1f, 0.01f);
+            pid_set_derivative_filter(&pid, (combo & 1) ? 0.1f : 1.0f);
+            pid_set_rate_limit(&pid, (combo & 2) ? 100.0f : 0.0f);
+            pid_set_ramp_rate(&pid, (combo & 4) ? 10.0f : 0.0f);
+            pid_set_setpoint(&pid, 50.0f);
+            results[count] = bench_run(combo_names[combo], bench_pid_compute, &pid);
+            printf("%-32s  %-8.3f  %.0f\n", results[count].name,
+                   results[count].ns_per_call, results[count].calls_per_sec);
+            count++;
+        }
+
+    // Hot-swap: the same step with a parameter poll in front of it
+    HotSwapBench swap;
+    pid_init(&swap.pid, 5.0f, 4.0f, 0.1f, 0.01f);
+    pid_set_setpoint(&swap.pid, 50.0f);
+    pid_params_exchange_init(&swap.exchange, &swap.pid);
+    pid_params_get(&swap.pid, &swap.params[0]);
+    swap.params[1] = swap.params[0];
+    swap.params[1].ki = 6.0f;
+    results[count] = bench_run("pid_compute/hot_swap", bench_hot_swap, &swap);
+    printf("%-32s  %-8.3f  %.0f\n", results[count].name,
+           results[count].ns_per_call, results[count].calls_per_sec);
+    count++;
+
+    ValveSimulator valve;
+    valve_init(&valve, 0.2f, 0.0f);
+    valve.disturbance = 0.0f;
+    results[count] = bench_run("valve_update", bench_valve_update, &valve);
+    printf("%-32s  %-8.3f  %.0f\n", results[count].name,
+           results[count].ns_per_call, results[count].calls_per_sec);
+    count++;
+
+    // Full closed-loop steps, ns per channel-step
+    static const int channel_counts[] = {1, 16, 256, 4096};
+    for (int c = 0; c < 4; c++)
+        {
+            char name[64];
+            ClosedLoopBench loop;
+
+            closed_loop_setup(&loop, channel_counts[c]);
+            snprintf(name, sizeof(name), "closed_loop_scalar/%d", channel_counts[c]);
+            results[count] = bench_run(name, bench_closed_loop_scalar, &loop);
+            printf("%-32s  %-8.3f  %.0f\n", results[count].name,
+                   results[count].ns_per_call, results[count].calls_per_sec);
+            count++;
+            closed_loop_teardown(&loop);
+
+            closed_loop_setup(&loop, channel_counts[c]);
+            snprintf(name, sizeof(name), "closed_loop_bank/%d", channel_counts[c]);
+            results[count] = bench_run(name, bench_closed_loop_bank, &loop);
+            printf("%-32s  %-8.3f  %.0f\n", results[count].name,
+                   results[count].ns_per_call, results[count].calls_per_sec);
+            count++;
+            closed_loop_teardown(&loop);
+
+            closed_loop_setup(&loop, channel_counts[c]);
+            snprintf(name, sizeof(name), "closed_loop_soa/%d", channel_counts[c]);
+            results[count] = bench_run(name, bench_closed_loop_soa, &loop);
+            printf("%-32s  %-8.3f  %.0f\n", results[count].name,
+                   results[count].ns_per_call, results[count].calls_per_sec);
+            count++;
+            closed_loop_teardown(&loop);
+        }
+
+    // Plant stepping alone: first-order lag vs second order with every effect
+    static const char* plant_names[2] = { "plant_bank/first_order/4096", "plant_bank/full_model/4096" };
+    for (int full = 0; full < 2; full++)
+        {
+            PlantBench plants;
+            plant_bench_setup(&plants, 4096, full);
+            results[count] = bench_run(plant_names[full], bench_plant_bank, &plants);
+            printf("%-32s  %-8.3f  %.0f\n", results[count].name,
+                   results[count].ns_per_call, results[count].calls_per_sec);
+            count++;
+            plant_bench_teardown(&plants);
+        }
+
+    // Gain schedule: scheduled step vs plain step, and the batch lookup alone
+    ScheduleBench schedule;
+    const GainPoint points[3] = {
+        { 10.0f, 3.0f, 2.0f, 0.05f }, { 50.0f, 5.0f, 4.0f, 0.1f }, { 90.0f, 3.0f, 2.0f, 0.05f }
+    };
+    if (gain_schedule_init(&schedule.schedule, GAIN_SCHEDULE_MEASUREMENT, 0.0f, 100.0f, 101, points, 3) != 0 ||
+        pid_bank_init(&schedule.bank, 512) != 0)
+        {
+            printf("Error allocating gain schedule!\n");
+            return -1;
+        }
+    pid_init(&schedule.pid, 5.0f, 4.0f, 0.1f, 0.01f);
+    pid_set_setpoint(&schedule.pid, 50.0f);
+    schedule.channels = 512;
+    for (int i = 0; i < schedule.channels; i++) pid_bank_load(&schedule.bank, i, &schedule.pid);
+    results[count] = bench_run("gain_schedule/scalar", bench_schedule_scalar, &schedule);
+    printf("%-32s  %-8.3f  %.0f\n", results[count].name,
+           results[count].ns_per_call, results[count].calls_per_sec);
+    count++;
+    results[count] = bench_run("gain_schedule/bank/512", bench_schedule_bank, &schedule);
+    printf("%-32s  %-8.3f  %.0f\n", results[count].name,
+           results[count].ns_per_call, results[count].calls_per_sec);
+    count++;
+    pid_bank_free(&schedule.bank);
+    gain_schedule_free(&schedule.schedule);
+
+    if (write_results(output_path, results, count) != 0)
+        {
+            printf("Error writing %s!\n", output_path);
+            return -1;
+        }
+    printf("\nResults written to %s\n", output_path);
+
+    if (baseline_path != NULL)
+        {
+            int regressions = compare_results(results, count, baseline, baseline_count, threshold);
+            printf("\n%d regression(s) beyond %.1f%%\n", regressions, threshold);
+            if (regressions > 0) return 1;
+        }
+
+    return 0;
+}
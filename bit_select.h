@@ -0,0 +1,22 @@
+#ifndef BIT_SELECT_H
+#define BIT_SELECT_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Branch-free select: returns a when cond is nonzero, otherwise b
+// Done on the bit patterns so the compiler emits a blend under strict IEEE
+// flags (it will not if-convert a floating-point ?: while -ftrapping-math is on)
+// Shared by the column kernels so their loops vectorize.
+static inline float bit_select(int cond, float a, float b) {
+    uint32_t ua, ub, r;
+    float result;
+    memcpy(&ua, &a, sizeof ua);
+    memcpy(&ub, &b, sizeof ub);
+    uint32_t mask = -(uint32_t)(cond != 0);
+    r = (ua & mask) | (ub & ~mask);
+    memcpy(&result, &r, sizeof result);
+    return result;
+}
+
+#endif // BIT_SELECT_H
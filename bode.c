@@ -0,0 +1,151 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "pid_controller.h"
+#include "plant_bank.h"
+#include "freq_response.h"
+
+// Frequency response of the closed loop for one gain set
+// Usage: bode [kp ki kd] [--filter c] [--rate-limit r] [--plant tau deadband]
+//             [--disturbance] [--amplitude a] [--range f_min f_max] [--points n]
+// Prints the Bode table and the stability margins, and writes the table to
+// bode_kp<kp>_ki<ki>_kd<kd>.csv.
+
+#define MAX_POINTS 512
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void print_usage(const char* name) {
+    printf("Usage: %s [kp ki kd] [--filter c] [--rate-limit r] [--plant tau deadband]\n", name);
+    printf("       %*s [--disturbance] [--amplitude a] [--range f_min f_max] [--points n]\n",
+           (int)strlen(name), "");
+}
+
+int main(int argc, char* argv[])
+{
+    float kp = 5.0f, ki = 4.0f, kd = 0.1f;
+    float filter = 0.1f, rate_limit = 0.0f;
+    PlantParams plant;
+    FreqOptions options;
+    plant_params_default(&plant);
+    freq_options_default(&options);
+
+    int gains = 0;
+    for (int i = 1; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+                {
+                    filter = atof(argv[++i]);
+                }
+            else if (strcmp(argv[i], "--rate-limit") == 0 && i + 1 < argc)
+                {
+                    rate_limit = atof(argv[++i]);
+                }
+            else if (strcmp(argv[i], "--plant") == 0 && i + 2 < argc)
+                {
+                    plant.time_constant = atof(argv[++i]);
+                    plant.deadband = atof(argv[++i]);
+                }
+            else if (strcmp(argv[i], "--disturbance") == 0)
+                {
+                    options.injection = FREQ_INJECT_DISTURBANCE;
+                }
+            else if (strcmp(argv[i], "--amplitude") == 0 && i + 1 < argc)
+                {
+                    options.amplitude = atof(argv[++i]);
+                }
+            else if (strcmp(argv[i], "--range") == 0 && i + 2 < argc)
+                {
+                    options.f_min = atof(argv[++i]);
+                    options.f_max = atof(argv[++i]);
+                }
+            else if (strcmp(argv[i], "--points") == 0 && i + 1 < argc)
+                {
+                    options.points = atoi(argv[++i]);
+                }
+            else if (gains < 3 && argv[i][0] != '-')
+                {
+                    float value = atof(argv[i]);
+                    if (gains == 0) kp = value;
+                    else if (gains == 1) ki = value;
+                    else kd = value;
+                    gains++;
+                }
+            else
+                {
+                    print_usage(argv[0]);
+                    return -1;
+                }
+        }
+    if ((gains != 0 && gains != 3) || options.points < 2 || options.points > MAX_POINTS)
+        {
+            print_usage(argv[0]);
+            return -1;
+        }
+
+    PIDController pid;
+    pid_init(&pid, kp, ki, kd, options.sample_time);
+    pid_set_derivative_filter(&pid, filter);
+    pid_set_rate_limit(&pid, rate_limit);
+
+    printf("Frequency Response\n");
+    printf("- Gains: Kp=%.2f, Ki=%.2f, Kd=%.3f (filter %.2f, rate limit %.0f%%/s)\n",
+           kp, ki, kd, filter, rate_limit);
+    printf("- Valve: tau %.3f s, deadband %.2f%%\n", plant.time_constant, plant.deadband);
+    printf("- Excitation: %.1f%% sine on the %s around %.0f%%, %.3f-%.1f Hz, %d points\n\n",
+           options.amplitude, options.injection == FREQ_INJECT_SETPOINT ? "setpoint" : "valve command",
+           options.bias, options.f_min, options.f_max, options.points);
+
+    FreqPoint points[MAX_POINTS];
+    double start = now_s();
+    if (freq_response_run(&pid, &plant, &options, points) != 0)
+        {
+            printf("Error: frequency range must stay below %.1f Hz!\n", 0.25f / options.sample_time);
+            return -1;
+        }
+    double elapsed = now_s() - start;
+
+    char filename[100];
+    snprintf(filename, sizeof(filename), "bode_kp%.1f_ki%.1f_kd%.1f.csv", kp, ki, kd);
+    FILE* csv = fopen(filename, "w");
+    if (csv == NULL)
+        {
+            printf("Error opening %s!\n", filename);
+            return -1;
+        }
+    fprintf(csv, "Frequency(Hz),OpenGain(dB),OpenPhase(deg),ClosedGain(dB),ClosedPhase(deg),Sensitivity(dB)\n");
+
+    printf("Freq(Hz)   |L|(dB)   L(deg)    |T|(dB)   T(deg)    |S|(dB)\n");
+    printf("---------  --------  --------  --------  --------  --------\n");
+    for (int k = 0; k < options.points; k++)
+        {
+            const FreqPoint* p = &points[k];
+            printf("%-9.4f  %-8.2f  %-8.1f  %-8.2f  %-8.1f  %.2f\n", p->frequency,
+                   p->open_gain, p->open_phase, p->closed_gain, p->closed_phase, p->sensitivity);
+            fprintf(csv, "%.5f,%.4f,%.3f,%.4f,%.3f,%.4f\n", p->frequency,
+                    p->open_gain, p->open_phase, p->closed_gain, p->closed_phase, p->sensitivity);
+        }
+    fclose(csv);
+
+    FreqMargins margins;
+    freq_response_margins(points, options.points, &margins);
+    printf("\n=== Loop Shape ===\n");
+    if (isnan(margins.crossover)) printf("Gain crossover: none in range\n");
+    else printf("Gain crossover: %.3f Hz, phase margin %.1f deg\n", margins.crossover, margins.phase_margin);
+    if (isnan(margins.phase_crossover)) printf("Phase crossover: none in range (gain margin > sweep)\n");
+    else printf("Phase crossover: %.3f Hz, gain margin %.1f dB\n", margins.phase_crossover, margins.gain_margin);
+    if (isnan(margins.bandwidth)) printf("Bandwidth (-3 dB): above %.1f Hz\n", options.f_max);
+    else printf("Bandwidth (-3 dB): %.3f Hz\n", margins.bandwidth);
+    printf("Peak |T|: %.2f dB, peak |S|: %.2f dB\n", margins.peak_closed, margins.peak_sensitivity);
+    printf("\nSwept in %.1f ms\n", elapsed * 1000.0);
+    printf("Table written to %s\n", filename);
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <stdlib.h>
+#include <string.h>
+#include "cascade.h"
+
+static long gcd(long a, long b) {
+    while (b != 0) {
+        long t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+void cascade_init(Cascade* cascade, float base_dt) {
+    memset(cascade, 0, sizeof(*cascade));
+    cascade->base_dt = base_dt;
+    cascade->propagate_windup = 1;
+}
+
+int cascade_add_loop(Cascade* cascade, float kp, float ki, float kd, int divisor) {
+    if (cascade->num_loops >= CASCADE_MAX_LOOPS || divisor <= 0) return -1;
+
+    CascadeLoop* loop = &cascade->loops[cascade->num_loops];
+    memset(loop, 0, sizeof(*loop));
+    pid_init(&loop->pid, kp, ki, kd, cascade->base_dt * (float)divisor);
+    loop->divisor = divisor;
+    return cascade->num_loops++;
+}
+
+int cascade_build(Cascade* cascade) {
+    if (cascade->num_loops == 0) return -1;
+
+    long hyperperiod = 1;
+    for (int i = 0; i < cascade->num_loops; i++) {
+        long divisor = cascade->loops[i].divisor;
+        hyperperiod = hyperperiod / gcd(hyperperiod, divisor) * divisor;
+        if (hyperperiod > CASCADE_MAX_HYPERPERIOD) return -1;
+    }
+
+    // Count first, then fill
+    long total = 0;
+    for (int i = 0; i < cascade->num_loops; i++) {
+        total += hyperperiod / cascade->loops[i].divisor;
+    }
+    free(cascade->due);
+    free(cascade->due_start);
+    cascade->due = malloc(total);
+    cascade->due_start = malloc(sizeof(int) * (hyperperiod + 1));
+    if (cascade->due == NULL || cascade->due_start == NULL) {
+        cascade_free(cascade);
+        return -1;
+    }
+
+    int count = 0;
+    for (long t = 0; t < hyperperiod; t++) {
+        cascade->due_start[t] = count;
+        for (int i = 0; i < cascade->num_loops; i++) {
+            if (t % cascade->loops[i].divisor == 0) cascade->due[count++] = (uint8_t)i;
+        }
+    }
+    cascade->due_start[hyperperiod] = count;
+    cascade->hyperperiod = (int)hyperperiod;
+    cascade->phase = 0;
+    cascade->tick = 0;
+    return 0;
+}
+
+// Run one loop; `blocked` is the saturation of the loop it feeds
+static void cascade_run_loop(Cascade* cascade, int index, float measurement, int blocked) {
+    CascadeLoop* loop = &cascade->loops[index];
+    PIDController* pid = &loop->pid;
+
+    float integral = pid->integral;
+    float output = pid_compute(pid, measurement);
+
+    // Conditional integration: undo this step's accumulation if it pushes
+    // towards the limit the inner loop is already stuck at
+    if ((blocked > 0 && pid->integral > integral) || (blocked < 0 && pid->integral < integral)) {
+        float correction = pid->ki * (pid->integral - integral);
+        pid->integral = integral;
+        // prev_output is the unclamped output, so clamp again from there
+        pid->prev_output -= correction;
+        output = pid->prev_output;
+        if (output > pid->output_max) output = pid->output_max;
+        if (output < pid->output_min) output = pid->output_min;
+        loop->windup_holds++;
+    }
+
+    loop->output = output;
+    if (output >= pid->output_max) loop->saturation = 1;
+    else if (output <= pid->output_min) loop->saturation = -1;
+    else loop->saturation = blocked;
+    loop->runs++;
+
+    if (index + 1 < cascade->num_loops) pid_set_setpoint(&cascade->loops[index + 1].pid, output);
+}
+
+float cascade_step(Cascade* cascade, const float* measurements) {
+    int last = cascade->num_loops - 1;
+    int end = cascade->due_start[cascade->phase + 1];
+
+    for (int k = cascade->due_start[cascade->phase]; k < end; k++) {
+        int i = cascade->due[k];
+        int blocked = (i < last && cascade->propagate_windup) ? cascade->loops[i + 1].saturation : 0;
+        cascade_run_loop(cascade, i, measurements[i], blocked);
+    }
+
+    if (++cascade->phase == cascade->hyperperiod) cascade->phase = 0;
+    cascade->tick++;
+    return cascade->loops[last].output;
+}
+
+void cascade_free(Cascade* cascade) {
+    free(cascade->due);
+    free(cascade->due_start);
+    cascade->due = NULL;
+    cascade->due_start = NULL;
+    cascade->hyperperiod = 0;
+}
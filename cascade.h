@@ -0,0 +1,64 @@
+#ifndef CASCADE_H
+#define CASCADE_H
+
+#include <stdint.h>
+#include "pid_controller.h"
+
+// Multi-rate cascade control
+// Loops are chained output-to-setpoint: loop 0 is the outermost (e.g. axis
+// position), each loop's output becomes the setpoint of the next one, and the
+// last loop drives the actuator (e.g. spool position or pressure). Every loop
+// runs once per `divisor` base ticks.
+//
+// cascade_build() unrolls one hyperperiod (the LCM of the divisors) into a
+// static table of the loops due at each tick, outer loops first, so a step
+// executes exactly those loops with no per-loop modulo tests.
+//
+// Anti-windup propagates outwards: while an inner loop is saturated, the
+// loops feeding it stop integrating in the direction that would push it
+// further into saturation (conditional integration).
+
+#define CASCADE_MAX_LOOPS       8
+#define CASCADE_MAX_HYPERPERIOD 65536 // Base ticks in one schedule table
+
+typedef struct {
+    PIDController pid;  // sample_time = divisor * base period
+    int divisor;        // Runs every divisor base ticks
+    float output;       // Last output (held between runs)
+    int saturation;     // +1 / -1 while this loop or one inside it is at a limit, else 0
+
+    // Statistics
+    uint64_t runs;
+    uint64_t windup_holds; // Runs where integration was held for a saturated inner loop
+} CascadeLoop;
+
+typedef struct {
+    CascadeLoop loops[CASCADE_MAX_LOOPS]; // [0] outermost ... [num_loops - 1] drives the plant
+    int num_loops;
+    float base_dt;          // Base tick period (seconds)
+    int propagate_windup;   // 1 = hold outer integrators while an inner loop saturates
+
+    // Static schedule: loops due at tick t are due[due_start[t]] .. due[due_start[t + 1] - 1]
+    int hyperperiod;
+    uint8_t* due;
+    int* due_start;
+    int phase;              // Position inside the hyperperiod
+    uint64_t tick;
+} Cascade;
+
+void cascade_init(Cascade* cascade, float base_dt);
+
+// Append a loop inside the current innermost one (returns its index, -1 if full)
+int cascade_add_loop(Cascade* cascade, float kp, float ki, float kd, int divisor);
+
+// Precompute the schedule after all loops are added (returns 0 on success, -1 on failure)
+int cascade_build(Cascade* cascade);
+
+// Run the loops due this tick
+// measurements[i] is loop i's process value (only read when loop i is due)
+// Returns the actuator command: the innermost loop's latest output
+float cascade_step(Cascade* cascade, const float* measurements);
+
+void cascade_free(Cascade* cascade);
+
+#endif // CASCADE_H
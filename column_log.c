@@ -0,0 +1,341 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "column_log.h"
+
+#define COLUMN_LOG_COPY_BLOCK 65536
+#define CSV_LINE_LENGTH       4096
+
+static uint64_t align_up(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Write zero bytes until the file reaches target
+static int write_padding(FILE* file, uint64_t* position, uint64_t target) {
+    static const char zeros[256];
+    while (*position < target) {
+        uint64_t chunk = target - *position;
+        if (chunk > sizeof(zeros)) chunk = sizeof(zeros);
+        if (fwrite(zeros, 1, (size_t)chunk, file) != chunk) return -1;
+        *position += chunk;
+    }
+    return 0;
+}
+
+static void close_spill_files(ColumnLogWriter* writer) {
+    for (int c = 0; c <= writer->num_columns; c++) {
+        if (writer->spill[c] != NULL) fclose(writer->spill[c]);
+        writer->spill[c] = NULL;
+    }
+}
+
+int column_log_writer_open(ColumnLogWriter* writer, const char* path,
+                           const char* const* names, int num_columns) {
+    if (num_columns < 1 || num_columns > COLUMN_LOG_MAX_COLUMNS) return -1;
+
+    memset(writer, 0, sizeof(*writer));
+    writer->num_columns = num_columns;
+
+    strncpy(writer->names[0], "Time", COLUMN_LOG_NAME_LENGTH - 1);
+    for (int c = 0; c < num_columns; c++) {
+        strncpy(writer->names[c + 1], names[c], COLUMN_LOG_NAME_LENGTH - 1);
+    }
+
+    for (int c = 0; c <= num_columns; c++) {
+        writer->spill[c] = tmpfile();
+        if (writer->spill[c] == NULL) {
+            close_spill_files(writer);
+            return -1;
+        }
+    }
+
+    writer->file = fopen(path, "wb");
+    if (writer->file == NULL) {
+        close_spill_files(writer);
+        return -1;
+    }
+    return 0;
+}
+
+int column_log_writer_append(ColumnLogWriter* writer, double time, const float* values) {
+    if (writer->rows > 0 && time < writer->last_time) return -1;
+
+    if (writer->rows % COLUMN_LOG_INDEX_STRIDE == 0) {
+        if (writer->index_entries == writer->index_capacity) {
+            uint64_t capacity = writer->index_capacity ? writer->index_capacity * 2 : 256;
+            double* index = realloc(writer->index, capacity * sizeof(double));
+            if (index == NULL) return -1;
+            writer->index = index;
+            writer->index_capacity = capacity;
+        }
+        writer->index[writer->index_entries++] = time;
+    }
+
+    if (fwrite(&time, sizeof(double), 1, writer->spill[0]) != 1) return -1;
+    for (int c = 0; c < writer->num_columns; c++) {
+        if (fwrite(&values[c], sizeof(float), 1, writer->spill[c + 1]) != 1) return -1;
+    }
+
+    writer->last_time = time;
+    writer->rows++;
+    return 0;
+}
+
+// Header, schema and index first, then each spilled column on its own page boundary
+int column_log_writer_close(ColumnLogWriter* writer) {
+    int status = 0;
+    uint32_t total_columns = (uint32_t)writer->num_columns + 1;
+    ColumnLogSchema schema[COLUMN_LOG_MAX_COLUMNS + 1];
+    ColumnLogHeader header;
+
+    memset(&header, 0, sizeof(header));
+    memset(schema, 0, sizeof(schema));
+
+    uint64_t index_offset = align_up(sizeof(header) + total_columns * sizeof(ColumnLogSchema), 8);
+    uint64_t offset = align_up(index_offset + writer->index_entries * sizeof(double), COLUMN_LOG_ALIGN);
+    uint64_t end = offset;
+    for (uint32_t c = 0; c < total_columns; c++) {
+        memcpy(schema[c].name, writer->names[c], COLUMN_LOG_NAME_LENGTH);
+        schema[c].type = (c == 0) ? COLUMN_TYPE_FLOAT64 : COLUMN_TYPE_FLOAT32;
+        schema[c].element_size = (c == 0) ? sizeof(double) : sizeof(float);
+        schema[c].offset = offset;
+        end = offset + writer->rows * schema[c].element_size;
+        offset = align_up(end, COLUMN_LOG_ALIGN);
+    }
+
+    memcpy(header.magic, COLUMN_LOG_MAGIC, 4);
+    header.version = COLUMN_LOG_VERSION;
+    header.num_columns = total_columns;
+    header.index_stride = COLUMN_LOG_INDEX_STRIDE;
+    header.rows = writer->rows;
+    header.index_offset = index_offset;
+    header.index_entries = writer->index_entries;
+    header.file_size = end;
+
+    uint64_t position = 0;
+    if (fwrite(&header, sizeof(header), 1, writer->file) != 1 ||
+        fwrite(schema, sizeof(ColumnLogSchema), total_columns, writer->file) != total_columns) {
+        status = -1;
+    }
+    position = sizeof(header) + total_columns * sizeof(ColumnLogSchema);
+
+    if (status == 0 && (write_padding(writer->file, &position, index_offset) != 0 ||
+                        fwrite(writer->index, sizeof(double), writer->index_entries, writer->file)
+                            != writer->index_entries)) {
+        status = -1;
+    }
+    position = index_offset + writer->index_entries * sizeof(double);
+
+    char* buffer = malloc(COLUMN_LOG_COPY_BLOCK);
+    if (buffer == NULL) status = -1;
+
+    for (uint32_t c = 0; c < total_columns && status == 0; c++) {
+        if (write_padding(writer->file, &position, schema[c].offset) != 0) {
+            status = -1;
+            break;
+        }
+        rewind(writer->spill[c]);
+        size_t count;
+        while ((count = fread(buffer, 1, COLUMN_LOG_COPY_BLOCK, writer->spill[c])) > 0) {
+            if (fwrite(buffer, 1, count, writer->file) != count) {
+                status = -1;
+                break;
+            }
+            position += count;
+        }
+    }
+
+    free(buffer);
+    free(writer->index);
+    writer->index = NULL;
+    close_spill_files(writer);
+    if (fclose(writer->file) != 0) status = -1;
+    writer->file = NULL;
+    return status;
+}
+
+// Map the file and check that every region it describes lies inside it
+int column_log_open(ColumnLog* log, const char* path) {
+    memset(log, 0, sizeof(*log));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ColumnLogHeader)) {
+        close(fd);
+        return -1;
+    }
+
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping stays valid
+    if (map == MAP_FAILED) return -1;
+
+    log->map = map;
+    log->size = (size_t)st.st_size;
+
+    const char* base = (const char*)map;
+    const ColumnLogHeader* header = (const ColumnLogHeader*)base;
+    const ColumnLogSchema* schema = (const ColumnLogSchema*)(base + sizeof(ColumnLogHeader));
+    int valid = memcmp(header->magic, COLUMN_LOG_MAGIC, 4) == 0 &&
+                header->version == COLUMN_LOG_VERSION &&
+                header->num_columns >= 2 &&
+                header->num_columns <= COLUMN_LOG_MAX_COLUMNS + 1 &&
+                header->index_stride > 0 &&
+                header->file_size <= log->size &&
+                sizeof(ColumnLogHeader) + header->num_columns * sizeof(ColumnLogSchema) <= log->size &&
+                header->index_offset % 8 == 0 &&
+                header->index_entries == (header->rows + header->index_stride - 1) / header->index_stride &&
+                header->index_offset + header->index_entries * sizeof(double) <= log->size;
+
+    for (uint32_t c = 0; valid && c < header->num_columns; c++) {
+        uint32_t type = (c == 0) ? COLUMN_TYPE_FLOAT64 : COLUMN_TYPE_FLOAT32;
+        uint32_t size = (c == 0) ? sizeof(double) : sizeof(float);
+        valid = schema[c].type == type &&
+                schema[c].element_size == size &&
+                schema[c].offset % 8 == 0 &&
+                schema[c].offset + header->rows * size <= log->size;
+    }
+
+    if (!valid) {
+        column_log_close(log);
+        return -1;
+    }
+
+    log->header = header;
+    log->schema = schema;
+    log->index = (const double*)(base + header->index_offset);
+    log->time = (const double*)(base + schema[0].offset);
+    log->rows = header->rows;
+    log->num_columns = (int)header->num_columns;
+    return 0;
+}
+
+void column_log_close(ColumnLog* log) {
+    if (log->map != NULL) munmap(log->map, log->size);
+    memset(log, 0, sizeof(*log));
+}
+
+int column_log_find(const ColumnLog* log, const char* name) {
+    for (int c = 0; c < log->num_columns; c++) {
+        if (strncmp(log->schema[c].name, name, COLUMN_LOG_NAME_LENGTH) == 0) return c;
+    }
+    return -1;
+}
+
+const float* column_log_values(const ColumnLog* log, int column) {
+    if (column < 1 || column >= log->num_columns) return NULL;
+    return (const float*)((const char*)log->map + log->schema[column].offset);
+}
+
+// Binary search the sparse index for the block, then the Time column inside it
+// Touches O(log(rows / stride) + log(stride)) values, never the whole column
+uint64_t column_log_lower_bound(const ColumnLog* log, double t) {
+    uint64_t stride = log->header->index_stride;
+    uint64_t lo = 0;
+    uint64_t hi = log->header->index_entries;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (log->index[mid] < t) lo = mid + 1;
+        else hi = mid;
+    }
+
+    // Index entry lo is the first block starting at or after t, so the
+    // answer lies in the block before it
+    uint64_t row_lo = (lo > 0) ? (lo - 1) * stride : 0;
+    uint64_t row_hi = lo * stride;
+    if (row_hi > log->rows) row_hi = log->rows;
+    while (row_lo < row_hi) {
+        uint64_t mid = row_lo + (row_hi - row_lo) / 2;
+        if (log->time[mid] < t) row_lo = mid + 1;
+        else row_hi = mid;
+    }
+    return row_lo;
+}
+
+void column_log_slice(const ColumnLog* log, double start, double end,
+                      uint64_t* first_row, uint64_t* count) {
+    uint64_t first = column_log_lower_bound(log, start);
+    uint64_t last = column_log_lower_bound(log, end);
+    *first_row = first;
+    *count = (last > first) ? last - first : 0;
+}
+
+// Split a CSV line in place; returns the number of fields
+static int split_fields(char* line, char** fields, int max_fields) {
+    int count = 0;
+    char* p = line;
+    while (count < max_fields) {
+        fields[count++] = p;
+        char* comma = strchr(p, ',');
+        if (comma == NULL) break;
+        *comma = '\0';
+        p = comma + 1;
+    }
+    for (int i = 0; i < count; i++) {
+        fields[i][strcspn(fields[i], "\r\n")] = '\0';
+    }
+    return count;
+}
+
+long column_log_import_csv(const char* csv_path, const char* log_path) {
+    FILE* in = fopen(csv_path, "r");
+    if (in == NULL) return -1;
+
+    char line[CSV_LINE_LENGTH];
+    char* fields[COLUMN_LOG_MAX_COLUMNS + 1];
+    if (fgets(line, sizeof(line), in) == NULL) {
+        fclose(in);
+        return -1;
+    }
+
+    // Header: first field is the time column, the rest become float columns
+    int num_fields = split_fields(line, fields, COLUMN_LOG_MAX_COLUMNS + 1);
+    if (num_fields < 2) {
+        fclose(in);
+        return -1;
+    }
+
+    ColumnLogWriter writer;
+    if (column_log_writer_open(&writer, log_path, (const char* const*)&fields[1], num_fields - 1) != 0) {
+        fclose(in);
+        return -1;
+    }
+
+    float values[COLUMN_LOG_MAX_COLUMNS];
+    long rows = 0;
+    int status = 0;
+    while (fgets(line, sizeof(line), in) != NULL) {
+        if (line[0] == '\n' || line[0] == '\r' || line[0] == '\0') continue;
+
+        char* p = line;
+        char* end;
+        double time = strtod(p, &end);
+        if (end == p) {
+            status = -1;
+            break;
+        }
+        for (int c = 0; c < num_fields - 1; c++) {
+            p = (*end == ',') ? end + 1 : end;
+            values[c] = strtof(p, &end);
+            if (end == p) {
+                status = -1;
+                break;
+            }
+        }
+        if (status != 0 || column_log_writer_append(&writer, time, values) != 0) {
+            status = -1;
+            break;
+        }
+        rows++;
+    }
+    fclose(in);
+
+    if (column_log_writer_close(&writer) != 0) status = -1;
+    return (status == 0) ? rows : -1;
+}
@@ -0,0 +1,106 @@
+#ifndef COLUMN_LOG_H
+#define COLUMN_LOG_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Columnar binary log ("HVCL")
+// Layout: header | schema | sparse time index | Time column | value columns
+// Every column is one contiguous array starting on a page boundary, so a
+// reader mmaps the file and uses the columns in place. Time is float64 (so
+// long logs keep 10 ms resolution); value columns are float32.
+//
+// The sparse index holds the time of every COLUMN_LOG_INDEX_STRIDE-th row.
+// A time-range lookup binary searches the index, then one block of the
+// Time column, and the result is a row range - slicing is a pointer offset.
+
+#define COLUMN_LOG_MAGIC        "HVCL"
+#define COLUMN_LOG_VERSION      1
+#define COLUMN_LOG_MAX_COLUMNS  32   // Value columns, not counting Time
+#define COLUMN_LOG_NAME_LENGTH  24
+#define COLUMN_LOG_INDEX_STRIDE 1024 // Rows per index entry
+#define COLUMN_LOG_ALIGN        4096 // Column alignment in the file
+
+#define COLUMN_TYPE_FLOAT32 1
+#define COLUMN_TYPE_FLOAT64 2
+
+typedef struct {
+    char magic[4];          // "HVCL"
+    uint32_t version;       // Format version
+    uint32_t num_columns;   // Columns in the schema, including Time
+    uint32_t index_stride;  // Rows per index entry
+    uint64_t rows;          // Rows in every column
+    uint64_t index_offset;  // File offset of the index (double per entry)
+    uint64_t index_entries; // ceil(rows / index_stride)
+    uint64_t file_size;     // Total size, to detect truncated files
+} ColumnLogHeader;
+
+typedef struct {
+    char name[COLUMN_LOG_NAME_LENGTH]; // NUL-terminated column name
+    uint32_t type;                     // COLUMN_TYPE_*
+    uint32_t element_size;             // Bytes per row
+    uint64_t offset;                   // File offset of the column
+} ColumnLogSchema;
+
+// Streaming writer
+// Each column is spilled to its own temporary file while rows arrive, and
+// the columns are laid out one after another on close, so memory use does
+// not grow with the log length (only the sparse index does).
+typedef struct {
+    FILE* file;                                      // Destination
+    FILE* spill[COLUMN_LOG_MAX_COLUMNS + 1];         // Per-column temp files (0 = Time)
+    char names[COLUMN_LOG_MAX_COLUMNS + 1][COLUMN_LOG_NAME_LENGTH];
+    int num_columns;                                 // Value columns
+    uint64_t rows;
+    double last_time;
+
+    double* index; // Time of every index_stride-th row
+    uint64_t index_entries;
+    uint64_t index_capacity;
+} ColumnLogWriter;
+
+// Memory-mapped reader
+typedef struct {
+    void* map;
+    size_t size;
+    const ColumnLogHeader* header;
+    const ColumnLogSchema* schema; // num_columns entries, [0] = Time
+    const double* index;
+    const double* time;            // Time column
+    uint64_t rows;
+    int num_columns;               // Including Time
+} ColumnLog;
+
+// Create a log with a Time column plus the named float columns (returns 0 on success, -1 on failure)
+int column_log_writer_open(ColumnLogWriter* writer, const char* path,
+                           const char* const* names, int num_columns);
+
+// Append one row; time must not decrease (returns 0 on success, -1 on failure)
+int column_log_writer_append(ColumnLogWriter* writer, double time, const float* values);
+
+// Lay out header, index and columns and close the file (returns 0 on success, -1 on failure)
+int column_log_writer_close(ColumnLogWriter* writer);
+
+// Map a log read-only and validate its layout (returns 0 on success, -1 on failure)
+int column_log_open(ColumnLog* log, const char* path);
+void column_log_close(ColumnLog* log);
+
+// Column number by name (0 = Time), or -1 if not present
+int column_log_find(const ColumnLog* log, const char* name);
+
+// Values of a float32 column (column >= 1), or NULL
+const float* column_log_values(const ColumnLog* log, int column);
+
+// First row with time >= t (rows if none)
+uint64_t column_log_lower_bound(const ColumnLog* log, double t);
+
+// Rows with start <= time < end, as a first row and count
+void column_log_slice(const ColumnLog* log, double start, double end,
+                      uint64_t* first_row, uint64_t* count);
+
+// Import a CSV with a header row whose first column is Time (e.g. the
+// Time,Setpoint,Position,Error,Command logs); returns rows imported, or -1 on error
+long column_log_import_csv(const char* csv_path, const char* log_path);
+
+#endif // COLUMN_LOG_H
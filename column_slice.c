@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "column_log.h"
+
+// Print a time range of a columnar log as CSV, without reading the rest of the file
+// Usage: column_slice log.hvcl start_s end_s [column ...]
+int main(int argc, char* argv[])
+{
+    if (argc < 4)
+        {
+            printf("Usage: %s log.hvcl start_s end_s [column ...]\n", argv[0]);
+            return -1;
+        }
+
+    ColumnLog log;
+    if (column_log_open(&log, argv[1]) != 0)
+        {
+            printf("Error opening %s!\n", argv[1]);
+            return -1;
+        }
+
+    // Selected columns (default: all of them)
+    int columns[COLUMN_LOG_MAX_COLUMNS];
+    int num_selected = 0;
+    if (argc > 4)
+        {
+            for (int i = 4; i < argc && num_selected < COLUMN_LOG_MAX_COLUMNS; i++)
+                {
+                    int c = column_log_find(&log, argv[i]);
+                    if (c < 1)
+                        {
+                            printf("Error: no column named %s!\n", argv[i]);
+                            column_log_close(&log);
+                            return -1;
+                        }
+                    columns[num_selected++] = c;
+                }
+        }
+    else
+        {
+            for (int c = 1; c < log.num_columns; c++) columns[num_selected++] = c;
+        }
+
+    uint64_t first, count;
+    column_log_slice(&log, atof(argv[2]), atof(argv[3]), &first, &count);
+
+    // Column pointers offset to the first row of the slice
+    const double* time = log.time + first;
+    const float* values[COLUMN_LOG_MAX_COLUMNS];
+    for (int i = 0; i < num_selected; i++) values[i] = column_log_values(&log, columns[i]) + first;
+
+    printf("%s", log.schema[0].name);
+    for (int i = 0; i < num_selected; i++) printf(",%s", log.schema[columns[i]].name);
+    printf("\n");
+    for (uint64_t r = 0; r < count; r++)
+        {
+            printf("%.2f", time[r]);
+            for (int i = 0; i < num_selected; i++) printf(",%.1f", values[i][r]);
+            printf("\n");
+        }
+
+    column_log_close(&log);
+    return 0;
+}
@@ -0,0 +1,23 @@
+#include <stdio.h>
+#include "column_log.h"
+
+// Convert Time,Setpoint,Position,Error,Command CSVs to columnar logs (.hvcl)
+// Usage: csv_to_column_log input.csv output.hvcl
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+        {
+            printf("Usage: %s input.csv output.hvcl\n", argv[0]);
+            return -1;
+        }
+
+    long rows = column_log_import_csv(argv[1], argv[2]);
+    if (rows < 0)
+        {
+            printf("Error importing %s!\n", argv[1]);
+            return -1;
+        }
+
+    printf("Imported %ld rows to %s\n", rows, argv[2]);
+    return 0;
+}
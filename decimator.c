@@ -0,0 +1,180 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "decimator.h"
+
+static void bucket_reset(DecimatorBucket* bucket, int num_signals, long index) {
+    bucket->stats.index = index;
+    bucket->stats.count = 0;
+    bucket->time_sum = 0.0;
+    for (int s = 0; s < num_signals; s++) bucket->sum[s] = 0.0;
+}
+
+int decimator_init(Decimator* decimator, int num_signals, int window, int lttb) {
+    if (num_signals <= 0 || num_signals > DECIMATOR_MAX_SIGNALS || window <= 0) return -1;
+
+    memset(decimator, 0, sizeof(*decimator));
+    decimator->num_signals = num_signals;
+    decimator->window = window;
+    decimator->lttb = lttb;
+
+    if (lttb) {
+        // Both buckets' sample buffers in one block
+        size_t per_bucket = (size_t)window * (1 + num_signals);
+        float* storage = malloc(sizeof(float) * per_bucket * 2);
+        if (storage == NULL) return -1;
+        decimator->storage = storage;
+        for (int b = 0; b < 2; b++) {
+            decimator->buckets[b].times = storage + b * per_bucket;
+            decimator->buckets[b].values = storage + b * per_bucket + window;
+        }
+    }
+
+    bucket_reset(&decimator->buckets[0], num_signals, 0);
+    decimator->next_index = 1;
+    return 0;
+}
+
+void decimator_free(Decimator* decimator) {
+    free(decimator->storage);
+    decimator->storage = NULL;
+}
+
+int decimator_add_sink(Decimator* decimator, DecimatorSink sink, void* context) {
+    if (decimator->num_sinks >= DECIMATOR_MAX_SINKS) return -1;
+    decimator->sinks[decimator->num_sinks] = sink;
+    decimator->contexts[decimator->num_sinks] = context;
+    decimator->num_sinks++;
+    return 0;
+}
+
+static void emit(Decimator* decimator, const DecimatorWindow* window) {
+    for (int k = 0; k < decimator->num_sinks; k++) {
+        decimator->sinks[k](window, decimator->contexts[k]);
+    }
+}
+
+// Means are only needed once the window is complete
+static void bucket_finish(DecimatorBucket* bucket, int num_signals) {
+    for (int s = 0; s < num_signals; s++) {
+        bucket->stats.mean[s] = (float)(bucket->sum[s] / bucket->stats.count);
+    }
+}
+
+// LTTB selection for one bucket: per signal, the sample with the largest
+// triangle between the anchor (previous choice) and the point next_time/next_value
+static void bucket_select(Decimator* decimator, DecimatorBucket* bucket,
+                          float next_time, const float* next_value) {
+    int n = decimator->num_signals;
+    for (int s = 0; s < n; s++) {
+        float at = decimator->have_anchor ? decimator->anchor_time[s] : bucket->times[0];
+        float av = decimator->have_anchor ? decimator->anchor_value[s] : bucket->values[s];
+        float best_area = -1.0f;
+        int best = 0;
+        for (int i = 0; i < bucket->stats.count; i++) {
+            float bt = bucket->times[i];
+            float bv = bucket->values[(size_t)i * n + s];
+            float area = fabsf((at - next_time) * (bv - av) - (at - bt) * (next_value[s] - av));
+            if (area > best_area) {
+                best_area = area;
+                best = i;
+            }
+        }
+        bucket->stats.point_time[s] = bucket->times[best];
+        bucket->stats.point_value[s] = bucket->values[(size_t)best * n + s];
+        decimator->anchor_time[s] = bucket->stats.point_time[s];
+        decimator->anchor_value[s] = bucket->stats.point_value[s];
+    }
+    decimator->have_anchor = 1;
+}
+
+// The filling bucket is complete: emit it (stats) or its predecessor (LTTB)
+static void complete_bucket(Decimator* decimator) {
+    int n = decimator->num_signals;
+    DecimatorBucket* bucket = &decimator->buckets[decimator->current];
+    bucket_finish(bucket, n);
+
+    if (!decimator->lttb) {
+        emit(decimator, &bucket->stats);
+        bucket_reset(bucket, n, decimator->next_index++);
+        return;
+    }
+
+    if (decimator->pending) {
+        DecimatorBucket* previous = &decimator->buckets[decimator->current ^ 1];
+        float mean_time = (float)(bucket->time_sum / bucket->stats.count);
+        bucket_select(decimator, previous, mean_time, bucket->stats.mean);
+        emit(decimator, &previous->stats);
+    }
+    decimator->pending = 1;
+    decimator->current ^= 1;
+    bucket_reset(&decimator->buckets[decimator->current], n, decimator->next_index++);
+}
+
+void decimator_push(Decimator* decimator, float time, const float* values) {
+    int n = decimator->num_signals;
+    DecimatorBucket* bucket = &decimator->buckets[decimator->current];
+    DecimatorWindow* stats = &bucket->stats;
+    int i = stats->count;
+
+    if (i == 0) {
+        stats->start_time = time;
+        for (int s = 0; s < n; s++) {
+            stats->min[s] = values[s];
+            stats->max[s] = values[s];
+        }
+    }
+    stats->end_time = time;
+    bucket->time_sum += time;
+    for (int s = 0; s < n; s++) {
+        float v = values[s];
+        if (v < stats->min[s]) stats->min[s] = v;
+        if (v > stats->max[s]) stats->max[s] = v;
+        bucket->sum[s] += v;
+        stats->last[s] = v;
+    }
+    if (decimator->lttb) {
+        bucket->times[i] = time;
+        memcpy(&bucket->values[(size_t)i * n], values, sizeof(float) * n);
+    }
+
+    stats->count = i + 1;
+    if (stats->count == decimator->window) complete_bucket(decimator);
+}
+
+void decimator_flush(Decimator* decimator) {
+    DecimatorBucket* bucket = &decimator->buckets[decimator->current];
+
+    if (bucket->stats.count > 0) complete_bucket(decimator);
+
+    // The last LTTB window has no successor: aim at its own last sample
+    if (decimator->lttb && decimator->pending) {
+        DecimatorBucket* last = &decimator->buckets[decimator->current ^ 1];
+        bucket_select(decimator, last, last->stats.end_time, last->stats.last);
+        emit(decimator, &last->stats);
+        decimator->pending = 0;
+    }
+}
+
+void decimator_csv_sink(const DecimatorWindow* window, void* context) {
+    DecimatorCsvSink* sink = (DecimatorCsvSink*)context;
+    FILE* f = sink->file;
+
+    if (!sink->header_written) {
+        fprintf(f, "Window,StartTime,EndTime,Count");
+        for (int s = 0; s < sink->num_signals; s++) {
+            const char* name = sink->names[s];
+            fprintf(f, ",%sMin,%sMax,%sMean,%sLast", name, name, name, name);
+            if (sink->lttb) fprintf(f, ",%sPointTime,%sPoint", name, name);
+        }
+        fprintf(f, "\n");
+        sink->header_written = 1;
+    }
+
+    fprintf(f, "%ld,%.4f,%.4f,%d", window->index, window->start_time, window->end_time, window->count);
+    for (int s = 0; s < sink->num_signals; s++) {
+        fprintf(f, ",%.3f,%.3f,%.3f,%.3f", window->min[s], window->max[s], window->mean[s], window->last[s]);
+        if (sink->lttb) fprintf(f, ",%.4f,%.3f", window->point_time[s], window->point_value[s]);
+    }
+    fprintf(f, "\n");
+}
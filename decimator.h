@@ -0,0 +1,99 @@
+#ifndef DECIMATOR_H
+#define DECIMATOR_H
+
+#include <stdio.h>
+
+// Windowed downsampling for live monitoring
+// Samples of up to DECIMATOR_MAX_SIGNALS signals are pushed one tick at a
+// time; every `window` samples the decimator hands each sink one window
+// holding min, max, mean and last per signal, so a spike or a saturated
+// command inside the window is still visible at the reduced rate.
+//
+// In LTTB mode each window also carries one shape-preserving point per
+// signal (largest-triangle-three-buckets): the sample that forms the
+// largest triangle with the previously chosen point and the mean of the
+// next window. That needs the next window, so LTTB windows are emitted one
+// window late.
+//
+// Everything is allocated in decimator_init(); pushing is O(signals) per
+// sample plus one pass over the buffered window in LTTB mode.
+
+#define DECIMATOR_MAX_SIGNALS 8
+#define DECIMATOR_MAX_SINKS   4
+
+typedef struct {
+    long index;        // Window number (0, 1, ...)
+    int count;         // Samples in the window (< window only for the last one)
+    float start_time;
+    float end_time;
+    float min[DECIMATOR_MAX_SIGNALS];
+    float max[DECIMATOR_MAX_SIGNALS];
+    float mean[DECIMATOR_MAX_SIGNALS];
+    float last[DECIMATOR_MAX_SIGNALS];
+
+    // LTTB mode only: the selected sample of each signal
+    float point_time[DECIMATOR_MAX_SIGNALS];
+    float point_value[DECIMATOR_MAX_SIGNALS];
+} DecimatorWindow;
+
+// Called once per completed window
+typedef void (*DecimatorSink)(const DecimatorWindow* window, void* context);
+
+// One window being filled; LTTB mode keeps its samples as well
+typedef struct {
+    DecimatorWindow stats;
+    double sum[DECIMATOR_MAX_SIGNALS];
+    double time_sum;
+    float* times;   // [window] (LTTB mode)
+    float* values;  // [window * num_signals], sample-major (LTTB mode)
+} DecimatorBucket;
+
+typedef struct {
+    int num_signals;
+    int window;  // Samples per window
+    int lttb;    // 1 = also select shape-preserving points
+
+    DecimatorBucket buckets[2]; // Filling and (LTTB mode) waiting for its successor
+    int current;                // Bucket being filled
+    int pending;                // LTTB: previous bucket not yet emitted
+    long next_index;
+
+    // LTTB anchor: the point chosen in the last emitted window
+    int have_anchor;
+    float anchor_time[DECIMATOR_MAX_SIGNALS];
+    float anchor_value[DECIMATOR_MAX_SIGNALS];
+
+    DecimatorSink sinks[DECIMATOR_MAX_SINKS];
+    void* contexts[DECIMATOR_MAX_SINKS];
+    int num_sinks;
+
+    void* storage; // LTTB sample buffers (NULL in stats mode)
+} Decimator;
+
+// Returns 0 on success, -1 on bad arguments or allocation failure
+int decimator_init(Decimator* decimator, int num_signals, int window, int lttb);
+void decimator_free(Decimator* decimator);
+
+// Register a sink (returns 0 on success, -1 when all slots are taken)
+int decimator_add_sink(Decimator* decimator, DecimatorSink sink, void* context);
+
+// Add one sample per signal; completed windows go to the sinks
+void decimator_push(Decimator* decimator, float time, const float* values);
+
+// Emit whatever is still buffered (partial last window, pending LTTB window)
+void decimator_flush(Decimator* decimator);
+
+// Ready-made sink writing one CSV row per window
+// Columns: Window,StartTime,EndTime,Count, then <name>Min,<name>Max,<name>Mean,<name>Last
+// per signal (and <name>PointTime,<name>Point in LTTB mode)
+typedef struct {
+    FILE* file;
+    const char* const* names; // num_signals signal names
+    int num_signals;
+    int lttb;
+    int header_written;
+} DecimatorCsvSink;
+
+void decimator_csv_sink(const DecimatorWindow* window, void* context);
+
+#endif // DECIMATOR_H
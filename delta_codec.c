@@ -0,0 +1,346 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "delta_codec.h"
+
+#define DELTA_MAX_TOKEN_BYTES 10 // 64-bit varint
+#define DELTA_BYTES_PER_ROW   (2 * DELTA_MAX_TOKEN_BYTES) // Run flush + literal
+
+static uint64_t zigzag_encode(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static int64_t zigzag_decode(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+// LEB128: 7 bits per byte, high bit set on all but the last byte
+static uint8_t* put_varint(uint8_t* p, uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static const uint8_t* get_varint(const uint8_t* p, const uint8_t* end, uint64_t* v) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *v = result;
+            return p;
+        }
+    }
+    return NULL; // Truncated or overlong
+}
+
+static int64_t quantize(double value, double resolution) {
+    return (int64_t)llround(value / resolution);
+}
+
+static size_t block_payload_capacity(int num_signals, uint32_t block_rows) {
+    return (size_t)num_signals * (sizeof(int64_t) + sizeof(uint32_t) +
+                                  (size_t)block_rows * DELTA_BYTES_PER_ROW);
+}
+
+// ---------------------------------------------------------------------------
+// Encoder
+// ---------------------------------------------------------------------------
+
+static void encoder_flush_run(DeltaEncoder* encoder, int s) {
+    if (encoder->run[s] == 0) return;
+    uint8_t* p = encoder->column[s] + encoder->column_bytes[s];
+    p = put_varint(p, (encoder->run[s] << 1) | 1);
+    encoder->column_bytes[s] = (uint32_t)(p - encoder->column[s]);
+    encoder->run[s] = 0;
+}
+
+// Write the current block as one frame
+static int encoder_write_block(DeltaEncoder* encoder) {
+    if (encoder->rows_in_block == 0) return 0;
+
+    int n = encoder->num_signals;
+    uint32_t payload = (uint32_t)(n * (sizeof(int64_t) + sizeof(uint32_t)));
+    for (int s = 0; s < n; s++) {
+        encoder_flush_run(encoder, s);
+        payload += encoder->column_bytes[s];
+    }
+
+    DeltaBlockHeader header;
+    memcpy(header.sync, DELTA_BLOCK_SYNC, 4);
+    header.rows = encoder->rows_in_block;
+    header.payload_bytes = payload;
+    header.reserved = 0;
+
+    if (fwrite(&header, sizeof(header), 1, encoder->file) != 1 ||
+        fwrite(encoder->first, sizeof(int64_t), n, encoder->file) != (size_t)n ||
+        fwrite(encoder->column_bytes, sizeof(uint32_t), n, encoder->file) != (size_t)n) {
+        return -1;
+    }
+    for (int s = 0; s < n; s++) {
+        if (fwrite(encoder->column[s], 1, encoder->column_bytes[s], encoder->file) != encoder->column_bytes[s]) {
+            return -1;
+        }
+        encoder->column_bytes[s] = 0;
+    }
+
+    encoder->bytes_written += sizeof(header) + payload;
+    encoder->rows_in_block = 0;
+    return 0;
+}
+
+int delta_encoder_open(DeltaEncoder* encoder, const char* path,
+                       const DeltaSignal* signals, int num_signals, uint32_t block_rows) {
+    if (num_signals < 1 || num_signals > DELTA_MAX_SIGNALS) return -1;
+    if (block_rows == 0) block_rows = DELTA_DEFAULT_BLOCK;
+
+    memset(encoder, 0, sizeof(*encoder));
+    encoder->num_signals = num_signals;
+    encoder->block_rows = block_rows;
+    for (int s = 0; s < num_signals; s++) {
+        encoder->signals[s] = signals[s];
+        encoder->signals[s].name[DELTA_NAME_LENGTH - 1] = '\0';
+        if (!(encoder->signals[s].resolution > 0.0)) return -1;
+    }
+
+    size_t column_capacity = (size_t)block_rows * DELTA_BYTES_PER_ROW;
+    encoder->storage = malloc(column_capacity * num_signals);
+    if (encoder->storage == NULL) return -1;
+    for (int s = 0; s < num_signals; s++) {
+        encoder->column[s] = (uint8_t*)encoder->storage + column_capacity * s;
+    }
+
+    encoder->file = fopen(path, "wb");
+    if (encoder->file == NULL) {
+        free(encoder->storage);
+        encoder->storage = NULL;
+        return -1;
+    }
+
+    DeltaFileHeader header;
+    memcpy(header.magic, DELTA_MAGIC, 4);
+    header.version = DELTA_VERSION;
+    header.num_signals = (uint32_t)num_signals;
+    header.block_rows = block_rows;
+    if (fwrite(&header, sizeof(header), 1, encoder->file) != 1 ||
+        fwrite(encoder->signals, sizeof(DeltaSignal), num_signals, encoder->file) != (size_t)num_signals) {
+        fclose(encoder->file);
+        free(encoder->storage);
+        encoder->storage = NULL;
+        return -1;
+    }
+    encoder->bytes_written = sizeof(header) + sizeof(DeltaSignal) * num_signals;
+    return 0;
+}
+
+int delta_encoder_append(DeltaEncoder* encoder, const double* values) {
+    int n = encoder->num_signals;
+
+    if (encoder->rows_in_block == 0) {
+        // First row of a block is stored absolute in the block header
+        for (int s = 0; s < n; s++) {
+            int64_t code = quantize(values[s], encoder->signals[s].resolution);
+            encoder->first[s] = code;
+            encoder->previous[s] = code;
+            encoder->last_delta[s] = 0;
+            encoder->run[s] = 0;
+        }
+    } else {
+        for (int s = 0; s < n; s++) {
+            int64_t code = quantize(values[s], encoder->signals[s].resolution);
+            int64_t delta = code - encoder->previous[s];
+            encoder->previous[s] = code;
+
+            if (delta == encoder->last_delta[s]) {
+                encoder->run[s]++;
+                continue;
+            }
+            encoder_flush_run(encoder, s);
+            uint8_t* p = encoder->column[s] + encoder->column_bytes[s];
+            p = put_varint(p, zigzag_encode(delta) << 1);
+            encoder->column_bytes[s] = (uint32_t)(p - encoder->column[s]);
+            encoder->last_delta[s] = delta;
+        }
+    }
+
+    encoder->rows++;
+    if (++encoder->rows_in_block == encoder->block_rows) {
+        return encoder_write_block(encoder);
+    }
+    return 0;
+}
+
+int delta_encoder_close(DeltaEncoder* encoder) {
+    int status = encoder_write_block(encoder);
+    if (fclose(encoder->file) != 0) status = -1;
+    free(encoder->storage);
+    encoder->storage = NULL;
+    encoder->file = NULL;
+    return status;
+}
+
+// ---------------------------------------------------------------------------
+// Decoder
+// ---------------------------------------------------------------------------
+
+// Read and validate one block header; returns 1 if read, 0 at end of stream, -1 on error
+static int decoder_read_header(DeltaDecoder* decoder, DeltaBlockHeader* header) {
+    size_t got = fread(header, 1, sizeof(*header), decoder->file);
+    if (got == 0) return 0;
+    if (got != sizeof(*header) ||
+        memcmp(header->sync, DELTA_BLOCK_SYNC, 4) != 0 ||
+        header->rows == 0 || header->rows > decoder->block_rows ||
+        header->payload_bytes > block_payload_capacity(decoder->num_signals, decoder->block_rows)) {
+        return -1;
+    }
+    return 1;
+}
+
+// Read the payload following header and expand it into decoder->codes
+static int decoder_load_block(DeltaDecoder* decoder, const DeltaBlockHeader* header) {
+    int n = decoder->num_signals;
+    size_t fixed = (size_t)n * (sizeof(int64_t) + sizeof(uint32_t));
+    if (header->payload_bytes < fixed ||
+        fread(decoder->payload, 1, header->payload_bytes, decoder->file) != header->payload_bytes) {
+        return -1;
+    }
+
+    const int64_t* first = (const int64_t*)decoder->payload;
+    const uint32_t* column_bytes = (const uint32_t*)(decoder->payload + n * sizeof(int64_t));
+    const uint8_t* p = decoder->payload + fixed;
+    const uint8_t* payload_end = decoder->payload + header->payload_bytes;
+
+    for (int s = 0; s < n; s++) {
+        const uint8_t* end = p + column_bytes[s];
+        if (end > payload_end) return -1;
+
+        int64_t code = first[s];
+        int64_t delta = 0;
+        decoder->codes[s] = code;
+
+        uint32_t row = 1;
+        while (row < header->rows) {
+            uint64_t token;
+            if ((p = get_varint(p, end, &token)) == NULL) return -1;
+
+            uint64_t repeat = 1;
+            if (token & 1) {
+                repeat = token >> 1;
+            } else {
+                delta = zigzag_decode(token >> 1);
+            }
+            if (repeat == 0 || repeat > header->rows - row) return -1;
+
+            for (uint64_t k = 0; k < repeat; k++) {
+                code += delta;
+                decoder->codes[(size_t)row * n + s] = code;
+                row++;
+            }
+        }
+        if (p != end) return -1;
+    }
+
+    decoder->rows_in_block = header->rows;
+    decoder->next_row = 0;
+    return 0;
+}
+
+int delta_decoder_open(DeltaDecoder* decoder, const char* path) {
+    memset(decoder, 0, sizeof(*decoder));
+
+    decoder->file = fopen(path, "rb");
+    if (decoder->file == NULL) return -1;
+
+    DeltaFileHeader header;
+    if (fread(&header, sizeof(header), 1, decoder->file) != 1 ||
+        memcmp(header.magic, DELTA_MAGIC, 4) != 0 ||
+        header.version != DELTA_VERSION ||
+        header.num_signals < 1 || header.num_signals > DELTA_MAX_SIGNALS ||
+        header.block_rows == 0 ||
+        fread(decoder->signals, sizeof(DeltaSignal), header.num_signals, decoder->file) != header.num_signals) {
+        fclose(decoder->file);
+        decoder->file = NULL;
+        return -1;
+    }
+
+    decoder->num_signals = (int)header.num_signals;
+    decoder->block_rows = header.block_rows;
+    decoder->first_block_offset = ftell(decoder->file);
+
+    decoder->codes = malloc(sizeof(int64_t) * header.block_rows * header.num_signals);
+    decoder->payload = malloc(block_payload_capacity(decoder->num_signals, decoder->block_rows));
+    if (decoder->codes == NULL || decoder->payload == NULL) {
+        delta_decoder_close(decoder);
+        return -1;
+    }
+    return 0;
+}
+
+int delta_decoder_next(DeltaDecoder* decoder, double* values) {
+    if (decoder->next_row >= decoder->rows_in_block) {
+        DeltaBlockHeader header;
+        int status = decoder_read_header(decoder, &header);
+        if (status <= 0) return status;
+        if (decoder_load_block(decoder, &header) != 0) return -1;
+    }
+
+    const int64_t* row = decoder->codes + (size_t)decoder->next_row * decoder->num_signals;
+    for (int s = 0; s < decoder->num_signals; s++) {
+        values[s] = (double)row[s] * decoder->signals[s].resolution;
+    }
+    decoder->next_row++;
+    return 1;
+}
+
+// Hop from block header to block header comparing only the first time value,
+// then decode the one block that contains t
+int delta_decoder_seek(DeltaDecoder* decoder, double t) {
+    long offset = decoder->first_block_offset;
+    long target = offset;
+    double resolution = decoder->signals[0].resolution;
+
+    if (fseek(decoder->file, offset, SEEK_SET) != 0) return -1;
+    for (;;) {
+        DeltaBlockHeader header;
+        int64_t first_time;
+        int status = decoder_read_header(decoder, &header);
+        if (status < 0) return -1;
+        if (status == 0) break;
+        if (fread(&first_time, sizeof(first_time), 1, decoder->file) != 1) return -1;
+
+        // Last block that starts strictly before t holds the first row >= t
+        // (or ends just before it, in which case the next block does)
+        if ((double)first_time * resolution >= t) break;
+        target = offset;
+
+        offset += (long)(sizeof(header) + header.payload_bytes);
+        if (fseek(decoder->file, offset, SEEK_SET) != 0) return -1;
+    }
+
+    if (fseek(decoder->file, target, SEEK_SET) != 0) return -1;
+    decoder->rows_in_block = 0;
+    decoder->next_row = 0;
+
+    DeltaBlockHeader header;
+    int status = decoder_read_header(decoder, &header);
+    if (status <= 0) return status; // Empty stream
+    if (decoder_load_block(decoder, &header) != 0) return -1;
+
+    while (decoder->next_row < decoder->rows_in_block &&
+           (double)decoder->codes[(size_t)decoder->next_row * decoder->num_signals] * resolution < t) {
+        decoder->next_row++;
+    }
+    return 0;
+}
+
+void delta_decoder_close(DeltaDecoder* decoder) {
+    if (decoder->file != NULL) fclose(decoder->file);
+    free(decoder->codes);
+    free(decoder->payload);
+    decoder->file = NULL;
+    decoder->codes = NULL;
+    decoder->payload = NULL;
+}
@@ -0,0 +1,106 @@
+#ifndef DELTA_CODEC_H
+#define DELTA_CODEC_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Compressed telemetry stream ("HVDC")
+// Every signal is quantized to a fixed resolution (e.g. 0.1 % for positions,
+// 0.01 s for time) and stored column-wise per block as the difference from
+// the previous sample:
+//   token = varint((zigzag(delta) << 1) | 0)   literal delta
+//   token = varint((count << 1) | 1)           delta repeated count more times
+// so a constant setpoint, a saturated command or a steadily advancing clock
+// all collapse to a few bytes per block.
+//
+// The stream is a file header followed by self-contained blocks. Each block
+// starts with a sync marker, its row count, its byte size and the absolute
+// first value of every signal, so a reader can start at any block and skip
+// blocks without decoding them.
+
+#define DELTA_MAGIC          "HVDC"
+#define DELTA_BLOCK_SYNC     "HVDB"
+#define DELTA_VERSION        1
+#define DELTA_MAX_SIGNALS    16
+#define DELTA_NAME_LENGTH    24
+#define DELTA_DEFAULT_BLOCK  1024 // Rows per block (10 s at 100 Hz)
+
+typedef struct {
+    char name[DELTA_NAME_LENGTH]; // NUL-terminated signal name
+    double resolution;            // Quantization step (value = code * resolution)
+} DeltaSignal;
+
+typedef struct {
+    char magic[4];        // "HVDC"
+    uint32_t version;     // Format version
+    uint32_t num_signals; // Signals per row; signal 0 must be non-decreasing time
+    uint32_t block_rows;  // Maximum rows per block
+} DeltaFileHeader;
+
+typedef struct {
+    char sync[4];           // "HVDB"
+    uint32_t rows;          // Rows in this block
+    uint32_t payload_bytes; // Bytes after this header (first values, column sizes, columns)
+    uint32_t reserved;
+} DeltaBlockHeader;
+
+// Streaming encoder - all buffers allocated at open, nothing per row
+typedef struct {
+    FILE* file;
+    DeltaSignal signals[DELTA_MAX_SIGNALS];
+    int num_signals;
+    uint32_t block_rows;
+
+    // Current block
+    uint32_t rows_in_block;
+    int64_t first[DELTA_MAX_SIGNALS];      // Absolute codes of the first row
+    int64_t previous[DELTA_MAX_SIGNALS];   // Last code written
+    int64_t last_delta[DELTA_MAX_SIGNALS]; // Last literal delta (for runs)
+    uint64_t run[DELTA_MAX_SIGNALS];       // Pending repeats of last_delta
+    uint8_t* column[DELTA_MAX_SIGNALS];    // Encoded bytes per signal
+    uint32_t column_bytes[DELTA_MAX_SIGNALS];
+    void* storage;                         // Single allocation backing the columns
+
+    // Statistics
+    uint64_t rows;
+    uint64_t bytes_written;
+} DeltaEncoder;
+
+// Streaming decoder - decodes one block at a time
+typedef struct {
+    FILE* file;
+    DeltaSignal signals[DELTA_MAX_SIGNALS];
+    int num_signals;
+    uint32_t block_rows;
+    long first_block_offset;
+
+    int64_t* codes;     // block_rows x num_signals, row-major
+    uint8_t* payload;   // Raw block payload
+    uint32_t rows_in_block;
+    uint32_t next_row;
+} DeltaDecoder;
+
+// Create a stream (returns 0 on success, -1 on failure); block_rows 0 = default
+int delta_encoder_open(DeltaEncoder* encoder, const char* path,
+                       const DeltaSignal* signals, int num_signals, uint32_t block_rows);
+
+// Append one row of num_signals values (returns 0 on success, -1 on failure)
+int delta_encoder_append(DeltaEncoder* encoder, const double* values);
+
+// Flush the last partial block and close (returns 0 on success, -1 on failure)
+int delta_encoder_close(DeltaEncoder* encoder);
+
+// Open a stream and read its signal list (returns 0 on success, -1 on failure)
+int delta_decoder_open(DeltaDecoder* decoder, const char* path);
+
+// Next row into values (returns 1 if a row was read, 0 at end of stream, -1 on error)
+int delta_decoder_next(DeltaDecoder* decoder, double* values);
+
+// Position so the next row is the first with time (signal 0) >= t
+// Skips whole blocks by their headers without decoding them
+// Returns 0 on success, -1 on error
+int delta_decoder_seek(DeltaDecoder* decoder, double t);
+
+void delta_decoder_close(DeltaDecoder* decoder);
+
+#endif // DELTA_CODEC_H
@@ -0,0 +1,58 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stdint.h>
+
+// Q16.16 signed fixed point: 16 integer bits, 16 fraction bits
+// Range +/-32768 with a resolution of 1/65536 (~0.000015%), which covers
+// positions, commands and PID terms in percent with plenty of headroom.
+// (Used instead of Q15/Q31: positions and commands run to 100%, which a
+// pure fraction format cannot hold without rescaling every signal.)
+typedef int32_t q16_t;
+
+#define Q16_SHIFT 16
+#define Q16_ONE   ((q16_t)1 << Q16_SHIFT)
+#define Q16_MAX   INT32_MAX
+#define Q16_MIN   INT32_MIN
+
+// Setup-time conversion (uses float, never called per step)
+// Out-of-range values saturate (the plain cast would be undefined), NaN gives 0
+static inline q16_t q16_from_float(float x) {
+    float scaled = x * 65536.0f;
+    if (scaled >= 2147483648.0f) return Q16_MAX;
+    if (scaled <= -2147483648.0f) return Q16_MIN;
+    if (scaled != scaled) return 0;
+    return (q16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+}
+
+#define Q16_FROM_FLOAT(x) q16_from_float(x)
+#define Q16_TO_FLOAT(x)   ((float)(x) / 65536.0f)
+
+// Saturate a 64-bit intermediate to the q16 range
+static inline q16_t q16_sat(int64_t x) {
+    if (x > Q16_MAX) return Q16_MAX;
+    if (x < Q16_MIN) return Q16_MIN;
+    return (q16_t)x;
+}
+
+static inline q16_t q16_add(q16_t a, q16_t b) {
+    return q16_sat((int64_t)a + b);
+}
+
+static inline q16_t q16_sub(q16_t a, q16_t b) {
+    return q16_sat((int64_t)a - b);
+}
+
+// Multiply with round-to-nearest and saturation
+static inline q16_t q16_mul(q16_t a, q16_t b) {
+    int64_t p = (int64_t)a * b;
+    return q16_sat((p + ((int64_t)1 << (Q16_SHIFT - 1))) >> Q16_SHIFT);
+}
+
+static inline q16_t q16_clamp(q16_t x, q16_t lo, q16_t hi) {
+    if (x > hi) return hi;
+    if (x < lo) return lo;
+    return x;
+}
+
+#endif // FIXED_POINT_H
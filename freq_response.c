@@ -0,0 +1,309 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#include "pid_bank.h"
+#include "freq_response.h"
+#include "bit_select.h"
+
+#define FREQ_COLUMNS 12
+#define FREQ_MIN_SAMPLES_PER_PERIOD 4
+#define PI_D 3.14159265358979323846
+
+void freq_options_default(FreqOptions* options) {
+    options->injection = FREQ_INJECT_SETPOINT;
+    options->amplitude = 2.0f;
+    options->bias = 50.0f;
+    options->f_min = 0.02f;
+    options->f_max = 20.0f;
+    options->points = 40;
+    options->cycles = 4;
+    options->settle_cycles = 2;
+    options->settle_time = 3.0f;
+    options->sample_time = 0.01f;
+}
+
+// Per-channel sweep state, one column per field
+typedef struct {
+    double* cos;      // DFT phasor = excitation phase
+    double* sin;
+    double* rot_cos;  // Phasor rotation per sample
+    double* rot_sin;
+    double* x_re;     // Running single-bin sums: excitation,
+    double* x_im;
+    double* m_re;     // position seen by the controller,
+    double* m_im;
+    double* e_re;     // error,
+    double* e_im;
+    double* u_re;     // and clamped command
+    double* u_im;
+    long* start;      // DFT window [start, end) in samples
+    long* end;
+    void* storage;
+} FreqSweep;
+
+static int freq_sweep_init(FreqSweep* sweep, int count) {
+    size_t doubles = sizeof(double) * (size_t)count * FREQ_COLUMNS;
+    char* storage = calloc(1, doubles + sizeof(long) * 2 * (size_t)count);
+    if (storage == NULL) return -1;
+    double** columns[FREQ_COLUMNS] = {
+        &sweep->cos, &sweep->sin, &sweep->rot_cos, &sweep->rot_sin,
+        &sweep->x_re, &sweep->x_im, &sweep->m_re, &sweep->m_im,
+        &sweep->e_re, &sweep->e_im, &sweep->u_re, &sweep->u_im
+    };
+    for (int c = 0; c < FREQ_COLUMNS; c++) {
+        *columns[c] = (double*)storage + (size_t)c * count;
+    }
+    sweep->start = (long*)(storage + doubles);
+    sweep->end = sweep->start + count;
+    sweep->storage = storage;
+    return 0;
+}
+
+// Sine on the setpoint: the ramp target always, the setpoint itself when not ramping
+static void freq_excite_setpoint(int n, float amplitude, float bias,
+                                 const double* restrict sine,
+                                 float* restrict setpoint,
+                                 float* restrict setpoint_target,
+                                 const float* restrict ramp_step) {
+    for (int k = 0; k < n; k++) {
+        float r = bias + amplitude * (float)sine[k];
+        setpoint_target[k] = r;
+        setpoint[k] = bit_select(ramp_step[k] > 0.0f, setpoint[k], r);
+    }
+}
+
+static void freq_excite_disturbance(int n, float amplitude,
+                                    const double* restrict sine,
+                                    float* restrict disturbance) {
+    for (int k = 0; k < n; k++) disturbance[k] = amplitude * (float)sine[k];
+}
+
+// Same clamp as the live loop (0-100% command)
+static void freq_clamp(int n, float* restrict commands) {
+    for (int k = 0; k < n; k++) {
+        float u = commands[k];
+        u = bit_select(u < 0.0f, 0.0f, u);
+        commands[k] = bit_select(u > 100.0f, 100.0f, u);
+    }
+}
+
+// Add this sample to the single-bin sums of channels [lo, hi)
+// Column kernel: every array is a restrict parameter so the loop vectorizes
+static void freq_accumulate_kernel(int lo, int hi, double amplitude,
+                                   const double* restrict cs,
+                                   const double* restrict sn,
+                                   double* restrict x_re,
+                                   double* restrict x_im,
+                                   double* restrict m_re,
+                                   double* restrict m_im,
+                                   double* restrict e_re,
+                                   double* restrict e_im,
+                                   double* restrict u_re,
+                                   double* restrict u_im,
+                                   const float* restrict position,
+                                   const float* restrict setpoint,
+                                   const float* restrict command) {
+    for (int k = lo; k < hi; k++) {
+        double c = cs[k];
+        double si = sn[k];
+        double x = amplitude * si;
+        double m = position[k];
+        double e = setpoint[k] - position[k];
+        double u = command[k];
+        x_re[k] += x * c;
+        x_im[k] -= x * si;
+        m_re[k] += m * c;
+        m_im[k] -= m * si;
+        e_re[k] += e * c;
+        e_im[k] -= e * si;
+        u_re[k] += u * c;
+        u_im[k] -= u * si;
+    }
+}
+
+// Advance every phasor by one sample
+static void freq_rotate_kernel(int n,
+                               double* restrict cs,
+                               double* restrict sn,
+                               const double* restrict rc,
+                               const double* restrict rs) {
+    for (int k = 0; k < n; k++) {
+        double next_cos = cs[k] * rc[k] - sn[k] * rs[k];
+        double next_sin = sn[k] * rc[k] + cs[k] * rs[k];
+        cs[k] = next_cos;
+        sn[k] = next_sin;
+    }
+}
+
+static float decibels(double complex z) {
+    return (float)(20.0 * log10(cabs(z)));
+}
+
+static float degrees(double complex z) {
+    return (float)(carg(z) * 180.0 / PI_D);
+}
+
+// Shift phase by whole turns to within 180 degrees of previous
+static float unwrap(float phase, float previous) {
+    while (phase - previous > 180.0f) phase -= 360.0f;
+    while (phase - previous < -180.0f) phase += 360.0f;
+    return phase;
+}
+
+int freq_response_run(const PIDController* pid, const PlantParams* plant,
+                      const FreqOptions* options, FreqPoint* points) {
+    int n = options->points;
+    double dt = options->sample_time;
+    if (n < 1 || options->cycles < 1 || options->settle_cycles < 0 || !(dt > 0.0)) return -1;
+    if (!(options->f_min > 0.0f) || options->f_max < options->f_min || !(options->amplitude > 0.0f)) return -1;
+    if (options->f_max * dt * FREQ_MIN_SAMPLES_PER_PERIOD > 1.0) return -1;
+    if (options->injection != FREQ_INJECT_SETPOINT && options->injection != FREQ_INJECT_DISTURBANCE) return -1;
+
+    PIDBank bank;
+    PlantBank plants;
+    FreqSweep sweep;
+    float* commands = malloc(sizeof(float) * (size_t)n);
+    int status = commands ? 0 : -1;
+    int have_bank = status == 0 && pid_bank_init(&bank, n) == 0;
+    int have_plants = have_bank && plant_bank_init(&plants, n, (float)dt) == 0;
+    int have_sweep = have_plants && freq_sweep_init(&sweep, n) == 0;
+    if (!have_sweep) status = -1;
+
+    // Every channel starts at rest at the operating point: the valve at the
+    // bias, the integral holding the command that keeps it there
+    PIDController operating = *pid;
+    operating.sample_time = (float)dt;
+    pid_set_setpoint(&operating, options->bias);
+    operating.integral = (operating.ki != 0.0f) ? options->bias / operating.ki : 0.0f;
+    operating.prev_error = 0.0f;
+    operating.derivative_filtered = 0.0f;
+    operating.prev_output = options->bias;
+    pid_update_coefficients(&operating);
+
+    long total = 0;
+    for (int k = 0; status == 0 && k < n; k++) {
+        double f = (n > 1) ? options->f_min * pow((double)options->f_max / options->f_min, (double)k / (n - 1))
+                           : options->f_min;
+        double period = 1.0 / (f * dt); // Samples
+        long window = lround(options->cycles * period);
+        f = options->cycles / (window * dt);
+        long settle = lround(options->settle_cycles * period);
+        long settle_min = lround(options->settle_time / dt);
+        if (settle < settle_min) settle = settle_min;
+        sweep.start[k] = settle;
+        sweep.end[k] = settle + window;
+        if (sweep.end[k] > total) total = sweep.end[k];
+
+        double w = 2.0 * PI_D * f * dt;
+        sweep.rot_cos[k] = cos(w);
+        sweep.rot_sin[k] = sin(w);
+        sweep.cos[k] = 1.0;
+        sweep.sin[k] = 0.0;
+        points[k].frequency = (float)f;
+
+        pid_bank_load(&bank, k, &operating);
+        if (plant_bank_configure(&plants, k, plant) != 0) status = -1;
+        plants.position[k] = options->bias;
+        plants.backlash_out[k] = options->bias;
+        plants.velocity[k] = 0.0f;
+    }
+
+    int by_setpoint = options->injection == FREQ_INJECT_SETPOINT;
+    int lo = n, hi = n;
+    for (long step = 0; status == 0 && step < total; step++) {
+        if (by_setpoint) {
+            freq_excite_setpoint(n, options->amplitude, options->bias, sweep.sin,
+                                 bank.setpoint, bank.setpoint_target, bank.ramp_step);
+        } else {
+            freq_excite_disturbance(n, options->amplitude, sweep.sin, plants.disturbance);
+        }
+        pid_bank_compute(&bank, plants.position, commands, n);
+        freq_clamp(n, commands);
+
+        // Windows start and end earlier for higher channels (shorter periods),
+        // so the open ones are always one contiguous range [lo, hi)
+        while (lo > 0 && sweep.start[lo - 1] <= step) lo--;
+        while (hi > 0 && sweep.end[hi - 1] <= step) hi--;
+        if (lo < hi) {
+            freq_accumulate_kernel(lo, hi, options->amplitude, sweep.cos, sweep.sin,
+                                   sweep.x_re, sweep.x_im, sweep.m_re, sweep.m_im,
+                                   sweep.e_re, sweep.e_im, sweep.u_re, sweep.u_im,
+                                   plants.position, bank.setpoint, commands);
+        }
+        freq_rotate_kernel(n, sweep.cos, sweep.sin, sweep.rot_cos, sweep.rot_sin);
+        plant_bank_update(&plants, commands, n);
+    }
+
+    for (int k = 0; status == 0 && k < n; k++) {
+        double complex x = sweep.x_re[k] + I * sweep.x_im[k];
+        double complex m = sweep.m_re[k] + I * sweep.m_im[k];
+        double complex e = sweep.e_re[k] + I * sweep.e_im[k];
+        double complex u = sweep.u_re[k] + I * sweep.u_im[k];
+        double complex open, closed, sensitivity;
+        if (by_setpoint) {
+            open = m / e;
+            closed = m / x;
+            sensitivity = e / x;
+        } else {
+            open = -u / (u + x); // Around the plant input: valve sees u + x
+            closed = open / (1.0 + open);
+            sensitivity = 1.0 / (1.0 + open);
+        }
+
+        FreqPoint* p = &points[k];
+        p->open_gain = decibels(open);
+        p->closed_gain = decibels(closed);
+        p->sensitivity = decibels(sensitivity);
+        p->open_phase = degrees(open);
+        p->closed_phase = degrees(closed);
+        if (k > 0) {
+            p->open_phase = unwrap(p->open_phase, points[k - 1].open_phase);
+            p->closed_phase = unwrap(p->closed_phase, points[k - 1].closed_phase);
+        }
+    }
+
+    free(commands);
+    if (have_sweep) free(sweep.storage);
+    if (have_plants) plant_bank_free(&plants);
+    if (have_bank) pid_bank_free(&bank);
+    return status;
+}
+
+// Log-frequency position where a falls to b crosses level, between points k and k + 1
+static float crossing(const FreqPoint* p, int k, float a, float b, float level, float* t) {
+    *t = (a - level) / (a - b);
+    return expf(logf(p[k].frequency) + *t * (logf(p[k + 1].frequency) - logf(p[k].frequency)));
+}
+
+void freq_response_margins(const FreqPoint* points, int count, FreqMargins* margins) {
+    margins->crossover = NAN;
+    margins->phase_margin = NAN;
+    margins->phase_crossover = NAN;
+    margins->gain_margin = NAN;
+    margins->bandwidth = NAN;
+    margins->peak_closed = -INFINITY;
+    margins->peak_sensitivity = -INFINITY;
+
+    for (int k = 0; k < count; k++) {
+        const FreqPoint* p = &points[k];
+        if (p->closed_gain > margins->peak_closed) margins->peak_closed = p->closed_gain;
+        if (p->sensitivity > margins->peak_sensitivity) margins->peak_sensitivity = p->sensitivity;
+        if (k + 1 == count) break;
+
+        const FreqPoint* q = &points[k + 1];
+        float t;
+        if (isnan(margins->crossover) && p->open_gain >= 0.0f && q->open_gain < 0.0f) {
+            margins->crossover = crossing(points, k, p->open_gain, q->open_gain, 0.0f, &t);
+            margins->phase_margin = 180.0f + p->open_phase + t * (q->open_phase - p->open_phase);
+        }
+        if (isnan(margins->phase_crossover) && p->open_phase > -180.0f && q->open_phase <= -180.0f) {
+            margins->phase_crossover = crossing(points, k, p->open_phase, q->open_phase, -180.0f, &t);
+            margins->gain_margin = -(p->open_gain + t * (q->open_gain - p->open_gain));
+        }
+        if (isnan(margins->bandwidth) && p->closed_gain >= -3.0f && q->closed_gain < -3.0f) {
+            margins->bandwidth = crossing(points, k, p->closed_gain, q->closed_gain, -3.0f, &t);
+        }
+    }
+}
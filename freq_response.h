@@ -0,0 +1,77 @@
+#ifndef FREQ_RESPONSE_H
+#define FREQ_RESPONSE_H
+
+#include "pid_controller.h"
+#include "plant_bank.h"
+
+// Frequency response of the closed loop (pid_compute + valve model)
+// Every test frequency is one channel of a PIDBank / PlantBank pair, so
+// the whole stepped-sine sweep is simulated at once: one bank step per
+// sample advances all frequencies. Each channel is excited with a small
+// sine around an operating point, and once it has settled, a single-bin
+// DFT over a whole number of periods accumulates the excitation, position,
+// error and command at that channel's frequency. Only these running sums
+// are kept, never the traces.
+//
+// The DFT phasor is advanced by a per-channel rotation instead of calling
+// sin/cos, and the window is snapped to whole periods (the frequency is
+// adjusted slightly to fit), so there is no leakage at the test frequency.
+//
+// The loop is simulated with all its nonlinearities (derivative filter,
+// rate limit, deadband, command clamp), so the result is the response at
+// the chosen amplitude, not a linearization.
+
+// Where the sine enters the loop
+typedef enum {
+    FREQ_INJECT_SETPOINT = 0, // Added to the setpoint
+    FREQ_INJECT_DISTURBANCE   // Added to the valve command (input disturbance)
+} FreqInjection;
+
+typedef struct {
+    FreqInjection injection;
+    float amplitude;     // Sine amplitude (%)
+    float bias;          // Operating point: setpoint and initial position (%)
+    float f_min;         // Lowest frequency (Hz)
+    float f_max;         // Highest frequency (Hz)
+    int points;          // Log-spaced frequencies
+    int cycles;          // Periods in each DFT window
+    int settle_cycles;   // Periods skipped before the window
+    float settle_time;   // At least this long skipped (s) for the loop transient
+    float sample_time;   // Loop time (s)
+} FreqOptions;
+
+// 0.02-20 Hz, 40 points, 2% sine at 50%, 100 Hz loop
+void freq_options_default(FreqOptions* options);
+
+// One frequency; gains in dB, phases in degrees (unwrapped over the sweep)
+// Setpoint injection measures T, S and L directly; disturbance injection
+// measures L (at the plant input) and derives T and S from it
+typedef struct {
+    float frequency;      // Hz (snapped to whole periods in the window)
+    float open_gain;      // L: loop gain |C P|
+    float open_phase;
+    float closed_gain;    // T: setpoint -> position
+    float closed_phase;
+    float sensitivity;    // S: |1 / (1 + L)|
+} FreqPoint;
+
+typedef struct {
+    float crossover;        // Hz where |L| falls through 0 dB (NAN if none)
+    float phase_margin;     // 180 + phase of L there (deg)
+    float phase_crossover;  // Hz where the phase of L falls through -180 (NAN if none)
+    float gain_margin;      // -|L| there (dB)
+    float bandwidth;        // Hz where |T| first drops below -3 dB (NAN if none)
+    float peak_closed;      // Largest |T| (dB)
+    float peak_sensitivity; // Largest |S| (dB)
+} FreqMargins;
+
+// Sweep pid (its gains, filter, rate limit and ramp) against the valve in
+// plant; points[options->points] receives the results in rising frequency
+// Returns 0 on success, -1 on bad options or allocation failure
+int freq_response_run(const PIDController* pid, const PlantParams* plant,
+                      const FreqOptions* options, FreqPoint* points);
+
+// Crossovers, margins, bandwidth and peaks of a sweep (interpolated in log frequency)
+void freq_response_margins(const FreqPoint* points, int count, FreqMargins* margins);
+
+#endif // FREQ_RESPONSE_H
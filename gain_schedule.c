@@ -0,0 +1,180 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "gain_schedule.h"
+#include "bit_select.h"
+
+#define GAIN_SCHEDULE_COLUMNS 6
+
+// Gains of the user's points at x: linear between points, flat outside
+static void gain_points_at(const GainPoint* points, int num_points, float x, float gains[3]) {
+    const GainPoint* first = &points[0];
+    const GainPoint* last = &points[num_points - 1];
+    if (x <= first->x) {
+        gains[0] = first->kp; gains[1] = first->ki; gains[2] = first->kd;
+        return;
+    }
+    if (x >= last->x) {
+        gains[0] = last->kp; gains[1] = last->ki; gains[2] = last->kd;
+        return;
+    }
+    int k = 0;
+    while (points[k + 1].x < x) k++;
+    const GainPoint* a = &points[k];
+    const GainPoint* b = &points[k + 1];
+    float t = (x - a->x) / (b->x - a->x);
+    gains[0] = a->kp + t * (b->kp - a->kp);
+    gains[1] = a->ki + t * (b->ki - a->ki);
+    gains[2] = a->kd + t * (b->kd - a->kd);
+}
+
+int gain_schedule_init(GainSchedule* schedule, GainScheduleInput input, float x_min, float x_max,
+                       int size, const GainPoint* points, int num_points) {
+    if (size < 2 || num_points < 1 || !(x_max > x_min)) return -1;
+    if (input != GAIN_SCHEDULE_SETPOINT && input != GAIN_SCHEDULE_MEASUREMENT) return -1;
+    for (int k = 0; k < num_points; k++) {
+        if (!(points[k].ki > 0.0f)) return -1; // NaN too
+        if (k > 0 && !(points[k].x > points[k - 1].x)) return -1;
+    }
+
+    float* storage = malloc(sizeof(float) * (size_t)size * GAIN_SCHEDULE_COLUMNS);
+    if (storage == NULL) return -1;
+    float** columns[GAIN_SCHEDULE_COLUMNS] = {
+        &schedule->kp, &schedule->ki, &schedule->kd,
+        &schedule->kp_slope, &schedule->ki_slope, &schedule->kd_slope
+    };
+    for (int c = 0; c < GAIN_SCHEDULE_COLUMNS; c++) {
+        *columns[c] = storage + (size_t)c * size;
+    }
+
+    schedule->input = input;
+    schedule->size = size;
+    schedule->x_min = x_min;
+    schedule->x_max = x_max;
+    schedule->inv_spacing = (float)(size - 1) / (x_max - x_min);
+    schedule->storage = storage;
+
+    double spacing = ((double)x_max - x_min) / (size - 1);
+    for (int j = 0; j < size; j++) {
+        float gains[3];
+        gain_points_at(points, num_points, (float)(x_min + j * spacing), gains);
+        schedule->kp[j] = gains[0];
+        schedule->ki[j] = gains[1];
+        schedule->kd[j] = gains[2];
+    }
+
+    // The last entry is only reached at x_max exactly, with no fraction left
+    for (int j = 0; j < size - 1; j++) {
+        schedule->kp_slope[j] = schedule->kp[j + 1] - schedule->kp[j];
+        schedule->ki_slope[j] = schedule->ki[j + 1] - schedule->ki[j];
+        schedule->kd_slope[j] = schedule->kd[j + 1] - schedule->kd[j];
+    }
+    schedule->kp_slope[size - 1] = 0.0f;
+    schedule->ki_slope[size - 1] = 0.0f;
+    schedule->kd_slope[size - 1] = 0.0f;
+    return 0;
+}
+
+void gain_schedule_free(GainSchedule* schedule) {
+    free(schedule->storage);
+    schedule->storage = NULL;
+    schedule->size = 0;
+}
+
+// Table entry and fraction for x, already clamped to x_min..x_max
+// Takes the table geometry by value so the batch loop keeps it in registers
+static inline int gain_schedule_locate(float x, float x_min, float inv_spacing, int last, float* frac) {
+    float pos = (x - x_min) * inv_spacing;
+    int i = (int)pos;
+    i = (i < last) ? i : last;
+    *frac = pos - (float)i;
+    return i;
+}
+
+void gain_schedule_lookup(const GainSchedule* schedule, float x, float* kp, float* ki, float* kd) {
+    // fminf/fmaxf also map NaN to x_min
+    float frac;
+    x = fminf(fmaxf(x, schedule->x_min), schedule->x_max);
+    int i = gain_schedule_locate(x, schedule->x_min, schedule->inv_spacing, schedule->size - 1, &frac);
+    *kp = schedule->kp[i] + frac * schedule->kp_slope[i];
+    *ki = schedule->ki[i] + frac * schedule->ki_slope[i];
+    *kd = schedule->kd[i] + frac * schedule->kd_slope[i];
+}
+
+// Bumpless ki change: returns 1 / new_ki and rescales the integral so
+// old_ki * integral is kept. new_ki is never 0: every point has ki > 0, so
+// the integral term is never thrown away. old_ki may be 0 (the gains the
+// controller was created with), in which case the integral is already 0.
+static inline float gain_schedule_rescale(float old_ki, float new_ki, float* integral) {
+    float inv_ki = 1.0f / new_ki;
+    *integral *= old_ki * inv_ki;
+    return inv_ki;
+}
+
+void gain_schedule_apply(const GainSchedule* schedule, PIDController* pid, float measurement) {
+    float x = (schedule->input == GAIN_SCHEDULE_SETPOINT) ? pid->setpoint : measurement;
+    float kp, ki, kd;
+    gain_schedule_lookup(schedule, x, &kp, &ki, &kd);
+
+    float inv_ki = gain_schedule_rescale(pid->ki, ki, &pid->integral);
+    pid->kp = kp;
+    pid->ki = ki;
+    pid->kd = kd;
+
+    // Derived coefficients that depend on the gains (the kernel does not)
+    pid->integral_max = pid->output_max * inv_ki;
+    pid->integral_min = pid->output_min * inv_ki;
+}
+
+// Column kernel - restrict pointers, no branches in the loop body
+static void gain_schedule_kernel(int n, const GainSchedule* schedule,
+                                 const float* restrict x,
+                                 float* restrict kp,
+                                 float* restrict ki,
+                                 float* restrict kd,
+                                 float* restrict integral,
+                                 float* restrict integral_min,
+                                 float* restrict integral_max,
+                                 const float* restrict output_min,
+                                 const float* restrict output_max) {
+    const float* restrict t_kp = schedule->kp;
+    const float* restrict t_ki = schedule->ki;
+    const float* restrict t_kd = schedule->kd;
+    const float* restrict s_kp = schedule->kp_slope;
+    const float* restrict s_ki = schedule->ki_slope;
+    const float* restrict s_kd = schedule->kd_slope;
+    float x_min = schedule->x_min;
+    float x_max = schedule->x_max;
+    float inv_spacing = schedule->inv_spacing;
+    int last = schedule->size - 1;
+
+    for (int c = 0; c < n; c++) {
+        // Same clamp as fminf/fmaxf, NaN included, as blends the loop can vectorize
+        float frac;
+        float xc = bit_select(x[c] > x_min, x[c], x_min);
+        xc = bit_select(xc < x_max, xc, x_max);
+        int i = gain_schedule_locate(xc, x_min, inv_spacing, last, &frac);
+        float new_ki = t_ki[i] + frac * s_ki[i];
+
+        float integ = integral[c];
+        float inv_ki = gain_schedule_rescale(ki[c], new_ki, &integ);
+        integral[c] = integ;
+
+        kp[c] = t_kp[i] + frac * s_kp[i];
+        ki[c] = new_ki;
+        kd[c] = t_kd[i] + frac * s_kd[i];
+        integral_max[c] = output_max[c] * inv_ki;
+        integral_min[c] = output_min[c] * inv_ki;
+    }
+}
+
+void gain_schedule_apply_bank(const GainSchedule* schedule, PIDBank* bank,
+                              const float* measurements, int n) {
+    if (n > bank->count) n = bank->count;
+    const float* x = (schedule->input == GAIN_SCHEDULE_SETPOINT) ? bank->setpoint : measurements;
+    gain_schedule_kernel(n, schedule, x,
+                         bank->kp, bank->ki, bank->kd,
+                         bank->integral, bank->integral_min, bank->integral_max,
+                         bank->output_min, bank->output_max);
+}
@@ -0,0 +1,70 @@
+#ifndef GAIN_SCHEDULE_H
+#define GAIN_SCHEDULE_H
+
+#include "pid_controller.h"
+#include "pid_bank.h"
+
+// Gain scheduling over the valve stroke
+// A few operating points (position -> kp, ki, kd) are resampled once into
+// an evenly spaced table. A lookup is then one multiply to find the entry
+// and one multiply-add per gain: no search and no branches, so the batch
+// version is a straight loop over channels the compiler can vectorize
+// (table reads become gathers).
+//
+// Applying a new gain set is bumpless: the integral is rescaled so
+// ki * integral, the integral term of the output, stays where it was, and
+// the anti-windup limits follow the new ki. That needs ki > 0 everywhere,
+// so points without integral action are rejected.
+
+// Operating point used to index the table
+typedef enum {
+    GAIN_SCHEDULE_SETPOINT = 0,  // Current (ramped) setpoint
+    GAIN_SCHEDULE_MEASUREMENT    // Measured position
+} GainScheduleInput;
+
+// One operating point given by the user
+typedef struct {
+    float x;  // Setpoint or position (%)
+    float kp;
+    float ki;
+    float kd;
+} GainPoint;
+
+typedef struct {
+    GainScheduleInput input;
+    int size;          // Table entries (>= 2)
+    float x_min;       // Position of entry 0
+    float x_max;       // Position of entry size - 1
+    float inv_spacing; // (size - 1) / (x_max - x_min)
+
+    // Value at each entry and slope to the next entry (last slope is 0)
+    float* kp;
+    float* ki;
+    float* kd;
+    float* kp_slope;
+    float* ki_slope;
+    float* kd_slope;
+
+    void* storage; // Single allocation backing all columns
+} GainSchedule;
+
+// Resample points (sorted by x, at least one, ki > 0) into a table of size
+// entries spanning x_min..x_max; gains are interpolated linearly between
+// points and held flat outside them
+// Returns 0 on success, -1 on bad arguments or allocation failure
+int gain_schedule_init(GainSchedule* schedule, GainScheduleInput input, float x_min, float x_max,
+                       int size, const GainPoint* points, int num_points);
+void gain_schedule_free(GainSchedule* schedule);
+
+// Interpolated gains at x (clamped to the table range)
+void gain_schedule_lookup(const GainSchedule* schedule, float x, float* kp, float* ki, float* kd);
+
+// Look up the gains for this step and apply them bumplessly
+// Call right before pid_compute() with the same measurement
+void gain_schedule_apply(const GainSchedule* schedule, PIDController* pid, float measurement);
+
+// Same for bank channels [0, n), same arithmetic as the scalar version
+void gain_schedule_apply_bank(const GainSchedule* schedule, PIDBank* bank,
+                              const float* measurements, int n);
+
+#endif // GAIN_SCHEDULE_H
@@ -0,0 +1,193 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "pid_controller.h"
+#include "valve_simulator.h"
+#include "step_metrics.h"
+#include "worker_pool.h"
+#include "step_profile.h"
+
+#define SETTLING_BAND   0.01f  // +/-1% of setpoint
+#define RISE_FRACTION   0.95f  // Rise time measured to 95% of the step
+#define MAX_CANDIDATES  10000000L // About 320 MB of results
+
+typedef struct {
+    float min;
+    float max;
+    int steps;
+} GainRange;
+
+typedef struct {
+    float kp, ki, kd;
+
+    // Step response metrics for the 50% -> 75% step
+    float rise_time;      // Seconds to reach 95% of step (-1 = never)
+    float overshoot;      // Percent of step size
+    float settling_time;  // Seconds to stay within band (-1 = never)
+    float iae;            // Integral of absolute error over the step
+    float ss_error;       // Absolute error at end of run
+} TuningResult;
+
+static float range_value(const GainRange* range, int i) {
+    if (range->steps <= 1) return range->min;
+    return range->min + (range->max - range->min) * (float)i / (float)(range->steps - 1);
+}
+
+// Run one closed-loop simulation and score the setpoint step
+// Nothing is logged - only the metrics survive
+static void simulate_candidate(TuningResult* r) {
+    PIDController pid;
+    ValveSimulator valve;
+    StepMetrics metrics;
+
+    pid_init(&pid, r->kp, r->ki, r->kd, STEP_PROFILE_SAMPLE_TIME);
+    pid_set_setpoint(&pid, STEP_PROFILE_INITIAL_SETPOINT);
+    valve_init(&valve, STEP_PROFILE_VALVE_TAU, 0.0f);
+    valve.disturbance = 0.0f;
+    step_metrics_init(&metrics, SETTLING_BAND, RISE_FRACTION, 0.0f, 100.0f);
+
+    for (int tick = 0; tick < STEP_PROFILE_TOTAL_STEPS; tick++) {
+        if (tick == STEP_PROFILE_STEP_TICK) pid_set_setpoint(&pid, STEP_PROFILE_STEP_SETPOINT);
+
+        float measurement = valve.position;
+        float control_signal = pid_compute(&pid, measurement);
+        if (control_signal < 0.0f) control_signal = 0.0f;
+        if (control_signal > 100.0f) control_signal = 100.0f;
+        step_metrics_update(&metrics, &pid, measurement, control_signal);
+        valve_update(&valve, control_signal, STEP_PROFILE_SAMPLE_TIME);
+    }
+
+    // Metrics restarted at the step, so they describe the 50% -> 75% response
+    r->rise_time = metrics.rise_time;
+    r->overshoot = metrics.overshoot;
+    r->settling_time = metrics.settling_time;
+    r->iae = (float)metrics.iae;
+    r->ss_error = fabsf(STEP_PROFILE_STEP_SETPOINT - valve.position);
+}
+
+static void tuner_item(void* context, long index) {
+    simulate_candidate(&((TuningResult*)context)[index]);
+}
+
+// Order: settled before unsettled, then settling time, overshoot, IAE
+static int compare_results(const void* a, const void* b) {
+    const TuningResult* ra = (const TuningResult*)a;
+    const TuningResult* rb = (const TuningResult*)b;
+
+    int a_settled = ra->settling_time >= 0.0f;
+    int b_settled = rb->settling_time >= 0.0f;
+    if (a_settled != b_settled) return b_settled - a_settled;
+
+    if (ra->settling_time < rb->settling_time) return -1;
+    if (ra->settling_time > rb->settling_time) return 1;
+    if (ra->overshoot < rb->overshoot) return -1;
+    if (ra->overshoot > rb->overshoot) return 1;
+    if (ra->iae < rb->iae) return -1;
+    if (ra->iae > rb->iae) return 1;
+    return 0;
+}
+
+static void print_usage(const char* name) {
+    printf("Usage: %s kp_min kp_max kp_steps ki_min ki_max ki_steps kd_min kd_max kd_steps [threads]\n", name);
+    printf("Example: %s 2 10 33 1 8 29 0 0.5 11\n", name);
+}
+
+int main(int argc, char* argv[])
+{
+    // Default grid brackets the Day 4 configurations
+    GainRange kp = {2.0f, 10.0f, 17};
+    GainRange ki = {1.0f, 8.0f, 15};
+    GainRange kd = {0.0f, 0.5f, 11};
+    int num_threads = 0; // One per CPU
+
+    if (argc >= 10)
+        {
+            kp.min = atof(argv[1]); kp.max = atof(argv[2]); kp.steps = atoi(argv[3]);
+            ki.min = atof(argv[4]); ki.max = atof(argv[5]); ki.steps = atoi(argv[6]);
+            kd.min = atof(argv[7]); kd.max = atof(argv[8]); kd.steps = atoi(argv[9]);
+            if (argc >= 11) num_threads = atoi(argv[10]);
+        }
+    else if (argc > 1)
+        {
+            print_usage(argv[0]);
+            return -1;
+        }
+
+    if (kp.steps < 1 || ki.steps < 1 || kd.steps < 1)
+        {
+            printf("Error: step counts must be at least 1\n");
+            return -1;
+        }
+    // Checked in floating point: the product of three ints can overflow a long
+    if ((double)kp.steps * ki.steps * kd.steps > MAX_CANDIDATES)
+        {
+            printf("Error: grid exceeds %ld candidates\n", MAX_CANDIDATES);
+            return -1;
+        }
+
+    long count = (long)kp.steps * ki.steps * kd.steps;
+    num_threads = worker_pool_threads(num_threads, count);
+    TuningResult* results = malloc(sizeof(TuningResult) * count);
+    if (results == NULL)
+        {
+            printf("Error allocating %ld candidates!\n", count);
+            return -1;
+        }
+
+    long n = 0;
+    for (int a = 0; a < kp.steps; a++)
+        for (int b = 0; b < ki.steps; b++)
+            for (int c = 0; c < kd.steps; c++)
+                {
+                    results[n].kp = range_value(&kp, a);
+                    results[n].ki = range_value(&ki, b);
+                    results[n].kd = range_value(&kd, c);
+                    n++;
+                }
+
+    printf("Gain Sweep Tuner\n");
+    printf("- Kp: %.3f to %.3f (%d steps)\n", kp.min, kp.max, kp.steps);
+    printf("- Ki: %.3f to %.3f (%d steps)\n", ki.min, ki.max, ki.steps);
+    printf("- Kd: %.3f to %.3f (%d steps)\n", kd.min, kd.max, kd.steps);
+    printf("- Candidates: %ld on %d threads\n\n", count, num_threads);
+
+    // Candidates are handed out one at a time, so slow corners of the grid balance out
+    int used = worker_pool_run(count, num_threads, tuner_item, results);
+    if (used < num_threads)
+        {
+            printf("Warning: only %d of %d threads started\n\n", used, num_threads);
+        }
+
+    qsort(results, count, sizeof(TuningResult), compare_results);
+
+    FILE* summary = fopen("tuning_summary.csv", "w");
+    if (summary == NULL)
+        {
+            printf("Error opening summary file!\n");
+            free(results);
+            return -1;
+        }
+    fprintf(summary, "Rank,Kp,Ki,Kd,RiseTime,Overshoot,SettlingTime,IAE,SSError\n");
+    for (long i = 0; i < count; i++)
+        {
+            const TuningResult* r = &results[i];
+            fprintf(summary, "%ld,%.3f,%.3f,%.3f,%.2f,%.2f,%.2f,%.3f,%.3f\n",
+                    i + 1, r->kp, r->ki, r->kd, r->rise_time, r->overshoot,
+                    r->settling_time, r->iae, r->ss_error);
+        }
+    fclose(summary);
+
+    printf("Rank  Kp      Ki      Kd      Rise(s)  Over(%%)  Settle(s)  IAE\n");
+    printf("----  ------  ------  ------  -------  -------  ---------  -------\n");
+    for (long i = 0; i < count && i < 10; i++)
+        {
+            const TuningResult* r = &results[i];
+            printf("%-4ld  %-6.3f  %-6.3f  %-6.3f  %-7.2f  %-7.2f  %-9.2f  %.3f\n",
+                   i + 1, r->kp, r->ki, r->kd, r->rise_time, r->overshoot,
+                   r->settling_time, r->iae);
+        }
+
+    printf("\nSummary of %ld candidates written to tuning_summary.csv\n", count);
+    free(results);
+    return 0;
+}
@@ -0,0 +1,149 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <time.h>
+#include "pid_controller.h"
+#include "valve_simulator.h"
+#include "plant_link.h"
+#include "rt_executor.h"
+#include "step_profile.h"
+
+// Hardware-in-the-loop style controller: rt_controller's loop, but the valve
+// lives in a plant_server process and is reached through shared memory.
+// A local valve is fed the same commands so the effect of link latency and
+// missed samples shows up as the difference between the two positions.
+typedef struct {
+    PIDController pid;
+    PlantClient client;
+    ValveSimulator reference; // In-process valve driven by the same commands
+    uint64_t step_tick;       // Tick of the 50% -> 75% setpoint change
+    float dt;
+    float worst_difference;   // Largest |remote - in-process| position
+} HilControlLoop;
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void handle_signal(int sig) {
+    (void)sig;
+    stop_requested = 1;
+}
+
+static int control_step(void* context, uint64_t tick) {
+    HilControlLoop* loop = (HilControlLoop*)context;
+
+    // Fires once, even if an overrun skipped the exact tick
+    if (tick >= loop->step_tick) {
+        pid_set_setpoint(&loop->pid, STEP_PROFILE_STEP_SETPOINT);
+        loop->step_tick = UINT64_MAX;
+    }
+
+    float position = plant_client_get_position(&loop->client);
+    float difference = position - valve_get_position(&loop->reference);
+    if (difference < 0.0f) difference = -difference;
+    if (difference > loop->worst_difference) loop->worst_difference = difference;
+
+    float control_signal = pid_compute(&loop->pid, position);
+    if (control_signal < 0.0f) control_signal = 0.0f;
+    if (control_signal > 100.0f) control_signal = 100.0f;
+    plant_client_update(&loop->client, control_signal, loop->dt);
+    valve_update(&loop->reference, control_signal, loop->dt);
+
+    return stop_requested;
+}
+
+int main(int argc, char* argv[])
+{
+    // Defaults: 1 kHz for 15 s on /hv_plant channel 0, replies due within one period
+    double rate_hz = 1000.0;
+    double duration = 15.0;
+    const char* name = "/hv_plant";
+    int channel = 0;
+    double wait_us = 0.0;
+    int cpu = -1;
+    int priority = 0;
+
+    if (argc >= 2) rate_hz = atof(argv[1]);
+    if (argc >= 3) duration = atof(argv[2]);
+    if (argc >= 4) name = argv[3];
+    if (argc >= 5) channel = atoi(argv[4]);
+    if (argc >= 6) wait_us = atof(argv[5]);
+    if (argc >= 7) cpu = atoi(argv[6]);
+    if (argc >= 8) priority = atoi(argv[7]);
+
+    if (rate_hz <= 0.0 || duration <= 0.0 || wait_us < 0.0)
+        {
+            printf("Usage: %s [rate_hz] [duration_s] [/name] [channel] [wait_us] [cpu] [fifo_priority]\n", argv[0]);
+            return -1;
+        }
+
+    HilControlLoop loop;
+    loop.dt = (float)(1.0 / rate_hz);
+    loop.step_tick = (uint64_t)(STEP_PROFILE_STEP_TIME * rate_hz + 0.5);
+    loop.worst_difference = 0.0f;
+    pid_init(&loop.pid, STEP_PROFILE_KP, STEP_PROFILE_KI, STEP_PROFILE_KD, loop.dt);
+    pid_set_setpoint(&loop.pid, STEP_PROFILE_INITIAL_SETPOINT);
+    valve_init(&loop.reference, STEP_PROFILE_VALVE_TAU, 0.0f);
+    loop.reference.disturbance = 0.0f;
+
+    // The server may still be starting: retry for up to two seconds
+    uint64_t wait_ns = (uint64_t)(wait_us * 1000.0 + 0.5);
+    int attached = 0;
+    for (int i = 0; i < 200 && !attached; i++)
+        {
+            attached = plant_client_open(&loop.client, name, channel, wait_ns) == 0;
+            if (!attached)
+                {
+                    struct timespec pause = { 0, 10000000L };
+                    nanosleep(&pause, NULL);
+                }
+        }
+    if (!attached)
+        {
+            printf("Error attaching to plant server %s channel %d!\n", name, channel);
+            return -1;
+        }
+
+    uint64_t period_ns = (uint64_t)(1e9 / rate_hz + 0.5);
+    uint64_t ticks = (uint64_t)(duration * rate_hz + 0.5);
+
+    RtExecutor exec;
+    if (rt_executor_init(&exec, period_ns, cpu, priority) != 0)
+        {
+            printf("Warning: could not apply CPU pinning / SCHED_FIFO (need privileges?)\n");
+        }
+
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
+
+    printf("Hardware-in-the-Loop Valve Control\n");
+    printf("- Plant: %s channel %d\n", name, channel);
+    printf("- Rate: %.1f Hz (period %.3f us)\n", rate_hz, period_ns / 1000.0);
+    printf("- Duration: %.1f s (%llu ticks)\n", duration, (unsigned long long)ticks);
+    printf("- Reply wait: %.1f us\n", wait_us);
+
+    if (rt_executor_run(&exec, control_step, &loop, ticks) != 0)
+        {
+            printf("Error: clock_nanosleep failed!\n");
+            return -1;
+        }
+
+    PlantClient* client = &loop.client;
+    printf("\nFinal Position: %.1f%%\n", client->position);
+    printf("Final Error: %.1f%%\n", loop.pid.setpoint - client->position);
+    printf("Worst difference from in-process loop: %.3f%%\n", loop.worst_difference);
+    printf("\nLink: %llu commands, %llu missed samples (%llu held the last position)\n",
+           (unsigned long long)client->sequence, (unsigned long long)client->missed,
+           (unsigned long long)client->stale);
+    printf("Server: %llu applied, %llu replies dropped, %llu overruns\n",
+           (unsigned long long)atomic_load(&client->shared->applied),
+           (unsigned long long)atomic_load(&client->shared->dropped),
+           (unsigned long long)atomic_load(&client->shared->overruns));
+    rt_histogram_print(&client->round_trip, "Command sent -> position received", stdout);
+    rt_executor_dump(&exec, stdout);
+
+    plant_client_stop_server(client);
+    plant_client_close(client);
+    return exec.deadline_misses > 0 ? 1 : 0;
+}
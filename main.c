@@ -1,14 +1,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
-#include <time.h>
 #include <math.h>
 #include "pid_controller.h"
 #include "valve_simulator.h"
+#include "telemetry_log.h"
+#include "step_metrics.h"
+#include "scenario.h"
+#include "decimator.h"
 
 typedef struct {
-    PIDController pid;
-    ValveSimulator valve;
+    ScenarioRunner runner; // Controller, valve and step metrics, driven by the scenario
 
     // system status
     bool running;
@@ -19,121 +21,205 @@ typedef struct {
     float control_effort;
 } HydraulicSystem;
 
+// Signals reduced for monitoring, in push order
+enum { SIGNAL_SETPOINT, SIGNAL_POSITION, SIGNAL_ERROR, SIGNAL_COMMAND, SIGNAL_COUNT };
+static const char* const signal_names[SIGNAL_COUNT] = { "Setpoint", "Position", "Error", "Command" };
+
+// Console view: one line per 500 ms window with the last value of each
+// signal plus the position and command range inside the window, so
+// overshoot spikes and a saturated command are not skipped
+static void console_sink(const DecimatorWindow* window, void* context)
+    {
+        (void)context;
+        printf("%.2f      %.1f     %.1f      %.1f       %.1f      %.1f-%.1f     %.1f-%.1f\n",
+            window->end_time,
+            window->last[SIGNAL_SETPOINT],
+            window->last[SIGNAL_POSITION],
+            window->last[SIGNAL_ERROR],
+            window->last[SIGNAL_COMMAND],
+            window->min[SIGNAL_POSITION], window->max[SIGNAL_POSITION],
+            window->min[SIGNAL_COMMAND], window->max[SIGNAL_COMMAND]);
+    }
+
 int main(int argc, char* argv[]) 
 {
     HydraulicSystem system;
 
-    // Default gains
-    float kp = 5.0f;
-    float ki = 4.0f;
-    float kd = 0.1f;
+    // Test profile, gains and valve come from the scenario file
+    // Usage: valve_controller [kp ki kd] [scenario.scn]
+    if (argc != 1 && argc != 2 && argc != 4 && argc != 5)
+        {
+            printf("Usage: %s [kp ki kd] [scenario.scn]\n", argv[0]);
+            return -1;
+        }
+    const char* scenario_path = "scenarios/baseline.scn";
+    if (argc == 2) scenario_path = argv[1];
+    if (argc == 5) scenario_path = argv[4];
+
+    Scenario scenario;
+    if (scenario_load(&scenario, scenario_path) != 0)
+        {
+            if (scenario.error_line > 0)
+                printf("Error in %s line %d!\n", scenario_path, scenario.error_line);
+            else
+                printf("Error opening %s!\n", scenario_path);
+            return -1;
+        }
 
     // Override gains if provided as command-line arguments
     if (argc >= 4) 
         {
-            kp = atof(argv[1]);
-            ki = atof(argv[2]);
-            kd = atof(argv[3]);
-            printf("Using custom gains: kp=%.2f, ki=%.2f, kd=%.2f\n", kp, ki, kd);
+            scenario.kp = atof(argv[1]);
+            scenario.ki = atof(argv[2]);
+            scenario.kd = atof(argv[3]);
+            printf("Using custom gains: kp=%.2f, ki=%.2f, kd=%.2f\n", scenario.kp, scenario.ki, scenario.kd);
+
+            // Fixed gains from the command line replace a gain schedule
+            if (scenario.num_gain_points > 0)
+                {
+                    gain_schedule_free(&scenario.schedule);
+                    scenario.num_gain_points = 0;
+                }
         }   
+    else if (scenario.num_gain_points > 0)
+        {
+            printf("Using scenario gain schedule (%d points)\n", scenario.num_gain_points);
+        }
     else
         {
-            printf("Using default gains: kp=%.2f, ki=%.2f, kd=%.2f\n", kp, ki, kd);
+            printf("Using scenario gains: kp=%.2f, ki=%.2f, kd=%.2f\n", scenario.kp, scenario.ki, scenario.kd);
         }
 
-    // Open CSV log file with unique name based on gains
+    // Open binary telemetry log with unique name based on gains
+    // (converted to CSV after the run, off the control loop)
     char filename[100];
-    sprintf(filename, "tuning_kp%.1f_ki%.1f_kd%.1f.csv", kp, ki, kd);
-    FILE* log_file = fopen(filename, "w");
-    if (log_file == NULL) 
+    char log_filename[100];
+    char monitor_filename[100];
+    sprintf(filename, "tuning_kp%.1f_ki%.1f_kd%.1f.csv", scenario.kp, scenario.ki, scenario.kd);
+    sprintf(log_filename, "tuning_kp%.1f_ki%.1f_kd%.1f.bin", scenario.kp, scenario.ki, scenario.kd);
+    sprintf(monitor_filename, "monitor_kp%.1f_ki%.1f_kd%.1f.csv", scenario.kp, scenario.ki, scenario.kd);
+    TelemetryLog telemetry;
+    if (telemetry_log_open(&telemetry, log_filename, 4096) != 0) 
         {
             printf("Error opening log file!\n");
+            scenario_free(&scenario);
             return -1;
         }
-    srand(time(NULL)); // Seed random number generator
-    fprintf(log_file, "Time,Setpoint,Position,Error,Command\n");
 
-    // Initialize PID controller
-    pid_init(&system.pid, kp, ki, kd, 0.01f);
-    pid_set_setpoint(&system.pid, 50.0f); // Initial target position 50%
-
-    // Initialize valve simulator
-    system.valve.position = 0.0f;
-    system.valve.velocity = 0.0f;
-    system.valve.time_constant = 0.2f; // seconds
-    system.valve.deadband = 0.0f;
-    system.valve.command = 0.0f;
-    system.valve.disturbance = 0.0f; // No external disturbances
+    // Initialize PID controller, valve simulator and step metrics from the scenario
+    scenario_runner_init(&system.runner, &scenario);
+    PIDController* pid = &system.runner.pid;
+    ValveSimulator* valve = &system.runner.valve;
 
     system.running = true;
     system.current_time = 0.0f;
 
     // Print startup message
     printf("Hydraulic Valve Control System Starting...\n");
-    printf("PID Gains: Kp=%.1f, Ki=%.1f, Kd=%.1f\n", 
-            system.pid.kp, system.pid.ki, system.pid.kd);
-    printf("Setpoint: %.1f%%\n\n", system.pid.setpoint);
-    printf("Time(s)  Setpoint  Position  Error     Command\n");
-    printf("-------  --------  --------  --------  --------\n");
-
-    // Main control loop
-    float dt = system.pid.sample_time;
-
-    while (system.running && system.current_time < 15.0f) {
-        
-        // Change setpoint at 5 seconds (50% -> 75%)
-        if (system.current_time >= 5.0f && system.current_time < 5.01f) 
-            {
-                pid_set_setpoint(&system.pid, 75.0f);
-                printf("\n>>> Setpoint changed to 75.0%% <<<\n\n");
-            }
-
-        // Compute PID output based on current valve position
-        float control_signal = pid_compute(&system.pid, system.valve.position);
-
-        // Clamp control signal to valid valve range [0, 100]%
-        if (control_signal < 0.0f) control_signal = 0.0f;
-        if (control_signal > 100.0f) control_signal = 100.0f;
+    printf("Scenario: %s, %.1f s, events: %d\n", scenario.name,
+           scenario.total_ticks * scenario.sample_time, scenario.num_events);
+    printf("PID Gains: Kp=%.1f, Ki=%.1f, Kd=%.1f\n", pid->kp, pid->ki, pid->kd);
+    if (scenario.num_gain_points > 0)
+        {
+            printf("Gain schedule: %d points by %s\n", scenario.num_gain_points,
+                   scenario.schedule_input == GAIN_SCHEDULE_SETPOINT ? "setpoint" : "position");
+        }
+    printf("Setpoint: %.1f%%\n\n", pid->setpoint);
+    printf("Time(s)  Setpoint  Position  Error     Command   Position     Command\n");
+    printf("-------  --------  --------  --------  --------  -----------  -----------\n");
+
+    // Live monitoring: every signal reduced to 500 ms windows, shown on the
+    // console and written to a low-rate monitor file
+    Decimator monitor;
+    DecimatorCsvSink monitor_csv = { fopen(monitor_filename, "w"), signal_names, SIGNAL_COUNT, 0, 0 };
+    if (monitor_csv.file == NULL ||
+        decimator_init(&monitor, SIGNAL_COUNT, (int)lroundf(0.5f / scenario.sample_time), 0) != 0)
+        {
+            printf("Error creating monitor!\n");
+            if (monitor_csv.file != NULL) fclose(monitor_csv.file);
+            telemetry_log_close(&telemetry);
+            scenario_free(&scenario);
+            return -1;
+        }
+    decimator_add_sink(&monitor, console_sink, NULL);
+    decimator_add_sink(&monitor, decimator_csv_sink, &monitor_csv);
 
-        // Update valve physics with control signal
-        valve_update(&system.valve, control_signal, dt);
+    // Main control loop: the runner applies the scenario's events on their
+    // tick, computes the PID output and updates the valve
+    float previous_target = pid->setpoint_target;
 
-        // Calculate error for monitoring
-        system.position_error = system.pid.setpoint - system.valve.position;
-        system.control_effort = control_signal;
+    while (system.running && scenario_runner_step(&system.runner)) {
+        system.current_time = system.runner.time;
 
-        // Print status every 500ms
-        if (fmod(system.current_time, 0.5f) < 0.01f) 
+        if (pid->setpoint_target != previous_target) 
             {
-                printf("%.2f      %.1f     %.1f      %.1f       %.1f\n",
-                    system.current_time, 
-                    system.pid.setpoint,
-                    system.valve.position, 
-                    system.position_error, 
-                    system.control_effort);
+                printf("\n>>> Setpoint changed to %.1f%% <<<\n\n", pid->setpoint_target);
+                previous_target = pid->setpoint_target;
             }
 
-        // Log all data to CSV
-        fprintf(log_file, "%.2f,%.1f,%.1f,%.1f,%.1f\n",
-                system.current_time, 
-                system.pid.setpoint,
-                system.valve.position, 
-                system.position_error, 
-                system.control_effort);
-
-        // Increment time
-        system.current_time += dt;
+        // Calculate error for monitoring
+        system.position_error = pid->setpoint - valve->position;
+        system.control_effort = system.runner.command;
+
+        // Feed the console monitor (prints when a 500 ms window completes)
+        float signals[SIGNAL_COUNT] = {
+            pid->setpoint, valve->position, system.position_error, system.control_effort
+        };
+        decimator_push(&monitor, system.current_time, signals);
+
+        // Log all data (binary record, drained by the writer thread)
+        TelemetryRecord record = {
+            .time = system.current_time,
+            .setpoint = pid->setpoint,
+            .position = valve->position,
+            .error = system.position_error,
+            .command = system.control_effort,
+            .integral = pid->integral,
+            .derivative_filtered = pid->derivative_filtered
+        };
+        telemetry_log_push(&telemetry, &record);
     }
+    decimator_flush(&monitor);
+    decimator_free(&monitor);
+    fclose(monitor_csv.file);
+    system.current_time = system.runner.tick * scenario.sample_time;
 
     // Print summary statistics
     printf("\n=== Simulation Complete ===\n");
-    printf("Final Position: %.1f%%\n", system.valve.position);
+    printf("Final Position: %.1f%%\n", valve->position);
     printf("Final Error: %.1f%%\n", system.position_error);
     printf("Run Time: %.2f seconds\n", system.current_time);
 
-    // Close log file
-    fclose(log_file);
+    printf("\n=== Step Response ===\n");
+    step_metrics_print(&system.runner.metrics);
+
+#ifdef PID_INSTRUMENTATION
+    PidStatsSnapshot pid_stats;
+    pid_stats_snapshot(&pid->stats, &pid_stats);
+    printf("\n=== Controller Internals ===\n");
+    pid_stats_print(&pid_stats, "PID", stdout);
+#endif
+
+    // Flush telemetry and convert to CSV
+    int log_status = telemetry_log_close(&telemetry);
+    scenario_free(&scenario);
+    if (log_status != 0)
+        {
+            printf("Error writing %s!\n", log_filename);
+            return -1;
+        }
+    if (telemetry_log_overruns(&telemetry) > 0)
+        {
+            printf("Warning: %llu telemetry records dropped\n",
+                   (unsigned long long)telemetry_log_overruns(&telemetry));
+        }
+    if (telemetry_export_csv(log_filename, filename, 0) < 0)
+        {
+            printf("Error writing %s!\n", filename);
+            return -1;
+        }
     printf("\nData logged to %s\n", filename);
+    printf("Monitor windows logged to %s\n", monitor_filename);
 
     return 0; 
 }
\ No newline at end of file
@@ -0,0 +1,260 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "pid_controller.h"
+#include "valve_simulator.h"
+#include "step_metrics.h"
+#include "rng.h"
+#include "worker_pool.h"
+#include "step_profile.h"
+
+// Perturbation ranges (uniform)
+#define TAU_MIN          0.15f  // Valve time constant (s), nominal 0.2
+#define TAU_MAX          0.30f
+#define DEADBAND_MAX     0.5f   // Valve deadband (%)
+#define LOAD_STEP_MAX    5.0f   // Load disturbance step, +/- (%)
+#define LOAD_TICK_MIN    800    // Load step applied between 8 s and 14 s
+#define LOAD_TICK_MAX    1400
+#define RIPPLE_MAX       1.0f   // Sinusoidal disturbance amplitude (%)
+#define RIPPLE_FREQ_MIN  0.2f   // Hz
+#define RIPPLE_FREQ_MAX  2.0f
+#define NOISE_MAX        0.2f   // Sensor noise standard deviation (%)
+
+#define NUM_METRICS 8
+
+typedef struct {
+    float tau;
+    float deadband;
+    float load_step;
+    int load_tick;
+    float ripple_amplitude;
+    float ripple_frequency;
+    float noise_sigma;
+} RunParameters;
+
+typedef struct {
+    RunParameters params;
+    float metric[NUM_METRICS]; // Indexed like metric_names (INFINITY = never reached)
+} RunResult;
+
+static const char* metric_names[NUM_METRICS] = {
+    "Rise time (s)", "Settling time (s)", "Overshoot (%)", "IAE",
+    "ITAE", "SS error (%)", "Effort", "Saturated (s)"
+};
+
+typedef struct {
+    PIDController nominal; // Configured controller copied into every run
+    uint64_t seed;
+    RunResult* results;
+} MonteCarloStudy;
+
+// Draw the plant and disturbance for one run
+// The generator is seeded from (seed, run), so a run is reproducible on its own
+static void draw_parameters(Rng* rng, RunParameters* p) {
+    p->tau = rng_range(rng, TAU_MIN, TAU_MAX);
+    p->deadband = rng_range(rng, 0.0f, DEADBAND_MAX);
+    p->load_step = rng_range(rng, -LOAD_STEP_MAX, LOAD_STEP_MAX);
+    p->load_tick = LOAD_TICK_MIN + (int)(rng_uniform(rng) * (LOAD_TICK_MAX - LOAD_TICK_MIN));
+    p->ripple_amplitude = rng_range(rng, 0.0f, RIPPLE_MAX);
+    p->ripple_frequency = rng_range(rng, RIPPLE_FREQ_MIN, RIPPLE_FREQ_MAX);
+    p->noise_sigma = rng_range(rng, 0.0f, NOISE_MAX);
+}
+
+// Closed loop with perturbed plant, load disturbance, ripple and sensor noise
+// The controller sees the noisy measurement; metrics score the true position
+static void simulate_run(const PIDController* nominal, uint64_t seed, long run, RunResult* r) {
+    Rng rng;
+    PIDController pid = *nominal;
+    ValveSimulator valve;
+    StepMetrics metrics;
+
+    rng_seed(&rng, seed, (uint64_t)run);
+    draw_parameters(&rng, &r->params);
+    const RunParameters* p = &r->params;
+
+    pid_set_setpoint(&pid, STEP_PROFILE_INITIAL_SETPOINT);
+    valve_init(&valve, p->tau, p->deadband);
+    step_metrics_init(&metrics, 0.01f, 0.95f, 0.0f, 100.0f);
+
+    // Ripple from a rotation recurrence instead of sinf() every step
+    float w = 6.2831853f * p->ripple_frequency * STEP_PROFILE_SAMPLE_TIME;
+    float phase = rng_range(&rng, 0.0f, 6.2831853f);
+    float ripple = p->ripple_amplitude * sinf(phase);
+    float ripple_prev = p->ripple_amplitude * sinf(phase - w);
+    float ripple_coeff = 2.0f * cosf(w);
+
+    for (int tick = 0; tick < STEP_PROFILE_TOTAL_STEPS; tick++) {
+        if (tick == STEP_PROFILE_STEP_TICK) pid_set_setpoint(&pid, STEP_PROFILE_STEP_SETPOINT);
+
+        float load = (tick >= p->load_tick) ? p->load_step : 0.0f;
+        valve.disturbance = load + ripple;
+        float next = ripple_coeff * ripple - ripple_prev;
+        ripple_prev = ripple;
+        ripple = next;
+
+        float measurement = valve.position + p->noise_sigma * rng_normal(&rng);
+        float control_signal = pid_compute(&pid, measurement);
+        if (control_signal < 0.0f) control_signal = 0.0f;
+        if (control_signal > 100.0f) control_signal = 100.0f;
+
+        step_metrics_update(&metrics, &pid, valve.position, control_signal);
+        valve_update(&valve, control_signal, STEP_PROFILE_SAMPLE_TIME);
+    }
+
+    r->metric[0] = metrics.rise_time >= 0.0f ? metrics.rise_time : INFINITY;
+    r->metric[1] = metrics.settling_time >= 0.0f ? metrics.settling_time : INFINITY;
+    r->metric[2] = metrics.overshoot;
+    r->metric[3] = (float)metrics.iae;
+    r->metric[4] = (float)metrics.itae;
+    r->metric[5] = fabsf(metrics.final_error);
+    r->metric[6] = (float)metrics.control_effort;
+    r->metric[7] = metrics.saturation_time;
+}
+
+static void monte_carlo_item(void* context, long run) {
+    const MonteCarloStudy* study = (const MonteCarloStudy*)context;
+    simulate_run(&study->nominal, study->seed, run, &study->results[run]);
+}
+
+static int compare_floats(const void* a, const void* b) {
+    float fa = *(const float*)a;
+    float fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+// Nearest-rank percentile of a sorted array
+static float percentile(const float* sorted, long count, float p) {
+    long rank = (long)ceilf(p / 100.0f * (float)count);
+    if (rank < 1) rank = 1;
+    return sorted[rank - 1];
+}
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void print_usage(const char* name) {
+    printf("Usage: %s [runs] [seed] [kp ki kd] [threads]\n", name);
+    printf("Example: %s 100000 42 5 4 0.1\n", name);
+}
+
+int main(int argc, char* argv[])
+{
+    long runs = 100000;
+    uint64_t seed = 1;
+    float kp = STEP_PROFILE_KP, ki = STEP_PROFILE_KI, kd = STEP_PROFILE_KD;
+    int num_threads = 0; // One per CPU
+
+    if (argc >= 2) runs = atol(argv[1]);
+    if (argc >= 3) seed = strtoull(argv[2], NULL, 10);
+    if (argc == 4 || argc == 5)
+        {
+            print_usage(argv[0]);
+            return -1;
+        }
+    if (argc >= 6)
+        {
+            kp = atof(argv[3]);
+            ki = atof(argv[4]);
+            kd = atof(argv[5]);
+        }
+    if (argc >= 7) num_threads = atoi(argv[6]);
+
+    if (runs < 1)
+        {
+            print_usage(argv[0]);
+            return -1;
+        }
+    num_threads = worker_pool_threads(num_threads, runs);
+
+    RunResult* results = malloc(sizeof(RunResult) * runs);
+    float* column = malloc(sizeof(float) * runs);
+    if (results == NULL || column == NULL)
+        {
+            printf("Error allocating %ld runs!\n", runs);
+            free(results);
+            free(column);
+            return -1;
+        }
+
+    printf("Monte Carlo Robustness Study\n");
+    printf("- Gains: Kp=%.3f, Ki=%.3f, Kd=%.3f\n", kp, ki, kd);
+    printf("- Runs: %ld on %d threads, seed %llu\n", runs, num_threads, (unsigned long long)seed);
+    printf("- Tau %.2f-%.2f s, deadband 0-%.1f%%, load step +/-%.1f%%, ripple 0-%.1f%%, noise 0-%.2f%%\n\n",
+           TAU_MIN, TAU_MAX, DEADBAND_MAX, LOAD_STEP_MAX, RIPPLE_MAX, NOISE_MAX);
+
+    PIDController nominal;
+    pid_init(&nominal, kp, ki, kd, STEP_PROFILE_SAMPLE_TIME);
+
+    // Each run is seeded from its index, so results do not depend on the thread count
+    MonteCarloStudy study = { nominal, seed, results };
+    double start = now_s();
+    int used = worker_pool_run(runs, num_threads, monte_carlo_item, &study);
+    double elapsed = now_s() - start;
+    if (used < num_threads)
+        {
+            printf("Warning: only %d of %d threads started\n\n", used, num_threads);
+        }
+
+    FILE* summary = fopen("monte_carlo_summary.csv", "w");
+    if (summary == NULL)
+        {
+            printf("Error opening summary file!\n");
+            free(results);
+            free(column);
+            return -1;
+        }
+    fprintf(summary, "Metric,P5,P50,P95,P99,Max\n");
+
+    static const float levels[] = {5.0f, 50.0f, 95.0f, 99.0f, 100.0f};
+    printf("Metric              P5        P50       P95       P99       Max\n");
+    printf("------------------  --------  --------  --------  --------  --------\n");
+    long unsettled = 0;
+    for (int m = 0; m < NUM_METRICS; m++)
+        {
+            for (long i = 0; i < runs; i++) column[i] = results[i].metric[m];
+            qsort(column, runs, sizeof(float), compare_floats);
+            if (m == 1)
+                {
+                    for (long i = 0; i < runs; i++) if (isinf(column[i])) unsettled++;
+                }
+
+            printf("%-18s", metric_names[m]);
+            fprintf(summary, "%s", metric_names[m]);
+            for (int l = 0; l < 5; l++)
+                {
+                    float value = percentile(column, runs, levels[l]);
+                    if (isinf(value)) printf("  %-8s", "never");
+                    else printf("  %-8.3f", value);
+                    fprintf(summary, ",%.4f", value);
+                }
+            printf("\n");
+            fprintf(summary, "\n");
+        }
+    fclose(summary);
+
+    // Worst run by IAE, with everything needed to reproduce it
+    long worst = 0;
+    for (long i = 1; i < runs; i++)
+        {
+            if (results[i].metric[3] > results[worst].metric[3]) worst = i;
+        }
+    const RunParameters* p = &results[worst].params;
+    printf("\nNot settled within +/-1%%: %ld of %ld runs (%.2f%%)\n",
+           unsettled, runs, 100.0 * unsettled / runs);
+    printf("Worst IAE: run %ld (tau %.3f s, deadband %.2f%%, load %.2f%% at %.2f s, ripple %.2f%% @ %.2f Hz, noise %.3f%%)\n",
+           worst, p->tau, p->deadband, p->load_step, p->load_tick * STEP_PROFILE_SAMPLE_TIME,
+           p->ripple_amplitude, p->ripple_frequency, p->noise_sigma);
+    printf("\nSimulated %.0f s of closed loop in %.2f s (%.1f ns per step)\n",
+           runs * STEP_PROFILE_TOTAL_STEPS * STEP_PROFILE_SAMPLE_TIME, elapsed,
+           elapsed * 1e9 / ((double)runs * STEP_PROFILE_TOTAL_STEPS));
+    printf("Summary written to monte_carlo_summary.csv\n");
+
+    free(results);
+    free(column);
+    return 0;
+}
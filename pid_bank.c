@@ -0,0 +1,285 @@
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "pid_bank.h"
+#include "bit_select.h"
+
+#define PID_BANK_COLUMNS 21
+#define PID_BANK_ALIGN   64 // Cache line / widest SIMD register
+#define PID_BANK_STAT_COLUMNS 5
+
+// Round a channel count up so every column starts on a cache line
+static int pid_bank_stride(int capacity) {
+    int per_line = PID_BANK_ALIGN / (int)sizeof(float);
+    return ((capacity + per_line - 1) / per_line) * per_line;
+}
+
+// Allocate all columns from one aligned block
+// Channels start zeroed; use pid_bank_load() to configure them
+int pid_bank_init(PIDBank* bank, int capacity) {
+    if (capacity <= 0) return -1;
+
+    int stride = pid_bank_stride(capacity);
+    size_t bytes = (size_t)stride * PID_BANK_COLUMNS * sizeof(float);
+
+    void* storage = calloc(1, bytes + PID_BANK_ALIGN);
+    if (storage == NULL) return -1;
+
+    float* base = (float*)(((uintptr_t)storage + PID_BANK_ALIGN - 1) & ~(uintptr_t)(PID_BANK_ALIGN - 1));
+    float** columns[PID_BANK_COLUMNS] = {
+        &bank->kp, &bank->ki, &bank->kd,
+        &bank->setpoint, &bank->integral, &bank->prev_error,
+        &bank->output_min, &bank->output_max,
+        &bank->sample_time,
+        &bank->derivative_filtered, &bank->derivative_filter_coeff,
+        &bank->prev_output, &bank->max_rate_of_change,
+        &bank->setpoint_target, &bank->setpoint_ramp_rate,
+        &bank->integral_max, &bank->integral_min,
+        &bank->inv_sample_time, &bank->derivative_keep,
+        &bank->ramp_step, &bank->rate_step
+    };
+    for (int c = 0; c < PID_BANK_COLUMNS; c++) {
+        *columns[c] = base + (size_t)c * stride;
+    }
+
+#ifdef PID_INSTRUMENTATION
+    uint64_t* stats = calloc((size_t)stride * PID_BANK_STAT_COLUMNS, sizeof(uint64_t));
+    if (stats == NULL) {
+        free(storage);
+        return -1;
+    }
+    bank->stat_ticks = stats;
+    bank->stat_ramp_ticks = stats + stride;
+    bank->stat_integral_clamps = stats + (size_t)2 * stride;
+    bank->stat_rate_limits = stats + (size_t)3 * stride;
+    bank->stat_output_saturations = stats + (size_t)4 * stride;
+    bank->stats_storage = stats;
+#endif
+
+    bank->capacity = capacity;
+    bank->count = 0;
+    bank->storage = storage;
+    return 0;
+}
+
+// Release the column storage
+void pid_bank_free(PIDBank* bank) {
+    free(bank->storage);
+    bank->storage = NULL;
+#ifdef PID_INSTRUMENTATION
+    free(bank->stats_storage);
+    bank->stats_storage = NULL;
+#endif
+    bank->capacity = 0;
+    bank->count = 0;
+}
+
+// Copy configuration, coefficients and state of a scalar controller into channel index
+void pid_bank_load(PIDBank* bank, int index, const PIDController* pid) {
+    bank->kp[index] = pid->kp;
+    bank->ki[index] = pid->ki;
+    bank->kd[index] = pid->kd;
+    bank->setpoint[index] = pid->setpoint;
+    bank->integral[index] = pid->integral;
+    bank->prev_error[index] = pid->prev_error;
+    bank->output_min[index] = pid->output_min;
+    bank->output_max[index] = pid->output_max;
+    bank->sample_time[index] = pid->sample_time;
+    bank->derivative_filtered[index] = pid->derivative_filtered;
+    bank->derivative_filter_coeff[index] = pid->derivative_filter_coeff;
+    bank->prev_output[index] = pid->prev_output;
+    bank->max_rate_of_change[index] = pid->max_rate_of_change;
+    bank->setpoint_target[index] = pid->setpoint_target;
+    bank->setpoint_ramp_rate[index] = pid->setpoint_ramp_rate;
+    bank->integral_max[index] = pid->integral_max;
+    bank->integral_min[index] = pid->integral_min;
+    bank->inv_sample_time[index] = pid->inv_sample_time;
+    bank->derivative_keep[index] = pid->derivative_keep;
+    bank->ramp_step[index] = pid->ramp_step;
+    bank->rate_step[index] = pid->rate_step;
+#ifdef PID_INSTRUMENTATION
+    bank->stat_ticks[index] = 0;
+    bank->stat_ramp_ticks[index] = 0;
+    bank->stat_integral_clamps[index] = 0;
+    bank->stat_rate_limits[index] = 0;
+    bank->stat_output_saturations[index] = 0;
+#endif
+
+    if (index >= bank->count) bank->count = index + 1;
+}
+
+// Copy channel index back out into a scalar controller
+// Coefficients and kernel are rebuilt from the copied configuration
+void pid_bank_store(const PIDBank* bank, int index, PIDController* pid) {
+    pid->kp = bank->kp[index];
+    pid->ki = bank->ki[index];
+    pid->kd = bank->kd[index];
+    pid->setpoint = bank->setpoint[index];
+    pid->integral = bank->integral[index];
+    pid->prev_error = bank->prev_error[index];
+    pid->output_min = bank->output_min[index];
+    pid->output_max = bank->output_max[index];
+    pid->sample_time = bank->sample_time[index];
+    pid->derivative_filtered = bank->derivative_filtered[index];
+    pid->derivative_filter_coeff = bank->derivative_filter_coeff[index];
+    pid->prev_output = bank->prev_output[index];
+    pid->max_rate_of_change = bank->max_rate_of_change[index];
+    pid->setpoint_target = bank->setpoint_target[index];
+    pid->setpoint_ramp_rate = bank->setpoint_ramp_rate[index];
+    pid_update_coefficients(pid);
+}
+
+// Same as pid_set_setpoint() for one channel
+void pid_bank_set_setpoint(PIDBank* bank, int index, float setpoint) {
+    bank->setpoint[index] = setpoint;
+    bank->setpoint_target[index] = setpoint;
+}
+
+// Same as pid_set_setpoint_ramped() for one channel
+void pid_bank_set_setpoint_ramped(PIDBank* bank, int index, float target_setpoint) {
+    bank->setpoint_target[index] = target_setpoint;
+    if (bank->setpoint_ramp_rate[index] <= 0.0f) {
+        bank->setpoint[index] = target_setpoint;
+    }
+}
+
+// Column kernel - every pointer is a restrict parameter so the loop can be
+// vectorized without runtime alias checks
+static void pid_bank_kernel(int n,
+                            const float* restrict kp,
+                            const float* restrict ki,
+                            const float* restrict kd,
+                            float* restrict setpoint,
+                            float* restrict integral,
+                            float* restrict prev_error,
+                            const float* restrict output_min,
+                            const float* restrict output_max,
+                            const float* restrict integral_min,
+                            const float* restrict integral_max,
+                            const float* restrict sample_time,
+                            const float* restrict inv_sample_time,
+                            float* restrict derivative_filtered,
+                            const float* restrict filter_coeff,
+                            const float* restrict derivative_keep,
+                            float* restrict prev_output,
+                            const float* restrict rate_step,
+                            const float* restrict setpoint_target,
+                            const float* restrict ramp_step,
+                            const float* restrict measurements,
+                            float* restrict outputs
+#ifdef PID_INSTRUMENTATION
+                            , uint64_t* restrict stat_ticks,
+                            uint64_t* restrict stat_ramp_ticks,
+                            uint64_t* restrict stat_integral_clamps,
+                            uint64_t* restrict stat_rate_limits,
+                            uint64_t* restrict stat_output_saturations
+#endif
+                            ) {
+    for (int i = 0; i < n; i++) {
+        float dt = sample_time[i];
+
+        // Setpoint ramping (masked when ramp step is 0)
+        float sp = setpoint[i];
+        float target = setpoint_target[i];
+        float step = ramp_step[i];
+        float sp_error = target - sp;
+        float sp_ramped = bit_select(sp_error > step, sp + step, target);
+        sp_ramped = bit_select(sp_error < -step, sp - step, sp_ramped);
+        sp = bit_select(step > 0.0f, sp_ramped, sp);
+        setpoint[i] = sp;
+#ifdef PID_INSTRUMENTATION
+        stat_ticks[i]++;
+        stat_ramp_ticks[i] += (step > 0.0f) & ((sp_error > step) | (sp_error < -step));
+#endif
+
+        float error = sp - measurements[i];
+
+        // Proportional term
+        float p_term = kp[i] * error;
+
+        // Integral with anti-windup clamp
+        float integ = integral[i] + error * dt;
+#ifdef PID_INSTRUMENTATION
+        stat_integral_clamps[i] += (integ > integral_max[i]);
+#endif
+        integ = bit_select(integ > integral_max[i], integral_max[i], integ);
+#ifdef PID_INSTRUMENTATION
+        stat_integral_clamps[i] += (integ < integral_min[i]);
+#endif
+        integ = bit_select(integ < integral_min[i], integral_min[i], integ);
+        integral[i] = integ;
+        float i_term = ki[i] * integ;
+
+        // Filtered derivative
+        float derivative_raw = (error - prev_error[i]) * inv_sample_time[i];
+        float d_filt = (filter_coeff[i] * derivative_raw) + (derivative_keep[i] * derivative_filtered[i]);
+        d_filt = bit_select(fabsf(d_filt) < FLT_MIN, 0.0f, d_filt); // No subnormals (as pid_compute())
+        derivative_filtered[i] = d_filt;
+        float d_term = kd[i] * d_filt;
+
+        float output = p_term + i_term + d_term;
+
+        // Rate limiting (masked when rate step is 0)
+        float prev = prev_output[i];
+        float max_change = rate_step[i];
+        float output_change = output - prev;
+        float limited = bit_select(output_change > max_change, prev + max_change, output);
+        limited = bit_select(output_change < -max_change, prev - max_change, limited);
+        output = bit_select(max_change > 0.0f, limited, output);
+#ifdef PID_INSTRUMENTATION
+        stat_rate_limits[i] += (max_change > 0.0f) &
+                               ((output_change > max_change) | (output_change < -max_change));
+#endif
+
+        prev_output[i] = output;
+        prev_error[i] = error;
+
+        // Output clamp
+#ifdef PID_INSTRUMENTATION
+        stat_output_saturations[i] += (output > output_max[i]);
+#endif
+        output = bit_select(output > output_max[i], output_max[i], output);
+#ifdef PID_INSTRUMENTATION
+        stat_output_saturations[i] += (output < output_min[i]);
+#endif
+        output = bit_select(output < output_min[i], output_min[i], output);
+        outputs[i] = output;
+    }
+}
+
+// Step n channels at once
+// Mirrors pid_compute() operation for operation, but every feature branch is
+// a select so the loop body is straight-line code the compiler turns into
+// SIMD blends. Disabled features are masked rather than skipped.
+void pid_bank_compute(PIDBank* bank, const float* measurements, float* outputs, int n) {
+    pid_bank_kernel(n,
+                    bank->kp, bank->ki, bank->kd,
+                    bank->setpoint, bank->integral, bank->prev_error,
+                    bank->output_min, bank->output_max,
+                    bank->integral_min, bank->integral_max,
+                    bank->sample_time, bank->inv_sample_time,
+                    bank->derivative_filtered, bank->derivative_filter_coeff,
+                    bank->derivative_keep,
+                    bank->prev_output, bank->rate_step,
+                    bank->setpoint_target, bank->ramp_step,
+                    measurements, outputs
+#ifdef PID_INSTRUMENTATION
+                    , bank->stat_ticks, bank->stat_ramp_ticks,
+                    bank->stat_integral_clamps, bank->stat_rate_limits,
+                    bank->stat_output_saturations
+#endif
+                    );
+}
+
+#ifdef PID_INSTRUMENTATION
+void pid_bank_stats(const PIDBank* bank, int index, PidStatsSnapshot* snapshot) {
+    memset(snapshot, 0, sizeof(*snapshot));
+    snapshot->ticks = bank->stat_ticks[index];
+    snapshot->ramp_ticks = bank->stat_ramp_ticks[index];
+    snapshot->integral_clamps = bank->stat_integral_clamps[index];
+    snapshot->rate_limits = bank->stat_rate_limits[index];
+    snapshot->output_saturations = bank->stat_output_saturations[index];
+}
+#endif
@@ -0,0 +1,88 @@
+#ifndef PID_BANK_H
+#define PID_BANK_H
+
+#include <stdint.h>
+#include "pid_controller.h"
+
+// Structure-of-arrays bank of PID controllers
+// Each field of PIDController is stored as one contiguous column so a
+// single pid_bank_compute() call steps many channels with unit-stride,
+// vectorizable loads and stores.
+typedef struct {
+    int capacity; // Number of channels allocated
+    int count;    // Number of channels in use
+
+    // PID gains
+    float* kp;
+    float* ki;
+    float* kd;
+
+    // Control variables
+    float* setpoint;
+    float* integral;
+    float* prev_error;
+
+    // Output limits
+    float* output_min;
+    float* output_max;
+
+    // Timing
+    float* sample_time;
+
+    // Advanced features
+    float* derivative_filtered;
+    float* derivative_filter_coeff;
+    float* prev_output;
+    float* max_rate_of_change;
+
+    // Setpoint ramping
+    float* setpoint_target;
+    float* setpoint_ramp_rate;
+
+    // Precomputed coefficients (copied from the scalar controller)
+    float* integral_max;
+    float* integral_min;
+    float* inv_sample_time;
+    float* derivative_keep;
+    float* ramp_step;
+    float* rate_step;
+
+    void* storage; // Single allocation backing all columns
+
+#ifdef PID_INSTRUMENTATION
+    // Event counters per channel, same meaning as in PidStats (see
+    // pid_stats.h). Plain columns so the kernel stays vectorizable: read
+    // them on the stepping thread, or after it has been joined. The
+    // |error| and |output change| histograms are not kept per channel.
+    uint64_t* stat_ticks;
+    uint64_t* stat_ramp_ticks;
+    uint64_t* stat_integral_clamps;
+    uint64_t* stat_rate_limits;
+    uint64_t* stat_output_saturations;
+    void* stats_storage;
+#endif
+} PIDBank;
+
+// Allocate a bank for up to capacity channels (returns 0 on success, -1 on failure)
+int pid_bank_init(PIDBank* bank, int capacity);
+void pid_bank_free(PIDBank* bank);
+
+// Copy a configured scalar controller into / out of channel index
+// (with PID_INSTRUMENTATION, loading also zeroes the channel's counters)
+void pid_bank_load(PIDBank* bank, int index, const PIDController* pid);
+void pid_bank_store(const PIDBank* bank, int index, PIDController* pid);
+
+// Per-channel setpoint control (same semantics as the scalar API)
+void pid_bank_set_setpoint(PIDBank* bank, int index, float setpoint);
+void pid_bank_set_setpoint_ramped(PIDBank* bank, int index, float target_setpoint);
+
+// Step channels [0, n) - equivalent to calling pid_compute() on each channel
+void pid_bank_compute(PIDBank* bank, const float* measurements, float* outputs, int n);
+
+#ifdef PID_INSTRUMENTATION
+// Counters of channel index as a PidStats snapshot (histograms and
+// actuator_clamps are left at zero)
+void pid_bank_stats(const PIDBank* bank, int index, PidStatsSnapshot* snapshot);
+#endif
+
+#endif // PID_BANK_H
@@ -1,3 +1,5 @@
+#include <float.h>
+#include <math.h>
 #include "pid_controller.h"
 
 // Initialize PID controller with gains and output limits
@@ -23,6 +25,11 @@ void pid_init(PIDController* pid, float kp, float ki, float kd, float sample_tim
         // Initialize ramping
         pid->setpoint_target = 0.0f;
         pid->setpoint_ramp_rate = 0.0f; // Disabled by default
+
+#ifdef PID_INSTRUMENTATION
+        pid_stats_reset(&pid->stats);
+#endif
+        pid_update_coefficients(pid);
     }
 
     // Configure derivative filtering
@@ -33,6 +40,7 @@ void pid_set_derivative_filter(PIDController* pid, float filter_coeff)
         if (filter_coeff < 0.0f) filter_coeff = 0.0f;
         if (filter_coeff > 1.0f) filter_coeff = 1.0f;
         pid->derivative_filter_coeff = filter_coeff;
+        pid_update_coefficients(pid);
     }
 
 // Configure output rate limiting
@@ -40,24 +48,31 @@ void pid_set_derivative_filter(PIDController* pid, float filter_coeff)
 void pid_set_rate_limit(PIDController* pid, float max_rate) 
     {
         pid->max_rate_of_change = max_rate;
+        pid_update_coefficients(pid);
     }
 
-// Calculate PID control output based on setpoint and current measurement
-float pid_compute(PIDController* pid, float measurement) 
+// Shared body of the compute kernels
+// The feature flags are compile-time constants in each instantiation below,
+// so every specialized kernel is straight-line code for its feature set:
+// no per-step divides and no tests of ramp/rate/filter configuration.
+static inline float pid_compute_kernel(PIDController* pid, float measurement,
+                                       const int ramp, const int filter, const int rate)
     {
-        if (pid->setpoint_ramp_rate > 0.0f) 
+        if (ramp) 
             {
                 // Apply setpoint ramping
-                float max_change = pid->setpoint_ramp_rate * pid->sample_time;
+                float max_change = pid->ramp_step;
                 float setpoint_error = pid->setpoint_target - pid->setpoint;
 
                 if (setpoint_error > max_change) 
                     {
                         pid->setpoint += max_change;
+                        PID_STAT_INC(pid, ramp_ticks);
                     } 
                 else if (setpoint_error < -max_change) 
                     {
                         pid->setpoint -= max_change;
+                        PID_STAT_INC(pid, ramp_ticks);
                     } 
                 else 
                     {
@@ -73,19 +88,41 @@ float pid_compute(PIDController* pid, float measurement)
         pid->integral += error * pid->sample_time;
 
         // Anti-windup: Clamp integral term to prevent excessive accumulation
-        float max_integral = pid->output_max / pid->ki;  // Prevent integral alone from saturating
-        float min_integral = pid->output_min / pid->ki;
-        if (pid->integral > max_integral) pid->integral = max_integral;
-        if (pid->integral < min_integral) pid->integral = min_integral;
+        // (limits are output_max / ki and output_min / ki, precomputed)
+        if (pid->integral > pid->integral_max) 
+            {
+                pid->integral = pid->integral_max;
+                PID_STAT_INC(pid, integral_clamps);
+            }
+        if (pid->integral < pid->integral_min) 
+            {
+                pid->integral = pid->integral_min;
+                PID_STAT_INC(pid, integral_clamps);
+            }
 
         float i_term = pid->ki * pid->integral;
 
         // Calculate derivative
-        float derivative_raw = (error - pid->prev_error) / pid->sample_time;
+        float derivative_raw = (error - pid->prev_error) * pid->inv_sample_time;
 
-        // Apply low-pass filter to derivative
-        pid->derivative_filtered = (pid->derivative_filter_coeff * derivative_raw) +
-                                   ((1.0f - pid->derivative_filter_coeff) * pid->derivative_filtered);
+        // Apply low-pass filter to derivative (coefficient 1 = unfiltered)
+        if (filter) 
+            {
+                pid->derivative_filtered = (pid->derivative_filter_coeff * derivative_raw) +
+                                           (pid->derivative_keep * pid->derivative_filtered);
+            }
+        else 
+            {
+                pid->derivative_filtered = derivative_raw;
+            }
+
+        // Once the error stops changing the filter decays towards zero
+        // forever; flush it before it goes subnormal, where every operation
+        // on it is slow. Unfiltered too, so the result matches pid_bank.
+        if (fabsf(pid->derivative_filtered) < FLT_MIN)
+            {
+                pid->derivative_filtered = 0.0f;
+            }
 
         float d_term = pid->kd * pid->derivative_filtered;
 
@@ -93,19 +130,21 @@ float pid_compute(PIDController* pid, float measurement)
         float output = p_term + i_term + d_term;
 
         // Apply rate limiting if enabled
-        if (pid->max_rate_of_change > 0.0f) 
+        if (rate) 
             {
-                float max_change = pid->max_rate_of_change * pid->sample_time;
+                float max_change = pid->rate_step;
                 float output_change = output - pid->prev_output;
 
                 if (output_change > max_change) 
                     {
                         output = pid->prev_output + max_change;
+                        PID_STAT_INC(pid, rate_limits);
                     } 
                 else if (output_change < -max_change) 
                     {
                         output = pid->prev_output - max_change;
-                        }
+                        PID_STAT_INC(pid, rate_limits);
+                    }
             }
 
         // Store current output for next iteration
@@ -115,12 +154,104 @@ float pid_compute(PIDController* pid, float measurement)
         pid->prev_error = error;
 
         // Clamp output to limits
-        if (output > pid->output_max) output = pid->output_max;
-        if (output < pid->output_min) output = pid->output_min;
+        if (output > pid->output_max) 
+            {
+                output = pid->output_max;
+                PID_STAT_INC(pid, output_saturations);
+            }
+        if (output < pid->output_min) 
+            {
+                output = pid->output_min;
+                PID_STAT_INC(pid, output_saturations);
+            }
 
+        // Instrumentation only: compiles to nothing without PID_INSTRUMENTATION
+        PID_STAT_TICK(pid, error, output);
         return output;
     }
 
+// One kernel per feature combination: ramp (R), derivative filter (F), rate limit (L)
+#define PID_KERNEL(name, ramp, filter, rate) \
+    static float name(PIDController* pid, float measurement) \
+        { \
+            return pid_compute_kernel(pid, measurement, ramp, filter, rate); \
+        }
+
+PID_KERNEL(pid_kernel_plain, 0, 0, 0)
+PID_KERNEL(pid_kernel_l,     0, 0, 1)
+PID_KERNEL(pid_kernel_f,     0, 1, 0)
+PID_KERNEL(pid_kernel_fl,    0, 1, 1)
+PID_KERNEL(pid_kernel_r,     1, 0, 0)
+PID_KERNEL(pid_kernel_rl,    1, 0, 1)
+PID_KERNEL(pid_kernel_rf,    1, 1, 0)
+PID_KERNEL(pid_kernel_rfl,   1, 1, 1)
+
+#undef PID_KERNEL
+
+// Rebuild the precomputed coefficient block and select the matching kernel
+// Called by every setter, so pid_compute() never divides or re-checks config
+void pid_update_coefficients(PIDController* pid) 
+    {
+        static float (*const kernels[8])(PIDController*, float) = {
+            pid_kernel_plain, pid_kernel_l, pid_kernel_f, pid_kernel_fl,
+            pid_kernel_r,     pid_kernel_rl, pid_kernel_rf, pid_kernel_rfl
+        };
+
+        // ki = 0 disables the integral: hold it at zero instead of dividing by zero
+        if (pid->ki != 0.0f) 
+            {
+                pid->integral_max = pid->output_max / pid->ki;
+                pid->integral_min = pid->output_min / pid->ki;
+            }
+        else 
+            {
+                pid->integral_max = 0.0f;
+                pid->integral_min = 0.0f;
+            }
+
+        pid->inv_sample_time = 1.0f / pid->sample_time;
+        pid->derivative_keep = 1.0f - pid->derivative_filter_coeff;
+        pid->ramp_step = (pid->setpoint_ramp_rate > 0.0f) ? pid->setpoint_ramp_rate * pid->sample_time : 0.0f;
+        pid->rate_step = (pid->max_rate_of_change > 0.0f) ? pid->max_rate_of_change * pid->sample_time : 0.0f;
+
+        int ramp = pid->ramp_step > 0.0f;
+        int filter = pid->derivative_filter_coeff < 1.0f;
+        int rate = pid->rate_step > 0.0f;
+        pid->kernel = kernels[(ramp << 2) | (filter << 1) | rate];
+    }
+
+// Calculate PID control output based on setpoint and current measurement
+// Dispatches to the kernel selected by the last configuration change
+float pid_compute(PIDController* pid, float measurement) 
+    {
+        return pid->kernel(pid, measurement);
+    }
+
+// Change PID gains without resetting controller state
+void pid_set_gains(PIDController* pid, float kp, float ki, float kd) 
+    {
+        pid->kp = kp;
+        pid->ki = ki;
+        pid->kd = kd;
+        pid_update_coefficients(pid);
+    }
+
+// Change PID gains without a bump in the output
+// The integral is rescaled so the integral term ki * integral is unchanged;
+// with ki = 0 it is cleared (the integral is held at zero then anyway)
+void pid_set_gains_bumpless(PIDController* pid, float kp, float ki, float kd) 
+    {
+        if (ki != 0.0f) 
+            {
+                pid->integral *= pid->ki / ki;
+            }
+        else 
+            {
+                pid->integral = 0.0f;
+            }
+        pid_set_gains(pid, kp, ki, kd);
+    }
+
 //Update PID setpoint to new target value
 void pid_set_setpoint(PIDController* pid, float setpoint) 
     {
@@ -134,6 +265,7 @@ void pid_set_setpoint(PIDController* pid, float setpoint)
 void pid_set_ramp_rate(PIDController* pid, float ramp_rate) 
     {
         pid->setpoint_ramp_rate = ramp_rate;
+        pid_update_coefficients(pid);
     }
 
 // Set target setpoint with ramping
@@ -2,7 +2,9 @@
 #ifndef PID_CONTROLLER_H
 #define PID_CONTROLLER_H
 
-typedef struct {
+#include "pid_stats.h"
+
+typedef struct PIDController {
     //PID gains
     float kp; // Proportional gain
     float ki; // Integral gain
@@ -29,12 +31,32 @@ typedef struct {
     // Setpoint ramping
     float setpoint_target;   // Target setpoint (where we want to go)
     float setpoint_ramp_rate; // Ramp rate (%/second, 0 =  instant/disabled)
+
+    // Precomputed coefficients (rebuilt by pid_init() and the pid_set_* functions)
+    float integral_max;     // output_max / ki (anti-windup limit, 0 when ki = 0)
+    float integral_min;     // output_min / ki
+    float inv_sample_time;  // 1 / sample_time
+    float derivative_keep;  // 1 - derivative_filter_coeff
+    float ramp_step;        // setpoint_ramp_rate * sample_time (0 = disabled)
+    float rate_step;        // max_rate_of_change * sample_time (0 = disabled)
+
+    // Compute kernel specialized for the enabled features
+    float (*kernel)(struct PIDController* pid, float measurement);
+
+#ifdef PID_INSTRUMENTATION
+    PidStats stats; // Hot-path counters (see pid_stats.h)
+#endif
 } PIDController;
 
 // Function prototypes
 void pid_init(PIDController* pid, float kp, float ki, float kd, float sample_time);
 float pid_compute(PIDController* pid, float measurement);
 void pid_set_setpoint(PIDController* pid, float setpoint);
+void pid_set_gains(PIDController* pid, float kp, float ki, float kd);
+void pid_set_gains_bumpless(PIDController* pid, float kp, float ki, float kd);
+
+// Rebuild precomputed coefficients after writing configuration fields directly
+void pid_update_coefficients(PIDController* pid);
 
 //Advanced configuration
 void pid_set_derivative_filter(PIDController* pid, float filter_coeff);
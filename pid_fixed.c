@@ -0,0 +1,119 @@
+#include "pid_fixed.h"
+
+// Rebuild the Q16 coefficient block from the float configuration
+// All divides happen here, once per configuration change
+static void pid_q16_update_coefficients(PIDControllerQ16* pid) {
+    pid->c_kp = Q16_FROM_FLOAT(pid->kp);
+    pid->c_ki_dt = Q16_FROM_FLOAT(pid->ki * pid->sample_time);
+    pid->c_d_gain = Q16_FROM_FLOAT(pid->kd * pid->derivative_filter_coeff / pid->sample_time);
+    pid->c_d_keep = Q16_FROM_FLOAT(1.0f - pid->derivative_filter_coeff);
+    pid->c_rate_step = (pid->max_rate_of_change > 0.0f)
+                           ? Q16_FROM_FLOAT(pid->max_rate_of_change * pid->sample_time) : 0;
+    pid->c_ramp_step = (pid->setpoint_ramp_rate > 0.0f)
+                           ? Q16_FROM_FLOAT(pid->setpoint_ramp_rate * pid->sample_time) : 0;
+}
+
+// Initialize fixed-point PID controller with gains and default limits
+// Same defaults as pid_init(): +/-100% output, filter 0.1, rate limit and ramping off
+void pid_q16_init(PIDControllerQ16* pid, float kp, float ki, float kd, float sample_time) {
+    pid->kp = kp;
+    pid->ki = ki;
+    pid->kd = kd;
+    pid->sample_time = sample_time;
+    pid->derivative_filter_coeff = 0.1f;
+    pid->max_rate_of_change = 0.0f;
+    pid->setpoint_ramp_rate = 0.0f;
+
+    pid->output_min = -100 * Q16_ONE;
+    pid->output_max = 100 * Q16_ONE;
+
+    pid->setpoint = 0;
+    pid->setpoint_target = 0;
+    pid->i_term = 0;
+    pid->d_term = 0;
+    pid->prev_error = 0;
+    pid->prev_output = 0;
+
+    pid_q16_update_coefficients(pid);
+}
+
+// Configure derivative filtering (0 = no filtering; 1 = max filtering)
+void pid_q16_set_derivative_filter(PIDControllerQ16* pid, float filter_coeff) {
+    if (filter_coeff < 0.0f) filter_coeff = 0.0f;
+    if (filter_coeff > 1.0f) filter_coeff = 1.0f;
+    pid->derivative_filter_coeff = filter_coeff;
+    pid_q16_update_coefficients(pid);
+}
+
+// Configure output rate limiting (%/second, 0 = disabled)
+void pid_q16_set_rate_limit(PIDControllerQ16* pid, float max_rate) {
+    pid->max_rate_of_change = max_rate;
+    pid_q16_update_coefficients(pid);
+}
+
+// Configure setpoint ramp rate (%/second, 0 = instant/disabled)
+void pid_q16_set_ramp_rate(PIDControllerQ16* pid, float ramp_rate) {
+    pid->setpoint_ramp_rate = ramp_rate;
+    pid_q16_update_coefficients(pid);
+}
+
+// Update setpoint immediately
+void pid_q16_set_setpoint(PIDControllerQ16* pid, q16_t setpoint) {
+    pid->setpoint = setpoint;
+    pid->setpoint_target = setpoint;
+}
+
+// Set target setpoint with ramping (jumps if ramping is disabled)
+void pid_q16_set_setpoint_ramped(PIDControllerQ16* pid, q16_t target_setpoint) {
+    pid->setpoint_target = target_setpoint;
+    if (pid->c_ramp_step <= 0) {
+        pid->setpoint = target_setpoint;
+    }
+}
+
+// Calculate PID output in Q16
+// The integral and derivative are stored pre-multiplied by ki and kd, so the
+// anti-windup limit is simply the output range (no output_max / ki divide)
+// and the derivative needs no divide by sample_time.
+q16_t pid_q16_compute(PIDControllerQ16* pid, q16_t measurement) {
+    if (pid->c_ramp_step > 0) {
+        q16_t setpoint_error = q16_sub(pid->setpoint_target, pid->setpoint);
+        if (setpoint_error > pid->c_ramp_step) {
+            pid->setpoint = q16_add(pid->setpoint, pid->c_ramp_step);
+        } else if (setpoint_error < -pid->c_ramp_step) {
+            pid->setpoint = q16_sub(pid->setpoint, pid->c_ramp_step);
+        } else {
+            pid->setpoint = pid->setpoint_target;
+        }
+    }
+
+    q16_t error = q16_sub(pid->setpoint, measurement);
+
+    // Proportional term
+    q16_t p_term = q16_mul(pid->c_kp, error);
+
+    // Integral term with anti-windup clamp
+    pid->i_term = q16_clamp(q16_add(pid->i_term, q16_mul(pid->c_ki_dt, error)),
+                            pid->output_min, pid->output_max);
+
+    // Filtered derivative term
+    pid->d_term = q16_add(q16_mul(pid->c_d_gain, q16_sub(error, pid->prev_error)),
+                          q16_mul(pid->c_d_keep, pid->d_term));
+
+    q16_t output = q16_add(q16_add(p_term, pid->i_term), pid->d_term);
+
+    // Rate limiting
+    if (pid->c_rate_step > 0) {
+        q16_t output_change = q16_sub(output, pid->prev_output);
+        if (output_change > pid->c_rate_step) {
+            output = q16_add(pid->prev_output, pid->c_rate_step);
+        } else if (output_change < -pid->c_rate_step) {
+            output = q16_sub(pid->prev_output, pid->c_rate_step);
+        }
+    }
+
+    pid->prev_output = output;
+    pid->prev_error = error;
+
+    return q16_clamp(output, pid->output_min, pid->output_max);
+}
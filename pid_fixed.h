@@ -0,0 +1,56 @@
+#ifndef PID_FIXED_H
+#define PID_FIXED_H
+
+#include "fixed_point.h"
+
+// Fixed-point (Q16.16) PID controller for targets without an FPU
+// Same feature set as PIDController. Configuration is kept in float and
+// turned into Q16 coefficients by the setters, so pid_q16_compute() runs on
+// integer adds, multiplies and shifts only - no divides.
+// A coefficient beyond +/-32768 (e.g. kd * filter / sample_time with a very
+// short sample time) saturates; such gains cannot be represented.
+typedef struct {
+    // Configuration (float, only touched by init/setters)
+    float kp;
+    float ki;
+    float kd;
+    float sample_time;
+    float derivative_filter_coeff;
+    float max_rate_of_change;
+    float setpoint_ramp_rate;
+
+    // Precomputed Q16 coefficients
+    q16_t c_kp;          // kp
+    q16_t c_ki_dt;       // ki * sample_time
+    q16_t c_d_gain;      // kd * filter_coeff / sample_time
+    q16_t c_d_keep;      // 1 - filter_coeff
+    q16_t c_rate_step;   // max_rate_of_change * sample_time (0 = disabled)
+    q16_t c_ramp_step;   // setpoint_ramp_rate * sample_time (0 = disabled)
+
+    // Output limits
+    q16_t output_min;
+    q16_t output_max;
+
+    // State
+    q16_t setpoint;
+    q16_t setpoint_target;
+    q16_t i_term;        // ki * integral, clamped to the output limits (anti-windup)
+    q16_t d_term;        // kd * filtered derivative
+    q16_t prev_error;
+    q16_t prev_output;
+} PIDControllerQ16;
+
+// Function prototypes (mirror pid_controller.h)
+void pid_q16_init(PIDControllerQ16* pid, float kp, float ki, float kd, float sample_time);
+q16_t pid_q16_compute(PIDControllerQ16* pid, q16_t measurement);
+void pid_q16_set_setpoint(PIDControllerQ16* pid, q16_t setpoint);
+
+// Advanced configuration
+void pid_q16_set_derivative_filter(PIDControllerQ16* pid, float filter_coeff);
+void pid_q16_set_rate_limit(PIDControllerQ16* pid, float max_rate);
+
+// Setpoint ramping
+void pid_q16_set_setpoint_ramped(PIDControllerQ16* pid, q16_t target_setpoint);
+void pid_q16_set_ramp_rate(PIDControllerQ16* pid, float ramp_rate);
+
+#endif // PID_FIXED_H
@@ -0,0 +1,78 @@
+#include <math.h>
+#include <string.h>
+#include "pid_params.h"
+
+void pid_params_get(const PIDController* pid, PidParams* params) {
+    params->kp = pid->kp;
+    params->ki = pid->ki;
+    params->kd = pid->kd;
+    params->derivative_filter_coeff = pid->derivative_filter_coeff;
+    params->max_rate_of_change = pid->max_rate_of_change;
+    params->setpoint_ramp_rate = pid->setpoint_ramp_rate;
+}
+
+// Clamp to [lo, hi]; NaN becomes lo
+static float clamp_param(float value, float lo, float hi) {
+    if (!(value >= lo)) return lo;
+    return value > hi ? hi : value;
+}
+
+void pid_params_apply(PIDController* pid, const PidParams* params) {
+    // Same rescale as pid_set_gains_bumpless(): ki * integral is kept
+    if (params->ki != 0.0f) {
+        pid->integral *= pid->ki / params->ki;
+    } else {
+        pid->integral = 0.0f;
+    }
+    pid->kp = params->kp;
+    pid->ki = params->ki;
+    pid->kd = params->kd;
+    // Same limits as the setters: filter in [0, 1], rates >= 0 (0 = off)
+    pid->derivative_filter_coeff = clamp_param(params->derivative_filter_coeff, 0.0f, 1.0f);
+    pid->max_rate_of_change = clamp_param(params->max_rate_of_change, 0.0f, INFINITY);
+    pid->setpoint_ramp_rate = clamp_param(params->setpoint_ramp_rate, 0.0f, INFINITY);
+    pid_update_coefficients(pid); // Once for all fields
+}
+
+void pid_params_exchange_init(PidParamsExchange* exchange, const PIDController* pid) {
+    memset(exchange, 0, sizeof(PidParamsExchange));
+    pid_params_get(pid, &exchange->slots[0].params);
+    exchange->slots[1].params = exchange->slots[0].params;
+    atomic_store_explicit(&exchange->slots[0].sequence, 0, memory_order_relaxed);
+    atomic_store_explicit(&exchange->slots[1].sequence, 0, memory_order_relaxed);
+    atomic_store_explicit(&exchange->version, 0, memory_order_release);
+}
+
+void pid_params_publish(PidParamsExchange* exchange, const PidParams* params) {
+    uint32_t version = atomic_load_explicit(&exchange->version, memory_order_relaxed) + 1;
+    PidParamsSlot* slot = &exchange->slots[version & 1];
+
+    // Mark the slot busy before touching it, and done after
+    uint32_t sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+    atomic_store_explicit(&slot->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot->params = *params;
+    atomic_store_explicit(&slot->sequence, sequence + 2, memory_order_release);
+
+    atomic_store_explicit(&exchange->version, version, memory_order_release);
+}
+
+int pid_params_poll(PidParamsExchange* exchange, PIDController* pid) {
+    uint32_t version = atomic_load_explicit(&exchange->version, memory_order_acquire);
+    if (version == exchange->applied_version) return 0;
+
+    const PidParamsSlot* slot = &exchange->slots[version & 1];
+    uint32_t before = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+    PidParams params = slot->params;
+    atomic_thread_fence(memory_order_acquire);
+    uint32_t after = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+    if ((before & 1) || before != after) {
+        exchange->torn++; // Overwritten while copying: try again next tick
+        return 0;
+    }
+
+    pid_params_apply(pid, &params);
+    exchange->applied_version = version;
+    exchange->applied++;
+    return 1;
+}
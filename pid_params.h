@@ -0,0 +1,72 @@
+#ifndef PID_PARAMS_H
+#define PID_PARAMS_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include "pid_controller.h"
+
+// Live retuning of a running controller from another thread
+// A supervisory thread publishes a complete parameter block; the control
+// thread picks it up at a tick boundary with pid_params_poll(), right
+// before pid_compute(). Nothing is ever written into the PIDController from
+// outside the control thread, so a change never lands halfway through a
+// pid_compute() and the gains, filter, rate limit and ramp rate always
+// switch together.
+//
+// The block is double-buffered: the writer fills the slot the reader is not
+// directed to, then publishes it by bumping the version. Each slot also has
+// a sequence number (odd while being written) so the reader can tell when
+// two quick publishes overwrote the slot it was copying. The reader never
+// waits or retries in a loop: a torn copy is dropped and taken again on the
+// next tick. When nothing changed a poll is one atomic load.
+//
+// One writer at a time: several supervisory threads must serialize their
+// publishes among themselves (the control thread is never involved).
+
+#define PID_PARAMS_CACHE_LINE 64
+
+// Everything a supervisor may retune
+typedef struct {
+    float kp;
+    float ki;
+    float kd;
+    float derivative_filter_coeff; // 0-1 (1 = no filtering)
+    float max_rate_of_change;      // %/s (0 = disabled)
+    float setpoint_ramp_rate;      // %/s (0 = disabled)
+} PidParams;
+
+typedef struct {
+    _Atomic uint32_t sequence; // Odd while the writer fills the slot
+    PidParams params;
+} PidParamsSlot;
+
+typedef struct {
+    _Alignas(PID_PARAMS_CACHE_LINE) _Atomic uint32_t version; // Publishes so far; slot = version & 1
+    PidParamsSlot slots[2];
+
+    // Control thread only, kept off the writer's cache line
+    _Alignas(PID_PARAMS_CACHE_LINE) uint32_t applied_version;
+    uint64_t applied; // Parameter sets taken over
+    uint64_t torn;    // Copies dropped because the writer overtook them
+} PidParamsExchange;
+
+// Current configuration of pid
+void pid_params_get(const PIDController* pid, PidParams* params);
+
+// Apply params at once; the integral is rescaled when ki changes so the
+// output does not jump (as pid_set_gains_bumpless())
+// The filter coefficient is clamped to [0, 1] as pid_set_derivative_filter()
+// does, and negative rate limit / ramp rate become 0 (disabled)
+void pid_params_apply(PIDController* pid, const PidParams* params);
+
+// Start with pid's current configuration as version 0 (nothing to apply)
+void pid_params_exchange_init(PidParamsExchange* exchange, const PIDController* pid);
+
+// Supervisory thread: publish a new parameter set (never blocks)
+void pid_params_publish(PidParamsExchange* exchange, const PidParams* params);
+
+// Control thread, at a tick boundary: apply the latest published set if it
+// is new; returns 1 if parameters changed, 0 otherwise
+int pid_params_poll(PidParamsExchange* exchange, PIDController* pid);
+
+#endif // PID_PARAMS_H
@@ -0,0 +1,97 @@
+#include <math.h>
+#include "pid_stats.h"
+
+void pid_stats_reset(PidStats* stats) {
+    atomic_store_explicit(&stats->ticks, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->integral_clamps, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->rate_limits, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->output_saturations, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->actuator_clamps, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->ramp_ticks, 0, memory_order_relaxed);
+    for (int b = 0; b < PID_STAT_BUCKETS; b++) {
+        atomic_store_explicit(&stats->error_hist[b], 0, memory_order_relaxed);
+        atomic_store_explicit(&stats->delta_hist[b], 0, memory_order_relaxed);
+    }
+    stats->last_output = 0.0f;
+}
+
+void pid_stats_snapshot(const PidStats* stats, PidStatsSnapshot* snapshot) {
+    // The loads only read: casting away const is fine for C11 atomics
+    PidStats* s = (PidStats*)stats;
+    snapshot->ticks = atomic_load_explicit(&s->ticks, memory_order_relaxed);
+    snapshot->integral_clamps = atomic_load_explicit(&s->integral_clamps, memory_order_relaxed);
+    snapshot->rate_limits = atomic_load_explicit(&s->rate_limits, memory_order_relaxed);
+    snapshot->output_saturations = atomic_load_explicit(&s->output_saturations, memory_order_relaxed);
+    snapshot->actuator_clamps = atomic_load_explicit(&s->actuator_clamps, memory_order_relaxed);
+    snapshot->ramp_ticks = atomic_load_explicit(&s->ramp_ticks, memory_order_relaxed);
+    for (int b = 0; b < PID_STAT_BUCKETS; b++) {
+        snapshot->error_hist[b] = atomic_load_explicit(&s->error_hist[b], memory_order_relaxed);
+        snapshot->delta_hist[b] = atomic_load_explicit(&s->delta_hist[b], memory_order_relaxed);
+    }
+}
+
+void pid_stats_accumulate(PidStatsSnapshot* a, const PidStatsSnapshot* b) {
+    a->ticks += b->ticks;
+    a->integral_clamps += b->integral_clamps;
+    a->rate_limits += b->rate_limits;
+    a->output_saturations += b->output_saturations;
+    a->actuator_clamps += b->actuator_clamps;
+    a->ramp_ticks += b->ramp_ticks;
+    for (int k = 0; k < PID_STAT_BUCKETS; k++) {
+        a->error_hist[k] += b->error_hist[k];
+        a->delta_hist[k] += b->delta_hist[k];
+    }
+}
+
+float pid_stats_bucket_floor(int bucket) {
+    return (bucket == 0) ? 0.0f : ldexpf(1.0f, bucket - 11);
+}
+
+float pid_stats_quantile(const uint64_t* hist, double q) {
+    uint64_t total = 0;
+    for (int b = 0; b < PID_STAT_BUCKETS; b++) total += hist[b];
+    if (total == 0) return 0.0f;
+
+    uint64_t seen = 0;
+    for (int b = 0; b < PID_STAT_BUCKETS; b++) {
+        seen += hist[b];
+        if ((double)seen >= q * (double)total) return pid_stats_bucket_floor(b);
+    }
+    return pid_stats_bucket_floor(PID_STAT_BUCKETS - 1);
+}
+
+static double pid_stats_share(uint64_t count, uint64_t ticks) {
+    return ticks > 0 ? 100.0 * (double)count / (double)ticks : 0.0;
+}
+
+static void pid_stats_print_hist(const uint64_t* hist, const char* name, FILE* out) {
+    fprintf(out, "  %s: p50 >= %.3g%%  p99 >= %.3g%%\n", name,
+            pid_stats_quantile(hist, 0.50), pid_stats_quantile(hist, 0.99));
+    for (int b = 0; b < PID_STAT_BUCKETS; b++) {
+        if (hist[b] == 0) continue;
+        if (b == PID_STAT_BUCKETS - 1) {
+            fprintf(out, "    %9.4f -            %llu\n", pid_stats_bucket_floor(b), (unsigned long long)hist[b]);
+        } else {
+            fprintf(out, "    %9.4f - %-9.4f  %llu\n", pid_stats_bucket_floor(b),
+                    pid_stats_bucket_floor(b + 1), (unsigned long long)hist[b]);
+        }
+    }
+}
+
+void pid_stats_print(const PidStatsSnapshot* snapshot, const char* name, FILE* out) {
+    uint64_t ticks = snapshot->ticks;
+    fprintf(out, "%s (%llu ticks)\n", name, (unsigned long long)ticks);
+    fprintf(out, "  Integral clamp hits:  %-8llu (%.1f%%)\n",
+            (unsigned long long)snapshot->integral_clamps, pid_stats_share(snapshot->integral_clamps, ticks));
+    fprintf(out, "  Rate limit active:    %-8llu (%.1f%%)\n",
+            (unsigned long long)snapshot->rate_limits, pid_stats_share(snapshot->rate_limits, ticks));
+    fprintf(out, "  Output saturated:     %-8llu (%.1f%%)\n",
+            (unsigned long long)snapshot->output_saturations, pid_stats_share(snapshot->output_saturations, ticks));
+    fprintf(out, "  Actuator clamped:     %-8llu (%.1f%%)\n",
+            (unsigned long long)snapshot->actuator_clamps, pid_stats_share(snapshot->actuator_clamps, ticks));
+    fprintf(out, "  Setpoint ramping:     %-8llu (%.1f%%)\n",
+            (unsigned long long)snapshot->ramp_ticks, pid_stats_share(snapshot->ramp_ticks, ticks));
+    if (ticks == 0) return;
+    pid_stats_print_hist(snapshot->error_hist, "|error| (%)", out);
+    pid_stats_print_hist(snapshot->delta_hist, "|output change| (%)", out);
+}
@@ -0,0 +1,101 @@
+#ifndef PID_STATS_H
+#define PID_STATS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+
+// Hot-path instrumentation of PID internals
+// Built only with -DPID_INSTRUMENTATION: each PIDController then carries a
+// PidStats block that pid_compute() updates, and the PID_STAT_* hooks below
+// expand to nothing otherwise. Every object linked into one program must be
+// compiled with the same setting, since the flag changes PIDController.
+//
+// One thread (the control loop) writes a controller's stats. Counters are
+// relaxed atomics written with a plain load + store - no locked
+// read-modify-write - so any other thread can take a snapshot at any time
+// without locking. Each value in a snapshot is exact for some moment, but
+// the values are not taken at the same instant.
+//
+// PIDBank keeps the event counters (not the histograms) as plain per-channel
+// columns; see pid_bank_stats() in pid_bank.h.
+
+// Log2 histogram of magnitudes in %
+// Bucket 0 holds |x| < 2^-10, bucket k holds [2^(k-11), 2^(k-10)),
+// the last bucket everything from 2^(PID_STAT_BUCKETS-11) up
+#define PID_STAT_BUCKETS 20
+
+typedef struct {
+    _Atomic uint64_t ticks;              // pid_compute() calls
+    _Atomic uint64_t integral_clamps;    // Anti-windup limit hit
+    _Atomic uint64_t rate_limits;        // Output change cut by the rate limit
+    _Atomic uint64_t output_saturations; // Output clamped to output_min/output_max
+    _Atomic uint64_t actuator_clamps;    // Command clamped again by the caller (e.g. to 0-100%)
+    _Atomic uint64_t ramp_ticks;         // Setpoint still ramping towards its target
+    _Atomic uint64_t error_hist[PID_STAT_BUCKETS];  // |error|
+    _Atomic uint64_t delta_hist[PID_STAT_BUCKETS];  // |output change| per tick
+    float last_output; // Writer only: previous returned output
+} PidStats;
+
+// Plain copy of a PidStats block
+typedef struct {
+    uint64_t ticks;
+    uint64_t integral_clamps;
+    uint64_t rate_limits;
+    uint64_t output_saturations;
+    uint64_t actuator_clamps;
+    uint64_t ramp_ticks;
+    uint64_t error_hist[PID_STAT_BUCKETS];
+    uint64_t delta_hist[PID_STAT_BUCKETS];
+} PidStatsSnapshot;
+
+void pid_stats_reset(PidStats* stats);
+
+// Copy all counters (safe while the writer is running)
+void pid_stats_snapshot(const PidStats* stats, PidStatsSnapshot* snapshot);
+
+// Add b's counters to a, e.g. to total a fleet of controllers
+void pid_stats_accumulate(PidStatsSnapshot* a, const PidStatsSnapshot* b);
+
+// Lower bound (in %) of histogram bucket k
+float pid_stats_bucket_floor(int bucket);
+
+// Lower bound of the bucket holding quantile q of a histogram (0 when empty)
+float pid_stats_quantile(const uint64_t* hist, double q);
+
+void pid_stats_print(const PidStatsSnapshot* snapshot, const char* name, FILE* out);
+
+// Single-writer increment: no lock prefix on the hot path
+static inline void pid_stat_inc(_Atomic uint64_t* counter) {
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+}
+
+// Histogram bucket of |x| straight from the float exponent bits
+static inline int pid_stat_bucket(float x) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof bits);
+    int bucket = (int)((bits >> 23) & 0xff) - 116;
+    if (bucket < 0) bucket = 0;
+    if (bucket >= PID_STAT_BUCKETS) bucket = PID_STAT_BUCKETS - 1;
+    return bucket;
+}
+
+// Per-tick distributions, called with the value pid_compute() returns
+static inline void pid_stats_tick(PidStats* stats, float error, float output) {
+    pid_stat_inc(&stats->ticks);
+    pid_stat_inc(&stats->error_hist[pid_stat_bucket(error)]);
+    pid_stat_inc(&stats->delta_hist[pid_stat_bucket(output - stats->last_output)]);
+    stats->last_output = output;
+}
+
+#ifdef PID_INSTRUMENTATION
+#define PID_STAT_INC(pid, counter)         pid_stat_inc(&(pid)->stats.counter)
+#define PID_STAT_TICK(pid, error, output)  pid_stats_tick(&(pid)->stats, (error), (output))
+#else
+#define PID_STAT_INC(pid, counter)         ((void)0)
+#define PID_STAT_TICK(pid, error, output)  ((void)0)
+#endif
+
+#endif // PID_STATS_H
@@ -0,0 +1,31 @@
+#ifndef PLANT_H
+#define PLANT_H
+
+#include "valve_simulator.h"
+
+// Generic plant interface
+// Anything that takes a command and reports a position can be driven by the
+// tools that do not care what is behind it (auto-tuning, scenario runs):
+// the simulated valve, a richer model or a driver for real hardware.
+typedef struct {
+    void* state;                                       // Plant instance
+    void (*update)(void* state, float command, float dt); // Apply command for one step
+    float (*get_position)(void* state);                // Current measured position (%)
+} PlantInterface;
+
+static inline void plant_valve_update(void* state, float command, float dt) {
+    valve_update((ValveSimulator*)state, command, dt);
+}
+
+static inline float plant_valve_get_position(void* state) {
+    return valve_get_position((ValveSimulator*)state);
+}
+
+// Expose a ValveSimulator through the plant interface
+static inline void plant_from_valve(PlantInterface* plant, ValveSimulator* valve) {
+    plant->state = valve;
+    plant->update = plant_valve_update;
+    plant->get_position = plant_valve_get_position;
+}
+
+#endif // PLANT_H
@@ -0,0 +1,232 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "plant_bank.h"
+#include "bit_select.h"
+
+#define PLANT_BANK_COLUMNS 14
+#define PLANT_BANK_ALIGN   64 // Cache line / widest SIMD register
+#define PLANT_BANK_REST_VELOCITY 1e-6f // %/s below which the spool is at rest
+
+void plant_params_default(PlantParams* params) {
+    memset(params, 0, sizeof(*params));
+    params->model = PLANT_FIRST_ORDER;
+    params->time_constant = 0.2f;
+    params->natural_frequency = 0.0f;
+    params->damping = 1.0f;
+}
+
+// Round a channel count up so every column starts on a cache line
+static int plant_bank_stride(int capacity) {
+    int per_line = PLANT_BANK_ALIGN / (int)sizeof(float);
+    return ((capacity + per_line - 1) / per_line) * per_line;
+}
+
+// Allocate all columns from one aligned block
+// Channels start zeroed (position 0, no coefficients): configure them before stepping
+int plant_bank_init(PlantBank* bank, int capacity, float dt) {
+    if (capacity <= 0 || dt <= 0.0f) return -1;
+
+    int stride = plant_bank_stride(capacity);
+    size_t bytes = (size_t)stride * PLANT_BANK_COLUMNS * sizeof(float);
+
+    void* storage = calloc(1, bytes + PLANT_BANK_ALIGN);
+    if (storage == NULL) return -1;
+
+    float* base = (float*)(((uintptr_t)storage + PLANT_BANK_ALIGN - 1) & ~(uintptr_t)(PLANT_BANK_ALIGN - 1));
+    float** columns[PLANT_BANK_COLUMNS] = {
+        &bank->position, &bank->velocity, &bank->backlash_out,
+        &bank->load,
+        &bank->c_move, &bank->c_velocity, &bank->c_gap_velocity, &bank->c_keep_velocity,
+        &bank->deadband, &bank->half_backlash, &bank->rate_step,
+        &bank->disturbance, &bank->load_gain, &bank->load_stiffness
+    };
+    for (int c = 0; c < PLANT_BANK_COLUMNS; c++) {
+        *columns[c] = base + (size_t)c * stride;
+    }
+
+    bank->capacity = capacity;
+    bank->count = 0;
+    bank->dt = dt;
+    bank->storage = storage;
+    return 0;
+}
+
+// Release the column storage
+void plant_bank_free(PlantBank* bank) {
+    free(bank->storage);
+    bank->storage = NULL;
+    bank->capacity = 0;
+    bank->count = 0;
+}
+
+// exp(m) for a 2x2 matrix: scaling and squaring of a Taylor series
+static void matrix_exp2(const double m[2][2], double out[2][2]) {
+    double norm = fabs(m[0][0]) + fabs(m[0][1]) + fabs(m[1][0]) + fabs(m[1][1]);
+    int squarings = 0;
+    while (norm > 0.5) {
+        norm *= 0.5;
+        squarings++;
+    }
+    double scale = ldexp(1.0, -squarings);
+    double a[2][2] = { { m[0][0] * scale, m[0][1] * scale }, { m[1][0] * scale, m[1][1] * scale } };
+
+    double term[2][2] = { { 1.0, 0.0 }, { 0.0, 1.0 } };
+    double sum[2][2] = { { 1.0, 0.0 }, { 0.0, 1.0 } };
+    for (int k = 1; k <= 16; k++) {
+        double next[2][2];
+        for (int r = 0; r < 2; r++) {
+            for (int c = 0; c < 2; c++) {
+                next[r][c] = (term[r][0] * a[0][c] + term[r][1] * a[1][c]) / k;
+            }
+        }
+        memcpy(term, next, sizeof(term));
+        for (int r = 0; r < 2; r++) {
+            for (int c = 0; c < 2; c++) sum[r][c] += term[r][c];
+        }
+    }
+
+    for (int s = 0; s < squarings; s++) {
+        double squared[2][2];
+        for (int r = 0; r < 2; r++) {
+            for (int c = 0; c < 2; c++) {
+                squared[r][c] = sum[r][0] * sum[0][c] + sum[r][1] * sum[1][c];
+            }
+        }
+        memcpy(sum, squared, sizeof(sum));
+    }
+    memcpy(out, sum, sizeof(sum));
+}
+
+// Build the coefficients of one channel
+// Both models are written in deviation form: with x = position - seen command,
+// held constant over the step, the state [x, velocity] just decays by the
+// discrete transition matrix A = exp(A_c dt).
+int plant_bank_configure(PlantBank* bank, int index, const PlantParams* params) {
+    if (index < 0 || index >= bank->capacity) return -1;
+    if (params->deadband < 0.0f || params->backlash < 0.0f || params->max_rate < 0.0f) return -1;
+
+    float dt = bank->dt;
+    if (params->model == PLANT_FIRST_ORDER) {
+        if (params->time_constant <= 0.0f) return -1;
+        // Same float expression as valve_update(), so the step is bit-identical
+        float decay = expf(-dt / params->time_constant);
+        bank->c_move[index] = 1.0f - decay;
+        bank->c_velocity[index] = 0.0f;
+        bank->c_gap_velocity[index] = (1.0f - decay) / dt; // Reported rate only
+        bank->c_keep_velocity[index] = 0.0f;
+    } else if (params->model == PLANT_SECOND_ORDER) {
+        if (params->natural_frequency <= 0.0f || params->damping < 0.0f) return -1;
+        double wn = params->natural_frequency;
+        double m[2][2] = {
+            { 0.0, dt },
+            { -wn * wn * dt, -2.0 * params->damping * wn * dt }
+        };
+        double a[2][2];
+        matrix_exp2(m, a);
+        bank->c_move[index] = (float)(1.0 - a[0][0]);
+        bank->c_velocity[index] = (float)a[0][1];
+        bank->c_gap_velocity[index] = (float)(-a[1][0]);
+        bank->c_keep_velocity[index] = (float)a[1][1];
+    } else {
+        return -1;
+    }
+
+    bank->deadband[index] = params->deadband;
+    bank->half_backlash[index] = 0.5f * params->backlash;
+    bank->rate_step[index] = params->max_rate * dt;
+    bank->disturbance[index] = params->disturbance;
+    bank->load_gain[index] = params->load_gain;
+    bank->load_stiffness[index] = params->load_stiffness;
+    if (index >= bank->count) bank->count = index + 1;
+    return 0;
+}
+
+// Configure channel index as a copy of a scalar valve
+void plant_bank_load_valve(PlantBank* bank, int index, const ValveSimulator* valve) {
+    PlantParams params;
+    plant_params_default(&params);
+    params.time_constant = valve->time_constant;
+    params.deadband = valve->deadband;
+    params.disturbance = valve->disturbance;
+    plant_bank_configure(bank, index, &params);
+
+    bank->position[index] = valve->position;
+    bank->velocity[index] = 0.0f;
+    bank->backlash_out[index] = valve->command + valve->disturbance;
+    bank->load[index] = 0.0f;
+}
+
+// Column kernel - every pointer is a restrict parameter so the loop can be
+// vectorized without runtime alias checks
+static void plant_bank_kernel(int n, float inv_dt,
+                              float* restrict position,
+                              float* restrict velocity,
+                              float* restrict backlash_out,
+                              const float* restrict load,
+                              const float* restrict c_move,
+                              const float* restrict c_velocity,
+                              const float* restrict c_gap_velocity,
+                              const float* restrict c_keep_velocity,
+                              const float* restrict deadband,
+                              const float* restrict half_backlash,
+                              const float* restrict rate_step,
+                              const float* restrict disturbance,
+                              const float* restrict load_gain,
+                              const float* restrict load_stiffness,
+                              const float* restrict commands) {
+    for (int i = 0; i < n; i++) {
+        float p = position[i];
+        float v = velocity[i];
+
+        // Effective command: offsets and load (spring term uses the current position)
+        float u = commands[i] + disturbance[i] + load_gain[i] * load[i] - load_stiffness[i] * p;
+
+        // Backlash: the output only follows once the input leaves the play band
+        float h = half_backlash[i];
+        float y = backlash_out[i];
+        y = bit_select(u - y > h, u - h, y);
+        y = bit_select(u - y < -h, u + h, y);
+        backlash_out[i] = y;
+
+        // Deadband
+        float gap = y - p;
+        gap = bit_select(fabsf(gap) < deadband[i], 0.0f, gap);
+
+        // Exact discrete dynamics
+        float change = c_move[i] * gap + c_velocity[i] * v;
+        v = c_gap_velocity[i] * gap + c_keep_velocity[i] * v;
+
+        // Flow saturation (masked when the rate step is 0)
+        float step = rate_step[i];
+        float limited = bit_select(change > step, step, change);
+        limited = bit_select(change < -step, -step, limited);
+        float saturated = bit_select(step > 0.0f, limited, change);
+        v = bit_select(saturated != change, saturated * inv_dt, v);
+
+        // A spool at rest decays its velocity towards zero forever; flush it
+        // before it reaches subnormal range, where every operation is slow
+        v = bit_select(fabsf(v) < PLANT_BANK_REST_VELOCITY, 0.0f, v);
+
+        // End stops: the spool stops dead at 0% and 100%
+        p += saturated;
+        float stopped = bit_select(p < 0.0f, 0.0f, p);
+        stopped = bit_select(p > 100.0f, 100.0f, stopped);
+        v = bit_select(stopped != p, 0.0f, v);
+
+        position[i] = stopped;
+        velocity[i] = v;
+    }
+}
+
+// Step channels [0, n) - a first-order channel matches valve_update()
+void plant_bank_update(PlantBank* bank, const float* commands, int n) {
+    if (n > bank->count) n = bank->count;
+    plant_bank_kernel(n, 1.0f / bank->dt,
+                      bank->position, bank->velocity, bank->backlash_out, bank->load,
+                      bank->c_move, bank->c_velocity, bank->c_gap_velocity, bank->c_keep_velocity,
+                      bank->deadband, bank->half_backlash, bank->rate_step,
+                      bank->disturbance, bank->load_gain, bank->load_stiffness,
+                      commands);
+}
@@ -0,0 +1,82 @@
+#ifndef PLANT_BANK_H
+#define PLANT_BANK_H
+
+#include "valve_simulator.h"
+
+// Structure-of-arrays bank of hydraulic valve models
+// Every channel is stepped by the same straight-line kernel; the model and
+// the optional effects only change per-channel coefficients, so one
+// plant_bank_update() call advances a mixed fleet with vectorizable loops.
+//
+// Per step, for command u:
+//   effective = u + disturbance + load_gain * load - load_stiffness * position
+//   seen      = effective after backlash (mechanical play of +/-backlash/2)
+//   gap       = seen - position, zeroed inside +/-deadband
+//   position += c_move * gap + c_velocity * velocity   (limited to +/-max_rate * dt)
+//   velocity  = c_gap_velocity * gap + c_keep_velocity * velocity
+// The coefficients are the exact zero-order-hold discretization of the
+// model, so a first-order channel steps exactly like valve_update().
+
+typedef enum {
+    PLANT_FIRST_ORDER = 0, // Lag: tau dx/dt = u - x
+    PLANT_SECOND_ORDER     // Spool: x'' + 2 zeta wn x' + wn^2 x = wn^2 u
+} PlantModel;
+
+typedef struct {
+    PlantModel model;
+    float time_constant;     // First order (s)
+    float natural_frequency; // Second order (rad/s)
+    float damping;           // Second order damping ratio
+    float deadband;          // No response to gaps within +/-deadband (%)
+    float backlash;          // Width of the hysteresis band (%, 0 = none)
+    float max_rate;          // Flow saturation: max |d position / dt| (%/s, 0 = none)
+    float disturbance;       // Constant command offset (%)
+    float load_gain;         // Command offset per unit of the load input (%)
+    float load_stiffness;    // Command lost per % of position (spring load)
+} PlantParams;
+
+typedef struct {
+    int capacity; // Number of channels allocated
+    int count;    // Number of channels in use
+    float dt;     // Step size all coefficients are built for
+
+    // State
+    float* position;       // 0-100%
+    float* velocity;       // %/s (spool velocity for second order)
+    float* backlash_out;   // Command after the mechanical play
+
+    // Input: external load per channel, written by the caller (0 = none)
+    float* load;
+
+    // Precomputed coefficients (rebuilt by plant_bank_configure())
+    float* c_move;
+    float* c_velocity;
+    float* c_gap_velocity;
+    float* c_keep_velocity;
+    float* deadband;
+    float* half_backlash;
+    float* rate_step;       // max_rate * dt (0 = disabled)
+    float* disturbance;
+    float* load_gain;
+    float* load_stiffness;
+
+    void* storage; // Single allocation backing all columns
+} PlantBank;
+
+// First-order 0.2 s valve with every effect disabled (main.c's plant)
+void plant_params_default(PlantParams* params);
+
+// Allocate a bank for up to capacity channels stepped at dt (returns 0 on success, -1 on failure)
+int plant_bank_init(PlantBank* bank, int capacity, float dt);
+void plant_bank_free(PlantBank* bank);
+
+// Set the model of channel index, keeping its state (returns 0 on success, -1 on bad parameters)
+int plant_bank_configure(PlantBank* bank, int index, const PlantParams* params);
+
+// Copy a ValveSimulator (model, deadband, disturbance and position) into channel index
+void plant_bank_load_valve(PlantBank* bank, int index, const ValveSimulator* valve);
+
+// Step channels [0, n) with one command each
+void plant_bank_update(PlantBank* bank, const float* commands, int n);
+
+#endif // PLANT_BANK_H
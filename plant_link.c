@@ -0,0 +1,287 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "plant_link.h"
+
+#define RING_MASK          (PLANT_LINK_RING - 1)
+#define SPINS_BEFORE_YIELD 1024 // Give the CPU away if a wait lasts this long
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void spin_pause(int* spins) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+    if (++*spins >= SPINS_BEFORE_YIELD) {
+        *spins = 0;
+        sched_yield(); // Only reached while idle - the other side may need this CPU
+    }
+}
+
+static size_t shared_size(int channels) {
+    return sizeof(PlantLinkShared) + (size_t)channels * sizeof(PlantLinkChannel);
+}
+
+// Seqlock-style publish: the sequence is cleared while the payload changes and
+// stored last, so a reader never accepts a half-written slot
+static void slot_write(PlantLinkSlot* slot, uint64_t sequence, float value, float dt,
+                       uint64_t sent_ns, uint64_t applied_ns) {
+    atomic_store_explicit(&slot->sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot->value = value;
+    slot->dt = dt;
+    slot->sent_ns = sent_ns;
+    slot->applied_ns = applied_ns;
+    atomic_store_explicit(&slot->sequence, sequence, memory_order_release);
+}
+
+// Copy a slot if it holds the given sequence (returns 0 if not, or if it
+// was being rewritten while we read it)
+static int slot_read(PlantLinkSlot* slot, uint64_t sequence, PlantLinkSlot* out) {
+    if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != sequence) return 0;
+    out->value = slot->value;
+    out->dt = slot->dt;
+    out->sent_ns = slot->sent_ns;
+    out->applied_ns = slot->applied_ns;
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&slot->sequence, memory_order_relaxed) == sequence;
+}
+
+int plant_server_open(PlantServer* server, const char* name, int channels,
+                      float time_constant, float deadband) {
+    if (channels <= 0 || channels > PLANT_LINK_MAX_CHANNELS) return -1;
+    if (strlen(name) >= sizeof(server->name)) return -1;
+
+    memset(server, 0, sizeof(*server));
+    server->size = shared_size(channels);
+    server->num_channels = channels;
+    strcpy(server->name, name);
+
+    // A segment left behind by a crashed run is replaced, not reused
+    shm_unlink(name);
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) return -1;
+    if (ftruncate(fd, (off_t)server->size) != 0) {
+        close(fd);
+        shm_unlink(name);
+        return -1;
+    }
+    void* map = mmap(NULL, server->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        shm_unlink(name);
+        return -1;
+    }
+    server->shared = (PlantLinkShared*)map;
+
+    server->valves = calloc(channels, sizeof(ValveSimulator));
+    server->next_sequence = calloc(channels, sizeof(uint64_t));
+    if (server->valves == NULL || server->next_sequence == NULL) {
+        plant_server_close(server);
+        return -1;
+    }
+
+    PlantLinkShared* shared = server->shared;
+    memcpy(shared->magic, PLANT_LINK_MAGIC, 4);
+    shared->version = PLANT_LINK_VERSION;
+    shared->num_channels = (uint32_t)channels;
+    shared->ring_size = PLANT_LINK_RING;
+    atomic_store_explicit(&shared->stop, 0, memory_order_relaxed);
+    atomic_store_explicit(&shared->applied, 0, memory_order_relaxed);
+    atomic_store_explicit(&shared->dropped, 0, memory_order_relaxed);
+    atomic_store_explicit(&shared->overruns, 0, memory_order_relaxed);
+    for (int i = 0; i < channels; i++) {
+        valve_init(&server->valves[i], time_constant, deadband);
+        server->next_sequence[i] = 1;
+        shared->channels[i].initial_position = valve_get_position(&server->valves[i]);
+        for (int k = 0; k < PLANT_LINK_RING; k++) {
+            atomic_store_explicit(&shared->channels[i].command[k].sequence, 0, memory_order_relaxed);
+            atomic_store_explicit(&shared->channels[i].position[k].sequence, 0, memory_order_relaxed);
+        }
+    }
+    atomic_store_explicit(&shared->ready, 1, memory_order_release);
+    return 0;
+}
+
+// Apply every command that is due on one channel (returns how many)
+static int serve_channel(PlantServer* server, int index, uint64_t now) {
+    PlantLinkChannel* channel = &server->shared->channels[index];
+    ValveSimulator* valve = &server->valves[index];
+    int served = 0;
+
+    for (;;) {
+        uint64_t next = server->next_sequence[index];
+        PlantLinkSlot* slot = &channel->command[next & RING_MASK];
+        uint64_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        if (sequence < next) break; // Empty, or still last lap's command
+
+        PlantLinkSlot command;
+        if (!slot_read(slot, sequence, &command)) break; // Being written - next pass
+        if (server->delay_ns > 0 && now < command.sent_ns + server->delay_ns) break;
+
+        // The controller lapped us: only the commands up to sequence - RING
+        // were overwritten; the last lap is still in the ring, served in order
+        if (sequence > next) {
+            uint64_t oldest = sequence - PLANT_LINK_RING + 1;
+            server->overruns += oldest - next;
+            server->next_sequence[index] = oldest;
+            continue;
+        }
+        server->next_sequence[index] = sequence + 1;
+
+        valve_update(valve, command.value, command.dt);
+        server->applied++;
+        served++;
+
+        if (server->drop_every > 0 && sequence % server->drop_every == 0) {
+            server->dropped++;
+            continue;
+        }
+        slot_write(&channel->position[sequence & RING_MASK], sequence,
+                   valve_get_position(valve), command.dt, command.sent_ns, now);
+    }
+    return served;
+}
+
+void plant_server_run(PlantServer* server) {
+    PlantLinkShared* shared = server->shared;
+    int spins = 0;
+
+    while (!atomic_load_explicit(&shared->stop, memory_order_acquire)) {
+        uint64_t now = now_ns();
+        int served = 0;
+        for (int i = 0; i < server->num_channels; i++) {
+            served += serve_channel(server, i, now);
+        }
+        if (served > 0) {
+            atomic_store_explicit(&shared->applied, server->applied, memory_order_relaxed);
+            atomic_store_explicit(&shared->dropped, server->dropped, memory_order_relaxed);
+            atomic_store_explicit(&shared->overruns, server->overruns, memory_order_relaxed);
+            spins = 0;
+        } else {
+            spin_pause(&spins);
+        }
+    }
+}
+
+void plant_server_close(PlantServer* server) {
+    if (server->shared != NULL) {
+        munmap(server->shared, server->size);
+        shm_unlink(server->name);
+        server->shared = NULL;
+    }
+    free(server->valves);
+    free(server->next_sequence);
+    server->valves = NULL;
+    server->next_sequence = NULL;
+}
+
+int plant_client_open(PlantClient* client, const char* name, int channel, uint64_t wait_ns) {
+    memset(client, 0, sizeof(*client));
+
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) return -1;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(PlantLinkShared)) {
+        close(fd);
+        return -1;
+    }
+    void* map = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+
+    PlantLinkShared* shared = (PlantLinkShared*)map;
+    client->shared = shared;
+    client->size = (size_t)info.st_size;
+    if (!atomic_load_explicit(&shared->ready, memory_order_acquire) ||
+        memcmp(shared->magic, PLANT_LINK_MAGIC, 4) != 0 ||
+        shared->version != PLANT_LINK_VERSION ||
+        shared->ring_size != PLANT_LINK_RING ||
+        channel < 0 || (uint32_t)channel >= shared->num_channels ||
+        client->size < shared_size((int)shared->num_channels)) {
+        plant_client_close(client);
+        return -1;
+    }
+
+    client->channel = &shared->channels[channel];
+    client->position = client->channel->initial_position;
+    client->wait_ns = wait_ns;
+    rt_histogram_reset(&client->round_trip);
+    return 0;
+}
+
+void plant_client_update(PlantClient* client, float command, float dt) {
+    uint64_t sequence = ++client->sequence;
+    slot_write(&client->channel->command[sequence & RING_MASK], sequence, command, dt, now_ns(), 0);
+}
+
+// Take the reply to one command if it is there
+static int take_reply(PlantClient* client, uint64_t sequence) {
+    PlantLinkSlot reply;
+    if (!slot_read(&client->channel->position[sequence & RING_MASK], sequence, &reply)) return 0;
+    client->position = reply.value;
+    client->received = sequence;
+    rt_histogram_add(&client->round_trip, now_ns() - reply.sent_ns);
+    return 1;
+}
+
+float plant_client_get_position(PlantClient* client) {
+    uint64_t latest = client->sequence;
+    if (latest == client->received) return client->position; // Nothing outstanding
+
+    // Fast path: the reply is already there - two loads, no clock, no syscall
+    if (take_reply(client, latest)) return client->position;
+
+    if (client->wait_ns > 0) {
+        uint64_t start = now_ns();
+        int spins = 0;
+        for (;;) {
+            spin_pause(&spins);
+            if (take_reply(client, latest)) return client->position;
+            if (now_ns() - start >= client->wait_ns) break;
+        }
+    }
+
+    // Missed: fall back to the newest older reply that did arrive
+    client->missed++;
+    for (uint64_t s = latest - 1; s > client->received && latest - s < PLANT_LINK_RING; s--) {
+        if (take_reply(client, s)) return client->position;
+    }
+    client->stale++;
+    return client->position;
+}
+
+void plant_client_stop_server(PlantClient* client) {
+    atomic_store_explicit(&client->shared->stop, 1, memory_order_release);
+}
+
+void plant_client_close(PlantClient* client) {
+    if (client->shared != NULL) munmap(client->shared, client->size);
+    client->shared = NULL;
+    client->channel = NULL;
+}
+
+static void plant_client_plant_update(void* state, float command, float dt) {
+    plant_client_update((PlantClient*)state, command, dt);
+}
+
+static float plant_client_plant_get_position(void* state) {
+    return plant_client_get_position((PlantClient*)state);
+}
+
+void plant_from_client(PlantInterface* plant, PlantClient* client) {
+    plant->state = client;
+    plant->update = plant_client_plant_update;
+    plant->get_position = plant_client_plant_get_position;
+}
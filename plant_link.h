@@ -0,0 +1,124 @@
+#ifndef PLANT_LINK_H
+#define PLANT_LINK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "valve_simulator.h"
+#include "plant.h"
+#include "rt_executor.h"
+
+// Shared-memory link to plants hosted in another process
+// A plant server owns the ValveSimulator instances; controllers reach them
+// through a POSIX shared-memory segment with two rings per channel:
+//   command ring   controller -> server  (command, dt, send timestamp)
+//   position ring  server -> controller  (position, echo of the send timestamp)
+// Every slot carries the sequence number of the command it belongs to and is
+// published by storing that number last, so neither side takes a lock or
+// makes a syscall per sample (timestamps come from the vDSO clock). A reader
+// that finds a newer sequence than it expected knows samples were lost.
+
+#define PLANT_LINK_MAGIC        "HVPL"
+#define PLANT_LINK_VERSION      1
+#define PLANT_LINK_RING         64  // Slots per ring (power of two)
+#define PLANT_LINK_MAX_CHANNELS 256
+#define PLANT_LINK_CACHE_LINE   64
+#define PLANT_LINK_WAIT_FOREVER UINT64_MAX // Lock-step: every read waits for its reply
+
+typedef struct {
+    _Atomic uint64_t sequence; // Command sequence (0 = empty slot, written last)
+    uint64_t sent_ns;          // Controller clock when the command was sent
+    uint64_t applied_ns;       // Server clock when it was applied (position ring)
+    float value;               // Command or position (%)
+    float dt;                  // Step to simulate (command ring)
+} PlantLinkSlot;
+
+typedef struct {
+    _Alignas(PLANT_LINK_CACHE_LINE) float initial_position; // Before the first reply
+    _Alignas(PLANT_LINK_CACHE_LINE) PlantLinkSlot command[PLANT_LINK_RING];
+    _Alignas(PLANT_LINK_CACHE_LINE) PlantLinkSlot position[PLANT_LINK_RING];
+} PlantLinkChannel;
+
+typedef struct {
+    char magic[4];         // "HVPL"
+    uint32_t version;
+    uint32_t num_channels;
+    uint32_t ring_size;
+    _Atomic int ready;     // Set once the server has initialized its plants
+    _Atomic int stop;      // Set by a client to shut the server down
+
+    // Server statistics, published after every pass that served commands
+    _Alignas(PLANT_LINK_CACHE_LINE) _Atomic uint64_t applied;
+    _Atomic uint64_t dropped;
+    _Atomic uint64_t overruns;
+    PlantLinkChannel channels[]; // Cache-line aligned through PlantLinkChannel
+} PlantLinkShared;
+
+// Server side: hosts one valve per channel
+typedef struct {
+    PlantLinkShared* shared;
+    size_t size;
+    char name[64];
+    int num_channels;
+    ValveSimulator* valves;
+    uint64_t* next_sequence; // Next command expected per channel
+
+    // Fault injection
+    uint64_t delay_ns;     // Hold every command this long before applying it
+    uint32_t drop_every;   // Apply every Nth command but lose its reply (0 = never)
+
+    // Statistics (mirrored into the shared header for the controllers)
+    uint64_t applied;
+    uint64_t dropped;      // Replies lost on purpose
+    uint64_t overruns;     // Commands overwritten before the server read them
+} PlantServer;
+
+// Create the segment (name like "/hv_plant") and one valve per channel
+// Returns 0 on success, -1 on failure
+int plant_server_open(PlantServer* server, const char* name, int channels,
+                      float time_constant, float deadband);
+
+// Serve commands until a client calls plant_client_stop_server()
+// Busy-polls; yields the CPU only after a long idle stretch
+void plant_server_run(PlantServer* server);
+
+// Unmap and remove the segment
+void plant_server_close(PlantServer* server);
+
+// Controller side: one channel, drop-in for valve_update() / valve_get_position()
+typedef struct {
+    PlantLinkShared* shared;
+    size_t size;
+    PlantLinkChannel* channel;
+
+    uint64_t sequence;   // Last command sent
+    uint64_t received;   // Sequence of the newest position received
+    float position;      // Newest position (held when a sample is missed)
+    uint64_t wait_ns;    // How long get_position waits for the latest reply
+
+    // Statistics
+    uint64_t missed;      // Reads where the reply to the latest command was not there
+    uint64_t stale;       // ...and no newer position at all (last value held)
+    RtHistogram round_trip; // Command sent -> its position received
+} PlantClient;
+
+// Attach to a running server's channel (returns 0 on success, -1 on failure)
+// wait_ns: 0 = take whatever has arrived (a reply later than one period is missed),
+//          PLANT_LINK_WAIT_FOREVER = lock-step with the server
+int plant_client_open(PlantClient* client, const char* name, int channel, uint64_t wait_ns);
+
+// Send a command for one step of dt seconds (never blocks)
+void plant_client_update(PlantClient* client, float command, float dt);
+
+// Newest position, waiting up to wait_ns for the reply to the last command
+float plant_client_get_position(PlantClient* client);
+
+// Ask the server to exit (e.g. at the end of a test run)
+void plant_client_stop_server(PlantClient* client);
+
+void plant_client_close(PlantClient* client);
+
+// Expose a client channel through the generic plant interface
+void plant_from_client(PlantInterface* plant, PlantClient* client);
+
+#endif // PLANT_LINK_H
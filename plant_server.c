@@ -0,0 +1,72 @@
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include "plant_link.h"
+
+// Plant server process: hosts simulated valves behind a shared-memory link
+// Controllers (hil_controller, or anything using plant_client_*) attach by
+// name and channel. Runs until a client asks it to stop.
+
+int main(int argc, char* argv[])
+{
+    // Defaults: one 0.2 s valve, no injected faults, no pinning
+    const char* name = "/hv_plant";
+    int channels = 1;
+    float time_constant = 0.2f;
+    double delay_us = 0.0;
+    int drop_every = 0;
+    int cpu = -1;
+
+    if (argc >= 2) name = argv[1];
+    if (argc >= 3) channels = atoi(argv[2]);
+    if (argc >= 4) time_constant = (float)atof(argv[3]);
+    if (argc >= 5) delay_us = atof(argv[4]);
+    if (argc >= 6) drop_every = atoi(argv[5]);
+    if (argc >= 7) cpu = atoi(argv[6]);
+
+    if (name[0] != '/' || channels <= 0 || channels > PLANT_LINK_MAX_CHANNELS ||
+        time_constant <= 0.0f || delay_us < 0.0 || drop_every < 0)
+        {
+            printf("Usage: %s [/name] [channels] [tau_s] [delay_us] [drop_every] [cpu]\n", argv[0]);
+            return -1;
+        }
+
+    if (cpu >= 0)
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            if (sched_setaffinity(0, sizeof(set), &set) != 0)
+                {
+                    printf("Warning: could not pin to CPU %d\n", cpu);
+                }
+        }
+
+    PlantServer server;
+    if (plant_server_open(&server, name, channels, time_constant, 0.0f) != 0)
+        {
+            printf("Error creating shared memory %s!\n", name);
+            return -1;
+        }
+    server.delay_ns = (uint64_t)(delay_us * 1000.0 + 0.5);
+    server.drop_every = (uint32_t)drop_every;
+
+    printf("Plant Server\n");
+    printf("- Segment: %s (%d channel%s, %zu bytes)\n", name, channels, channels == 1 ? "" : "s", server.size);
+    printf("- Valve time constant: %.3f s\n", time_constant);
+    printf("- Injected latency: %.1f us\n", delay_us);
+    printf("- Lost replies: every %d commands (0 = none)\n", drop_every);
+    printf("Serving until a controller stops the server...\n");
+    fflush(stdout);
+
+    plant_server_run(&server);
+
+    printf("\nApplied: %llu commands\n", (unsigned long long)server.applied);
+    printf("Dropped replies: %llu\n", (unsigned long long)server.dropped);
+    printf("Overruns: %llu\n", (unsigned long long)server.overruns);
+    plant_server_close(&server);
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include <math.h>
+#include <string.h>
+#include "relay_autotune.h"
+
+#define PI_F     3.14159265f
+#define TWO_PI_F 6.28318531f
+
+// Rule constants: Kp = kp_ku * Ku, Ti = ti_pu * Pu (0 = no integral), Td = td_pu * Pu
+typedef struct {
+    const char* name;
+    float kp_ku;
+    float ti_pu;
+    float td_pu;
+} TuningRuleTable;
+
+static const TuningRuleTable rules[TUNE_RULE_COUNT] = {
+    {"zn",    0.6f,         0.5f,         0.125f},
+    {"zn-pi", 0.45f,        1.0f / 1.2f,  0.0f},
+    {"tl",    1.0f / 2.2f,  2.2f,         1.0f / 6.3f},
+    {"tl-pi", 1.0f / 3.2f,  2.2f,         0.0f},
+    {"some",  1.0f / 3.0f,  0.5f,         1.0f / 3.0f},
+    {"none",  0.2f,         0.5f,         1.0f / 3.0f}
+};
+
+void relay_autotune_init(RelayAutotune* tune, float setpoint, float bias, float amplitude,
+                         float hysteresis, float sample_time) {
+    memset(tune, 0, sizeof(RelayAutotune));
+    tune->setpoint = setpoint;
+    tune->bias = bias;
+    tune->amplitude = amplitude;
+    tune->hysteresis = hysteresis;
+    tune->output_min = 0.0f;
+    tune->output_max = 100.0f;
+    tune->sample_time = sample_time;
+    tune->settle_cycles = 2;
+    tune->measure_cycles = 4;
+
+    tune->relay_high = -1; // Chosen from the first measurement
+    tune->last_rise = -1.0f;
+    tune->last_fall = -1.0f;
+}
+
+static float relay_output(const RelayAutotune* tune, int high) {
+    float command = high ? tune->bias + tune->amplitude : tune->bias - tune->amplitude;
+    if (command > tune->output_max) command = tune->output_max;
+    if (command < tune->output_min) command = tune->output_min;
+    return command;
+}
+
+// A cycle runs from one low -> high switch to the next
+static void relay_autotune_close_cycle(RelayAutotune* tune, float now) {
+    float period = now - tune->last_rise;
+    float high_time = tune->last_fall - tune->last_rise;
+    float low_time = now - tune->last_fall;
+
+    // The DFT used the previous cycle's length; a cycle of another length
+    // (still settling) gives no harmonic and is not counted
+    int steady = tune->cycle_samples == tune->last_cycle_samples;
+    double harmonic = 2.0 * sqrt(tune->harmonic_re * tune->harmonic_re +
+                                 tune->harmonic_im * tune->harmonic_im) / tune->cycle_samples;
+
+    tune->cycles++;
+    if (tune->cycles > tune->settle_cycles && steady && !tune->done) {
+        tune->period_sum += period;
+        tune->peak_sum += 0.5f * (tune->cycle_max - tune->cycle_min);
+        tune->harmonic_sum += harmonic;
+
+        int measured = ++tune->measured_cycles;
+        if (measured >= tune->measure_cycles) {
+            // Relay amplitude actually applied (after the command limits)
+            float d = 0.5f * (relay_output(tune, 1) - relay_output(tune, 0));
+            tune->ultimate_period = (float)(tune->period_sum / measured);
+            tune->oscillation = (float)(tune->peak_sum / measured);
+            tune->harmonic = (float)(tune->harmonic_sum / measured);
+            tune->ultimate_gain = (tune->harmonic > 0.0f) ?
+                                  4.0f * d / (PI_F * tune->harmonic) : 0.0f;
+            tune->done = 1;
+        }
+    }
+    tune->last_cycle_samples = tune->cycle_samples;
+
+    // Re-centre the bias on the mean command of the cycle, which is the
+    // command that holds the setpoint; equal half-periods mean it is there
+    if (period > 0.0f) tune->bias += tune->amplitude * (high_time - low_time) / period;
+}
+
+float relay_autotune_update(RelayAutotune* tune, float measurement) {
+    float now = tune->samples * tune->sample_time;
+    float error = tune->setpoint - measurement;
+    tune->samples++;
+    tune->last_measurement = measurement;
+
+    if (tune->relay_high < 0) {
+        tune->relay_high = (error > 0.0f);
+        tune->cycle_max = measurement;
+        tune->cycle_min = measurement;
+    }
+
+    if (tune->relay_high && error < -tune->hysteresis) {
+        tune->relay_high = 0;
+        tune->last_fall = now;
+    } else if (!tune->relay_high && error > tune->hysteresis) {
+        tune->relay_high = 1;
+        if (tune->last_rise >= 0.0f && tune->last_fall > tune->last_rise) {
+            relay_autotune_close_cycle(tune, now);
+        }
+        tune->last_rise = now;
+        tune->cycle_max = measurement;
+        tune->cycle_min = measurement;
+        tune->cycle_samples = 0;
+        tune->harmonic_re = 0.0;
+        tune->harmonic_im = 0.0;
+    }
+
+    if (measurement > tune->cycle_max) tune->cycle_max = measurement;
+    if (measurement < tune->cycle_min) tune->cycle_min = measurement;
+
+    // One DFT bin at the previous cycle's period, phase zero at the last rise
+    if (tune->last_cycle_samples > 0) {
+        float angle = TWO_PI_F * tune->cycle_samples / tune->last_cycle_samples;
+        tune->harmonic_re += measurement * cosf(angle);
+        tune->harmonic_im -= measurement * sinf(angle);
+    }
+    tune->cycle_samples++;
+
+    tune->command = relay_output(tune, tune->relay_high);
+    return tune->command;
+}
+
+int relay_autotune_run(RelayAutotune* tune, const PlantInterface* plant, float max_time) {
+    long max_samples = (long)(max_time / tune->sample_time);
+    while (!tune->done && tune->samples < max_samples) {
+        float command = relay_autotune_update(tune, plant->get_position(plant->state));
+        plant->update(plant->state, command, tune->sample_time);
+    }
+    return tune->done ? 0 : -1;
+}
+
+int relay_autotune_gains(const RelayAutotune* tune, TuningRule rule, float* kp, float* ki, float* kd) {
+    if (!tune->done || rule < 0 || rule >= TUNE_RULE_COUNT) return -1;
+
+    const TuningRuleTable* r = &rules[rule];
+    float p = r->kp_ku * tune->ultimate_gain;
+    float ti = r->ti_pu * tune->ultimate_period;
+    float td = r->td_pu * tune->ultimate_period;
+
+    // Parallel form used by pid_compute(): ki = Kp / Ti, kd = Kp * Td
+    *kp = p;
+    *ki = (ti > 0.0f) ? p / ti : 0.0f;
+    *kd = p * td;
+    return 0;
+}
+
+// Bumpless switchover
+// The relay's last command u was computed from the last measurement, so the
+// integral is preloaded to make kp * e + ki * integral = u for that error and
+// the derivative history starts from it; the first pid_compute() then
+// continues from u instead of jumping to whatever the empty integral gives.
+int relay_autotune_apply(const RelayAutotune* tune, TuningRule rule, PIDController* pid) {
+    float kp, ki, kd;
+    if (relay_autotune_gains(tune, rule, &kp, &ki, &kd) != 0) return -1;
+
+    pid_set_gains(pid, kp, ki, kd);
+    pid_set_setpoint(pid, tune->setpoint);
+
+    // Less the e * dt that pid_compute() adds before it uses the integral
+    float error = tune->setpoint - tune->last_measurement;
+    pid->integral = (ki > 0.0f) ? (tune->command - kp * error) / ki - error * pid->sample_time : 0.0f;
+    if (pid->integral > pid->integral_max) pid->integral = pid->integral_max;
+    if (pid->integral < pid->integral_min) pid->integral = pid->integral_min;
+
+    pid->prev_error = error;
+    pid->derivative_filtered = 0.0f;
+    pid->prev_output = tune->command;
+    return 0;
+}
+
+const char* relay_autotune_rule_name(TuningRule rule) {
+    if (rule < 0 || rule >= TUNE_RULE_COUNT) return "?";
+    return rules[rule].name;
+}
+
+int relay_autotune_rule_from_name(const char* name) {
+    for (int r = 0; r < TUNE_RULE_COUNT; r++) {
+        if (strcmp(rules[r].name, name) == 0) return r;
+    }
+    return -1;
+}
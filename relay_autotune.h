@@ -0,0 +1,90 @@
+#ifndef RELAY_AUTOTUNE_H
+#define RELAY_AUTOTUNE_H
+
+#include "pid_controller.h"
+#include "plant.h"
+
+// Relay-feedback auto-tuner (Astrom-Hagglund)
+// Replaces the controller with a relay: command = bias + amplitude while the
+// position is below setpoint - hysteresis, bias - amplitude once it is above
+// setpoint + hysteresis. Any plant with enough phase lag then settles into a
+// limit cycle whose period is the ultimate period Pu and whose amplitude a
+// gives the ultimate gain Ku = 4 * amplitude / (pi * a).
+// a is the amplitude of the fundamental (a one-bin DFT over each cycle), not
+// the peak: the limit cycle of a plant with dead time is closer to a triangle
+// than a sine, and the peak alone underestimates Ku by 15-20%.
+// The bias is re-centred after every cycle so the limit cycle is symmetric
+// even when the command needed to hold the setpoint is not known in advance.
+typedef enum {
+    TUNE_ZIEGLER_NICHOLS = 0, // Classic PID: Kp = 0.6 Ku, Ti = Pu/2, Td = Pu/8
+    TUNE_ZIEGLER_NICHOLS_PI,  // Kp = 0.45 Ku, Ti = Pu/1.2
+    TUNE_TYREUS_LUYBEN,       // Kp = Ku/2.2, Ti = 2.2 Pu, Td = Pu/6.3 (less overshoot)
+    TUNE_TYREUS_LUYBEN_PI,    // Kp = Ku/3.2, Ti = 2.2 Pu
+    TUNE_SOME_OVERSHOOT,      // Kp = Ku/3, Ti = Pu/2, Td = Pu/3
+    TUNE_NO_OVERSHOOT,        // Kp = Ku/5, Ti = Pu/2, Td = Pu/3
+    TUNE_RULE_COUNT
+} TuningRule;
+
+typedef struct {
+    // Configuration
+    float setpoint;     // Position the relay oscillates around (%)
+    float bias;         // Command the relay switches around (adapted every cycle)
+    float amplitude;    // Relay amplitude d (%)
+    float hysteresis;   // Switching band around the setpoint (% - above the noise level)
+    float output_min;   // Command limits
+    float output_max;
+    float sample_time;  // Seconds per update
+    int settle_cycles;  // Cycles discarded while the oscillation builds up
+    int measure_cycles; // Cycles averaged into the result
+
+    // Relay state
+    int relay_high;         // 1 while the relay output is high
+    float command;          // Last command returned
+    float last_measurement; // Last measurement passed in
+    long samples;           // Updates since init
+    float last_rise;        // Time of the last low -> high switch (-1 = none yet)
+    float last_fall;        // Time of the last high -> low switch
+    float cycle_max;        // Extremes of the position in the current cycle
+    float cycle_min;
+    long cycle_samples;     // Samples in the current cycle
+    long last_cycle_samples; // Samples in the previous cycle (DFT length, 0 = none yet)
+    double harmonic_re;     // Fundamental of the position over the current cycle
+    double harmonic_im;
+    int cycles;             // Complete cycles so far
+    int measured_cycles;    // Cycles counted into the result
+    double period_sum;      // Sums over the measured cycles
+    double peak_sum;
+    double harmonic_sum;
+
+    // Results (valid once done is set)
+    int done;
+    float ultimate_gain;   // Ku
+    float ultimate_period; // Pu (seconds)
+    float oscillation;     // Limit cycle amplitude (% peak, for reference)
+    float harmonic;        // Amplitude a of its fundamental (%)
+} RelayAutotune;
+
+// Prepare an experiment around setpoint, starting from the given bias command
+void relay_autotune_init(RelayAutotune* tune, float setpoint, float bias, float amplitude,
+                         float hysteresis, float sample_time);
+
+// One step: takes the measured position and returns the relay command to apply
+// Sets tune->done once measure_cycles cycles have been averaged
+float relay_autotune_update(RelayAutotune* tune, float measurement);
+
+// Run the whole experiment on a plant (returns 0 when done, -1 on timeout)
+int relay_autotune_run(RelayAutotune* tune, const PlantInterface* plant, float max_time);
+
+// Gains for a rule from the identified Ku and Pu (returns 0 on success, -1 if not done)
+int relay_autotune_gains(const RelayAutotune* tune, TuningRule rule, float* kp, float* ki, float* kd);
+
+// Load the gains into a controller with a bumpless switchover: the setpoint is
+// set to the experiment's and the integral is preloaded so the controller
+// picks up from the last relay command (returns 0 on success, -1 if not done)
+int relay_autotune_apply(const RelayAutotune* tune, TuningRule rule, PIDController* pid);
+
+// Short name of a rule ("zn", "tl", ...) and the reverse lookup (-1 if unknown)
+const char* relay_autotune_rule_name(TuningRule rule);
+int relay_autotune_rule_from_name(const char* name);
+
+#endif // RELAY_AUTOTUNE_H
@@ -0,0 +1,286 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <time.h>
+#include "replay_engine.h"
+#include "worker_pool.h"
+
+// Replay recorded logs through candidate controller configurations
+// Usage: replay [--threads N] [--plant tau deadband] [--initial-position P]
+//               [--warmup S] candidates.txt log.csv|log.hvcl|directory ...
+// Directories contribute every *.csv and *.hvcl file in them. Worker
+// threads take one file at a time, load it once and step every candidate
+// over it as one PIDBank; one row per file and candidate goes to
+// replay_summary.csv.
+
+
+typedef struct {
+    const char* path;
+    int status;       // 0 = replayed, -1 = failed to load
+    long error_line;
+    long rows;
+    double load_s;    // Reading and parsing (or mapping) the log
+    double replay_s;  // Stepping the candidates
+    ReplayScore* scores; // One per candidate
+} ReplayFile;
+
+typedef struct {
+    ReplayFile* files;
+    const ReplayCandidate* candidates;
+    int num_candidates;
+    const ReplayOptions* options;
+} ReplayWorker;
+
+typedef struct {
+    char** paths;
+    int count;
+    int capacity;
+} PathList;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int path_list_add(PathList* list, const char* path) {
+    if (list->count == list->capacity) {
+        int grown = list->capacity ? list->capacity * 2 : 64;
+        char** paths = realloc(list->paths, sizeof(char*) * grown);
+        if (paths == NULL) return -1;
+        list->paths = paths;
+        list->capacity = grown;
+    }
+    list->paths[list->count] = strdup(path);
+    return (list->paths[list->count++] != NULL) ? 0 : -1;
+}
+
+static int compare_paths(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+static int is_log_name(const char* name) {
+    size_t length = strlen(name);
+    return (length > 4 && strcmp(name + length - 4, ".csv") == 0) ||
+           (length > 5 && strcmp(name + length - 5, ".hvcl") == 0);
+}
+
+// A file is taken as given; a directory adds its logs in name order
+static int collect_paths(PathList* list, const char* path) {
+    struct stat info;
+    if (stat(path, &info) != 0 || !S_ISDIR(info.st_mode)) return path_list_add(list, path);
+
+    DIR* dir = opendir(path);
+    if (dir == NULL) return -1;
+    int first = list->count;
+    struct dirent* entry;
+    char full[4096];
+    while ((entry = readdir(dir)) != NULL) {
+        if (!is_log_name(entry->d_name)) continue;
+        snprintf(full, sizeof(full), "%s/%s", path, entry->d_name);
+        if (path_list_add(list, full) != 0) {
+            closedir(dir);
+            return -1;
+        }
+    }
+    closedir(dir);
+    qsort(list->paths + first, list->count - first, sizeof(char*), compare_paths);
+    return 0;
+}
+
+// Load one log and step every candidate through it
+static void replay_item(void* context, long index) {
+    const ReplayWorker* w = (const ReplayWorker*)context;
+    ReplayFile* f = &w->files[index];
+    ReplayTrace trace;
+
+    double start = now_s();
+    f->status = replay_trace_load(&trace, f->path);
+    f->load_s = now_s() - start;
+    if (f->status != 0) {
+        f->error_line = trace.error_line;
+        return;
+    }
+
+    start = now_s();
+    f->status = replay_run(&trace, w->candidates, w->num_candidates, w->options, f->scores);
+    f->replay_s = now_s() - start;
+    f->rows = trace.rows;
+    replay_trace_free(&trace);
+}
+
+static double rms(double sum_sq, long samples) {
+    return samples > 0 ? sqrt(sum_sq / samples) : 0.0;
+}
+
+static void print_usage(const char* name) {
+    printf("Usage: %s [--threads N] [--plant tau deadband] [--initial-position P] [--warmup S]\n", name);
+    printf("       %*s candidates.txt log.csv|log.hvcl|directory ...\n", (int)strlen(name), "");
+    printf("Example: %s --plant 0.2 0 candidates.txt data\n", name);
+}
+
+int main(int argc, char* argv[])
+{
+    int num_threads = 0; // One per CPU
+    const char* candidates_path = NULL;
+    PathList list = {NULL, 0, 0};
+    ReplayOptions options;
+    replay_options_default(&options);
+
+    for (int i = 1; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+                {
+                    num_threads = atoi(argv[++i]);
+                }
+            else if (strcmp(argv[i], "--plant") == 0 && i + 2 < argc)
+                {
+                    options.plant_model = 1;
+                    options.plant.time_constant = atof(argv[++i]);
+                    options.plant.deadband = atof(argv[++i]);
+                }
+            else if (strcmp(argv[i], "--initial-position") == 0 && i + 1 < argc)
+                {
+                    options.initial_position = atof(argv[++i]);
+                }
+            else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+                {
+                    options.warmup = atof(argv[++i]);
+                }
+            else if (candidates_path == NULL)
+                {
+                    candidates_path = argv[i];
+                }
+            else if (collect_paths(&list, argv[i]) != 0)
+                {
+                    printf("Error reading %s!\n", argv[i]);
+                    return -1;
+                }
+        }
+    if (candidates_path == NULL || list.count == 0)
+        {
+            print_usage(argv[0]);
+            return -1;
+        }
+
+    ReplayCandidate* candidates;
+    int error_line;
+    int num_candidates = replay_load_candidates(candidates_path, &candidates, &error_line);
+    if (num_candidates < 0)
+        {
+            if (error_line > 0) printf("Error in %s line %d!\n", candidates_path, error_line);
+            else printf("Error opening %s!\n", candidates_path);
+            return -1;
+        }
+    num_threads = worker_pool_threads(num_threads, list.count);
+
+    ReplayFile* files = calloc(list.count, sizeof(ReplayFile));
+    ReplayScore* scores = calloc((size_t)list.count * num_candidates, sizeof(ReplayScore));
+    if (files == NULL || scores == NULL)
+        {
+            printf("Error allocating results!\n");
+            return -1;
+        }
+    for (int i = 0; i < list.count; i++)
+        {
+            files[i].path = list.paths[i];
+            files[i].scores = scores + (size_t)i * num_candidates;
+        }
+
+    printf("Replay\n");
+    printf("- Logs: %d on %d threads\n", list.count, num_threads);
+    printf("- Candidates: %d\n", num_candidates);
+    if (options.plant_model)
+        printf("- Mode: plant model (tau %.3f s, deadband %.2f%%)\n\n",
+               options.plant.time_constant, options.plant.deadband);
+    else
+        printf("- Mode: open loop on recorded positions\n\n");
+
+    // Files are handed out one at a time, so long and short logs balance out
+    double start = now_s();
+    ReplayWorker worker = { files, candidates, num_candidates, &options };
+    int used = worker_pool_run(list.count, num_threads, replay_item, &worker);
+    double elapsed = now_s() - start;
+    if (used < num_threads)
+        {
+            printf("Warning: only %d of %d threads started\n\n", used, num_threads);
+        }
+
+    FILE* summary = fopen("replay_summary.csv", "w");
+    if (summary == NULL)
+        {
+            printf("Error opening summary file!\n");
+            return -1;
+        }
+    fprintf(summary, "File,Candidate,Kp,Ki,Kd,Samples,CommandRMS,CommandMean,CommandMax,Saturated,PositionRMS,IAE\n");
+
+    // Per file rows, and totals per candidate over all files
+    ReplayScore* totals = calloc(num_candidates, sizeof(ReplayScore));
+    long total_rows = 0;
+    double load_s = 0.0, replay_s = 0.0;
+    int failures = 0;
+    for (int i = 0; i < list.count; i++)
+        {
+            const ReplayFile* f = &files[i];
+            if (f->status != 0)
+                {
+                    if (f->error_line > 0) printf("Error in %s line %ld!\n", f->path, f->error_line);
+                    else printf("Error reading %s!\n", f->path);
+                    failures++;
+                    continue;
+                }
+            total_rows += f->rows;
+            load_s += f->load_s;
+            replay_s += f->replay_s;
+            for (int c = 0; c < num_candidates; c++)
+                {
+                    const ReplayScore* s = &f->scores[c];
+                    const ReplayCandidate* k = &candidates[c];
+                    replay_score_merge(&totals[c], s);
+                    fprintf(summary, "%s,%s,%.3f,%.3f,%.3f,%ld,%.4f,%.4f,%.4f,%ld,%.4f,%.3f\n",
+                            f->path, k->name, k->kp, k->ki, k->kd, s->samples,
+                            rms(s->command_sq, s->samples),
+                            s->samples ? s->command_abs / s->samples : 0.0,
+                            s->command_max, s->saturated,
+                            rms(s->position_sq, s->samples), s->iae);
+                }
+        }
+    fclose(summary);
+
+    printf("Candidate         Kp      Ki      Kd      Cmd RMS   Cmd Max   Sat(%%)");
+    if (options.plant_model) printf("   Pos RMS   IAE");
+    printf("\n");
+    printf("----------------  ------  ------  ------  --------  --------  ------");
+    if (options.plant_model) printf("  --------  --------");
+    printf("\n");
+    for (int c = 0; c < num_candidates; c++)
+        {
+            const ReplayScore* s = &totals[c];
+            const ReplayCandidate* k = &candidates[c];
+            printf("%-16.16s  %-6.2f  %-6.2f  %-6.3f  %-8.3f  %-8.3f  %-6.1f",
+                   k->name, k->kp, k->ki, k->kd,
+                   rms(s->command_sq, s->samples), s->command_max,
+                   s->samples ? 100.0 * s->saturated / s->samples : 0.0);
+            if (options.plant_model) printf("  %-8.3f  %.3f", rms(s->position_sq, s->samples), s->iae);
+            printf("\n");
+        }
+
+    double steps = (double)total_rows * num_candidates;
+    printf("\nReplayed %ld rows x %d candidates in %.3f s\n", total_rows, num_candidates, elapsed);
+    printf("- Loading: %.3f s, replay: %.3f s (thread time)\n", load_s, replay_s);
+    printf("- %.1f ns per candidate step\n", steps > 0 ? replay_s * 1e9 / steps : 0.0);
+    printf("Summary written to replay_summary.csv\n");
+
+    for (int i = 0; i < list.count; i++) free(list.paths[i]);
+    free(list.paths);
+    free(files);
+    free(scores);
+    free(totals);
+    free(candidates);
+    return failures ? -1 : 0;
+}
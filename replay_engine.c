@@ -0,0 +1,464 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "replay_engine.h"
+#include "pid_bank.h"
+#include "token_parse.h"
+
+#define REPLAY_CHUNK        (1 << 20) // CSV bytes read per fread()
+#define REPLAY_MAX_LINE     4096
+#define REPLAY_LINE_LENGTH  512      // Candidates file
+#define REPLAY_NUMBER_LENGTH 64      // Longest field handed to strtod
+
+// Trace columns kept from a CSV
+enum { REPLAY_TIME, REPLAY_SETPOINT, REPLAY_POSITION, REPLAY_COMMAND, REPLAY_FIELDS };
+static const char* const replay_field_names[REPLAY_FIELDS] = { "Time", "Setpoint", "Position", "Command" };
+
+static const double powers_of_ten[19] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+    1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18
+};
+
+// Parse a plain decimal ("-12.345") in [p, end) without strtod: integer
+// digits into one mantissa, then a single divide by an exact power of ten.
+// Anything else (exponents, inf, very long numbers) goes to strtod through
+// a NUL-terminated copy of the field, since the chunk buffer is not
+// terminated and strtod would skip a newline into the next row.
+// Leading spaces are skipped; an empty field is not a number.
+// Returns the end of the number, or NULL if there is none.
+static const char* parse_number(const char* p, const char* end, double* value) {
+    while (p < end && *p == ' ') p++;
+    const char* start = p;
+    int negative = 0;
+    if (p < end && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int decimals = 0;
+    while (p < end && (unsigned)(*p - '0') < 10) {
+        mantissa = mantissa * 10 + (uint64_t)(*p++ - '0');
+        digits++;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && (unsigned)(*p - '0') < 10) {
+            mantissa = mantissa * 10 + (uint64_t)(*p++ - '0');
+            digits++;
+            decimals++;
+        }
+    }
+
+    if (digits == 0 || digits > 18 || (p < end && (*p == 'e' || *p == 'E'))) {
+        const char* stop = start;
+        while (stop < end && *stop != ',' && *stop != ' ' && *stop != '\r') stop++;
+        size_t length = (size_t)(stop - start);
+        if (length == 0 || length >= REPLAY_NUMBER_LENGTH) return NULL;
+
+        char field[REPLAY_NUMBER_LENGTH];
+        memcpy(field, start, length);
+        field[length] = '\0';
+        char* parsed;
+        *value = strtod(field, &parsed);
+        return (parsed == field) ? NULL : start + (parsed - field);
+    }
+    double v = (double)mantissa / powers_of_ten[decimals];
+    *value = negative ? -v : v;
+    return p;
+}
+
+// Growable columns for a CSV trace, all in one block
+typedef struct {
+    float* block;
+    long rows;
+    long capacity;
+} ReplayColumns;
+
+static int columns_append(ReplayColumns* c, const float* values) {
+    if (c->rows == c->capacity) {
+        long grown = c->capacity ? c->capacity * 2 : 65536;
+        float* block = malloc(sizeof(float) * 3 * (size_t)grown);
+        if (block == NULL) return -1;
+        for (int k = 0; k < 3 && c->block != NULL; k++) {
+            memcpy(block + k * grown, c->block + k * c->capacity, sizeof(float) * c->rows);
+        }
+        free(c->block);
+        c->block = block;
+        c->capacity = grown;
+    }
+    for (int k = 0; k < 3; k++) c->block[k * c->capacity + c->rows] = values[k];
+    c->rows++;
+    return 0;
+}
+
+// Header row: which field holds each trace column (-1 if missing)
+static int parse_header(char* line, int* field_of, int* num_fields) {
+    for (int k = 0; k < REPLAY_FIELDS; k++) field_of[k] = -1;
+    int field = 0;
+    char* save;
+    for (char* name = strtok_r(line, ",\r\n", &save); name != NULL; name = strtok_r(NULL, ",\r\n", &save)) {
+        while (*name == ' ') name++;
+        size_t length = strlen(name);
+        while (length > 0 && name[length - 1] == ' ') name[--length] = '\0';
+        for (int k = 0; k < REPLAY_FIELDS; k++) {
+            if (field_of[k] < 0 && strcmp(name, replay_field_names[k]) == 0) field_of[k] = field;
+        }
+        field++;
+    }
+    *num_fields = field;
+    for (int k = 0; k < REPLAY_FIELDS; k++) {
+        if (field_of[k] < 0) return -1;
+    }
+    return 0;
+}
+
+// One data row; returns 0 on success, -1 on a malformed line
+static int parse_row(const char* p, const char* end, const int* wanted, int num_fields,
+                     double* times, float* values) {
+    for (int field = 0; field < num_fields; field++) {
+        int k = wanted[field];
+        if (k >= 0) {
+            double value;
+            p = parse_number(p, end, &value);
+            if (p == NULL) return -1;
+            while (p < end && *p == ' ') p++;
+            if (k == REPLAY_TIME) *times = value;
+            else values[k - 1] = (float)value;
+        } else {
+            while (p < end && *p != ',') p++;
+        }
+        if (field + 1 < num_fields) {
+            if (p >= end || *p != ',') return -1;
+            p++;
+        }
+    }
+    return (p >= end || *p == '\r') ? 0 : -1;
+}
+
+static int load_csv(ReplayTrace* trace, const char* path) {
+    FILE* in = fopen(path, "r");
+    if (in == NULL) return -1;
+
+    char* buffer = malloc(REPLAY_CHUNK + REPLAY_MAX_LINE + 1);
+    if (buffer == NULL) {
+        fclose(in);
+        return -1;
+    }
+
+    ReplayColumns columns = { NULL, 0, 0 };
+    int field_of[REPLAY_FIELDS];
+    int wanted[REPLAY_MAX_LINE / 2];
+    int num_fields = 0;
+    int have_header = 0;
+    double first_times[2] = { 0.0, 0.0 };
+    long line_number = 0;
+    int status = 0;
+    size_t carry = 0;
+
+    // Chunked read: parse every complete line, carry the partial last one over
+    for (;;) {
+        size_t got = fread(buffer + carry, 1, REPLAY_CHUNK, in);
+        size_t length = carry + got;
+        int at_end = (got == 0);
+        if (at_end && carry > 0 && buffer[length - 1] != '\n') buffer[length++] = '\n';
+        if (length == 0) break;
+
+        char* p = buffer;
+        char* limit = buffer + length;
+        for (;;) {
+            char* newline = memchr(p, '\n', (size_t)(limit - p));
+            if (newline == NULL) break;
+            line_number++;
+            if (newline == p || (newline == p + 1 && *p == '\r')) {
+                p = newline + 1; // Blank line
+                continue;
+            }
+            if (!have_header) {
+                *newline = '\0';
+                if (parse_header(p, field_of, &num_fields) != 0 || num_fields > REPLAY_MAX_LINE / 2) {
+                    line_number = 0;
+                    status = -1;
+                    break;
+                }
+                for (int f = 0; f < num_fields; f++) wanted[f] = -1;
+                for (int k = 0; k < REPLAY_FIELDS; k++) wanted[field_of[k]] = k;
+                have_header = 1;
+            } else {
+                double time = 0.0;
+                float values[3];
+                if (parse_row(p, newline, wanted, num_fields, &time, values) != 0 ||
+                    columns_append(&columns, values) != 0) {
+                    status = -1;
+                    break;
+                }
+                if (columns.rows <= 2) first_times[columns.rows - 1] = time;
+            }
+            p = newline + 1;
+        }
+        if (status != 0) break;
+
+        carry = (size_t)(limit - p);
+        if (carry > REPLAY_MAX_LINE) {
+            line_number++;
+            status = -1; // Line too long
+            break;
+        }
+        memmove(buffer, p, carry);
+        if (at_end) break;
+    }
+    int read_error = ferror(in);
+    fclose(in);
+    free(buffer);
+
+    if (status == 0 && !read_error && (!have_header || columns.rows < 2)) {
+        line_number = 0;
+        status = -1;
+    }
+    if (status != 0 || read_error) {
+        trace->error_line = read_error ? 0 : line_number;
+        free(columns.block);
+        return -1;
+    }
+
+    trace->rows = columns.rows;
+    trace->sample_time = (float)(first_times[1] - first_times[0]);
+    trace->storage = columns.block;
+    trace->setpoint = columns.block;
+    trace->position = columns.block + columns.capacity;
+    trace->command = columns.block + 2 * columns.capacity;
+    return 0;
+}
+
+// Columns used in place from the mapped file
+static int load_column_log(ReplayTrace* trace, const char* path) {
+    if (column_log_open(&trace->log, path) != 0) return -1;
+    trace->mapped = 1;
+
+    const float* columns[3];
+    for (int k = 0; k < 3; k++) {
+        columns[k] = column_log_values(&trace->log, column_log_find(&trace->log, replay_field_names[k + 1]));
+        if (columns[k] == NULL) return -1;
+    }
+    if (trace->log.rows < 2) return -1;
+
+    trace->rows = (long)trace->log.rows;
+    trace->sample_time = (float)(trace->log.time[1] - trace->log.time[0]);
+    trace->setpoint = columns[0];
+    trace->position = columns[1];
+    trace->command = columns[2];
+    return 0;
+}
+
+int replay_trace_load(ReplayTrace* trace, const char* path) {
+    memset(trace, 0, sizeof(ReplayTrace));
+
+    size_t length = strlen(path);
+    int status = (length > 5 && strcmp(path + length - 5, ".hvcl") == 0)
+                     ? load_column_log(trace, path)
+                     : load_csv(trace, path);
+    if (status == 0 && !(trace->sample_time > 0.0f)) status = -1;
+    if (status != 0) {
+        long error_line = trace->error_line;
+        replay_trace_free(trace);
+        trace->error_line = error_line;
+    }
+    return status;
+}
+
+void replay_trace_free(ReplayTrace* trace) {
+    if (trace->mapped) column_log_close(&trace->log);
+    free(trace->storage);
+    memset(trace, 0, sizeof(ReplayTrace));
+}
+
+int replay_load_candidates(const char* path, ReplayCandidate** candidates, int* error_line) {
+    *candidates = NULL;
+    *error_line = 0;
+    FILE* file = fopen(path, "r");
+    if (file == NULL) return -1;
+
+    ReplayCandidate* list = NULL;
+    int count = 0, capacity = 0;
+    char line[REPLAY_LINE_LENGTH];
+    int line_number = 0;
+    int status = 0;
+
+    while (status == 0 && fgets(line, sizeof(line), file) != NULL) {
+        line_number++;
+        char* comment = strchr(line, '#');
+        if (comment != NULL) *comment = '\0';
+
+        char* save;
+        char* name = strtok_r(line, " \t\r\n", &save);
+        if (name == NULL) continue;
+
+        if (count == capacity) {
+            int grown = capacity ? capacity * 2 : 16;
+            ReplayCandidate* more = realloc(list, sizeof(ReplayCandidate) * grown);
+            if (more == NULL) {
+                status = -1;
+                break;
+            }
+            list = more;
+            capacity = grown;
+        }
+
+        // Defaults as pid_init()
+        ReplayCandidate* c = &list[count];
+        memset(c, 0, sizeof(ReplayCandidate));
+        snprintf(c->name, sizeof(c->name), "%s", name);
+        c->filter = 0.1f;
+        if (token_next_number(&save, &c->kp) != 0 ||
+            token_next_number(&save, &c->ki) != 0 ||
+            token_next_number(&save, &c->kd) != 0) {
+            status = -1;
+            break;
+        }
+        float* optional[3] = { &c->filter, &c->rate_limit, &c->ramp_rate };
+        char* token;
+        for (int k = 0; status == 0 && (token = strtok_r(NULL, " \t\r\n", &save)) != NULL; k++) {
+            char* end;
+            if (k == 3) status = -1;
+            else *optional[k] = strtof(token, &end);
+            if (status == 0 && *end != '\0') status = -1;
+        }
+        if (status == 0) count++;
+    }
+    int read_error = ferror(file);
+    fclose(file);
+
+    if (status != 0 || read_error || count == 0) {
+        *error_line = (status != 0) ? line_number : 0;
+        free(list);
+        return -1;
+    }
+    *candidates = list;
+    return count;
+}
+
+void replay_options_default(ReplayOptions* options) {
+    memset(options, 0, sizeof(ReplayOptions));
+    plant_params_default(&options->plant);
+    options->initial_position = 0.0f; // valve_init()
+}
+
+void replay_score_merge(ReplayScore* total, const ReplayScore* part) {
+    total->samples += part->samples;
+    total->command_sq += part->command_sq;
+    total->command_abs += part->command_abs;
+    if (part->command_max > total->command_max) total->command_max = part->command_max;
+    total->position_sq += part->position_sq;
+    total->iae += part->iae;
+    total->saturated += part->saturated;
+}
+
+int replay_run(const ReplayTrace* trace, const ReplayCandidate* candidates, int count,
+               const ReplayOptions* options, ReplayScore* scores) {
+    if (count <= 0 || trace->rows < 1 || !(trace->sample_time > 0.0f)) return -1;
+
+    float dt = trace->sample_time;
+    PIDBank bank;
+    PlantBank plants;
+    if (pid_bank_init(&bank, count) != 0) return -1;
+    if (options->plant_model && plant_bank_init(&plants, count, dt) != 0) {
+        pid_bank_free(&bank);
+        return -1;
+    }
+    float* buffers = malloc(sizeof(float) * 2 * (size_t)count);
+    if (buffers == NULL) {
+        pid_bank_free(&bank);
+        if (options->plant_model) plant_bank_free(&plants);
+        return -1;
+    }
+    float* measurements = buffers;
+    float* outputs = buffers + count;
+
+    // Unknown start: best guess is the first recorded position, but that is
+    // after the step, so row 0 cannot be compared with the recording
+    int known_start = !isnan(options->initial_position);
+    float initial = known_start ? options->initial_position : trace->position[0];
+    for (int i = 0; i < count; i++) {
+        const ReplayCandidate* c = &candidates[i];
+        PIDController pid;
+        pid_init(&pid, c->kp, c->ki, c->kd, dt);
+        pid_set_derivative_filter(&pid, c->filter);
+        pid_set_rate_limit(&pid, c->rate_limit);
+        pid_set_ramp_rate(&pid, c->ramp_rate);
+        pid_set_setpoint(&pid, trace->setpoint[0]);
+        pid_bank_load(&bank, i, &pid);
+
+        if (options->plant_model) {
+            if (plant_bank_configure(&plants, i, &options->plant) != 0) {
+                free(buffers);
+                pid_bank_free(&bank);
+                plant_bank_free(&plants);
+                return -1;
+            }
+            plants.position[i] = initial;
+            plants.backlash_out[i] = initial;
+        }
+    }
+    memset(scores, 0, sizeof(ReplayScore) * count);
+
+    long warmup_rows = lroundf(options->warmup / dt);
+    if (!known_start && warmup_rows < 1) warmup_rows = 1;
+    float last_setpoint = trace->setpoint[0];
+    for (long r = 0; r < trace->rows; r++) {
+        // Recorded setpoint changes reach every candidate (ramped if it ramps)
+        float setpoint = trace->setpoint[r];
+        if (setpoint != last_setpoint) {
+            for (int i = 0; i < count; i++) pid_bank_set_setpoint_ramped(&bank, i, setpoint);
+            last_setpoint = setpoint;
+        }
+
+        // Open loop: the recorded position of the previous row; plant model:
+        // each candidate's own valve before this step
+        const float* seen = measurements;
+        if (options->plant_model) {
+            seen = plants.position;
+        } else {
+            float m = (r == 0) ? initial : trace->position[r - 1];
+            for (int i = 0; i < count; i++) measurements[i] = m;
+        }
+        pid_bank_compute(&bank, seen, outputs, count);
+
+        // Same command clamp as the live loop
+        int scored = r >= warmup_rows;
+        for (int i = 0; i < count; i++) {
+            float command = outputs[i];
+            int clamped = command < 0.0f || command > 100.0f;
+            command = (command < 0.0f) ? 0.0f : command;
+            command = (command > 100.0f) ? 100.0f : command;
+            outputs[i] = command;
+            if (scored) scores[i].saturated += clamped;
+        }
+        if (options->plant_model) plant_bank_update(&plants, outputs, count);
+        if (!scored) continue;
+
+        float recorded = trace->command[r];
+        for (int i = 0; i < count; i++) {
+            float diff = fabsf(outputs[i] - recorded);
+            ReplayScore* s = &scores[i];
+            s->samples++;
+            s->command_sq += (double)diff * diff;
+            s->command_abs += diff;
+            if (diff > s->command_max) s->command_max = diff;
+        }
+        if (options->plant_model) {
+            float position = trace->position[r];
+            for (int i = 0; i < count; i++) {
+                float p = plants.position[i];
+                scores[i].position_sq += (double)(p - position) * (p - position);
+                scores[i].iae += fabsf(bank.setpoint[i] - p) * dt;
+            }
+        }
+    }
+
+    free(buffers);
+    pid_bank_free(&bank);
+    if (options->plant_model) plant_bank_free(&plants);
+    return 0;
+}
@@ -0,0 +1,90 @@
+#ifndef REPLAY_ENGINE_H
+#define REPLAY_ENGINE_H
+
+#include "column_log.h"
+#include "plant_bank.h"
+
+// Offline replay of recorded control logs through candidate controllers
+// A trace is the Setpoint/Position/Command columns of one log. Every
+// candidate becomes one channel of a PIDBank, so each recorded row steps
+// all candidates with one vectorized pid_bank_compute() call.
+//
+// Open-loop mode feeds every candidate the recorded positions and scores
+// how far its commands diverge from the recorded ones. Plant-model mode
+// re-simulates the closed loop: each candidate drives its own PlantBank
+// valve from the recorded setpoint profile, and the resulting positions
+// are compared with the recorded ones as well.
+//
+// Logs are written after the valve update (as main.c does), so the
+// controller at row r saw the position of row r - 1. Row 0 saw the valve
+// before the first step, which the log does not hold: it comes from the
+// options and defaults to 0, where valve_init() starts every valve.
+
+#define REPLAY_NAME_LENGTH 32
+
+// Loaded trace; columns are either mapped from a .hvcl log (zero-copy) or
+// parsed from a CSV into one owned allocation
+typedef struct {
+    long rows;
+    float sample_time;     // Time[1] - Time[0]
+    const float* setpoint;
+    const float* position;
+    const float* command;
+
+    ColumnLog log;         // Mapped log (.hvcl)
+    int mapped;
+    float* storage;        // Parsed columns (CSV)
+    long error_line;       // First bad CSV line when loading fails (0 = I/O or header)
+} ReplayTrace;
+
+// Load a .hvcl log or a CSV with Time, Setpoint, Position and Command
+// columns (any order, other columns ignored); returns 0 on success, -1 on failure
+int replay_trace_load(ReplayTrace* trace, const char* path);
+void replay_trace_free(ReplayTrace* trace);
+
+// One controller configuration to evaluate
+typedef struct {
+    char name[REPLAY_NAME_LENGTH];
+    float kp, ki, kd;
+    float filter;      // Derivative filter coefficient (pid_init() default 0.1)
+    float rate_limit;  // %/s (0 = off)
+    float ramp_rate;   // %/s (0 = off)
+} ReplayCandidate;
+
+// Candidates file: one "<name> <kp> <ki> <kd> [filter [rate_limit [ramp_rate]]]"
+// per line, '#' starts a comment
+// Returns the number of candidates (allocated in *candidates), or -1 with
+// *error_line set (0 = I/O error)
+int replay_load_candidates(const char* path, ReplayCandidate** candidates, int* error_line);
+
+typedef struct {
+    int plant_model;        // 0 = open loop on recorded positions, 1 = re-simulate the valve
+    PlantParams plant;      // Valve for plant-model mode
+    float initial_position; // Position before row 0 (default 0; NAN = unknown, see replay_run())
+    float warmup;           // Seconds at the start left out of the scores
+} ReplayOptions;
+
+void replay_options_default(ReplayOptions* options);
+
+// Scores of one candidate, summed over the scored rows
+typedef struct {
+    long samples;
+    double command_sq;     // Sum of (command - recorded command)^2
+    double command_abs;    // Sum of |command - recorded command|
+    float command_max;     // Largest |command - recorded command|
+    double position_sq;    // Plant model: sum of (position - recorded position)^2
+    double iae;            // Plant model: sum of |setpoint - position| * dt
+    long saturated;        // Commands clamped to 0 or 100%
+} ReplayScore;
+
+// Replay one trace through count candidates; scores[count] are overwritten
+// With an unknown initial position row 0 is stepped from the recorded
+// position of row 0 (after the step) and left out of the scores
+// Returns 0 on success, -1 on bad arguments or allocation failure
+int replay_run(const ReplayTrace* trace, const ReplayCandidate* candidates, int count,
+               const ReplayOptions* options, ReplayScore* scores);
+
+// Add part to total (e.g. the same candidate over several files)
+void replay_score_merge(ReplayScore* total, const ReplayScore* part);
+
+#endif // REPLAY_ENGINE_H
@@ -0,0 +1,81 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+#include <math.h>
+
+// Small, fast, seedable random number generator (xoshiro128+)
+// Each simulation owns its own Rng, so there is no shared state between
+// threads. rng_seed() derives the state from a (seed, stream) pair, so run i
+// of a study gets the same numbers no matter which thread executes it.
+typedef struct {
+    uint32_t s[4];
+    float spare;   // Second Box-Muller value
+    int has_spare;
+} Rng;
+
+// SplitMix64 step, used only to expand the seed into a well-mixed state
+static inline uint64_t rng_splitmix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static inline void rng_seed(Rng* rng, uint64_t seed, uint64_t stream) {
+    uint64_t x = seed ^ rng_splitmix64(&stream);
+    uint64_t a = rng_splitmix64(&x);
+    uint64_t b = rng_splitmix64(&x);
+    rng->s[0] = (uint32_t)a;
+    rng->s[1] = (uint32_t)(a >> 32);
+    rng->s[2] = (uint32_t)b;
+    rng->s[3] = (uint32_t)(b >> 32);
+    if ((rng->s[0] | rng->s[1] | rng->s[2] | rng->s[3]) == 0) rng->s[0] = 1; // All-zero state is invalid
+    rng->has_spare = 0;
+}
+
+static inline uint32_t rng_rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+static inline uint32_t rng_next(Rng* rng) {
+    uint32_t* s = rng->s;
+    uint32_t result = s[0] + s[3];
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 11);
+
+    return result;
+}
+
+// Uniform in [0, 1) from the top 24 bits (the low bits of xoshiro128+ are weak)
+static inline float rng_uniform(Rng* rng) {
+    return (float)(rng_next(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+// Uniform in [min, max)
+static inline float rng_range(Rng* rng, float min, float max) {
+    return min + (max - min) * rng_uniform(rng);
+}
+
+// Standard normal (Box-Muller, values produced in pairs)
+static inline float rng_normal(Rng* rng) {
+    if (rng->has_spare) {
+        rng->has_spare = 0;
+        return rng->spare;
+    }
+    float u1 = 1.0f - rng_uniform(rng); // (0, 1] so logf() is finite
+    float u2 = rng_uniform(rng);
+    float radius = sqrtf(-2.0f * logf(u1));
+    float angle = 6.2831853f * u2;
+    rng->spare = radius * sinf(angle);
+    rng->has_spare = 1;
+    return radius * cosf(angle);
+}
+
+#endif // RNG_H
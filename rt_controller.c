@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <pthread.h>
+#include "pid_controller.h"
+#include "pid_params.h"
+#include "valve_simulator.h"
+#include "rt_executor.h"
+#include "step_profile.h"
+
+// Real-time closed loop: same 50% -> 75% profile as main.c, but each step is
+// released on an absolute deadline and events are keyed to the integer tick
+// Gains can be retuned while it runs by typing
+//   kp ki kd [filter [rate_limit [ramp_rate]]]
+// on stdin; a supervisor thread publishes them and the loop takes them over
+// at the next tick (see pid_params.h)
+typedef struct {
+    PIDController pid;
+    PidParamsExchange params;
+    PidParams published; // Supervisor only: last set it published
+    ValveSimulator valve;
+    uint64_t step_tick;  // Tick of the 50% -> 75% setpoint change
+    float dt;
+} RtControlLoop;
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void handle_signal(int sig) {
+    (void)sig;
+    stop_requested = 1;
+}
+
+// Supervisor: parse parameter lines from stdin and publish them
+static void* supervisor_thread(void* arg) {
+    RtControlLoop* loop = (RtControlLoop*)arg;
+    char line[256];
+    while (fgets(line, sizeof(line), stdin) != NULL) {
+        PidParams params = loop->published;
+        int n = sscanf(line, "%f %f %f %f %f %f", &params.kp, &params.ki, &params.kd,
+                       &params.derivative_filter_coeff, &params.max_rate_of_change,
+                       &params.setpoint_ramp_rate);
+        if (n < 3) {
+            printf("Expected: kp ki kd [filter [rate_limit [ramp_rate]]]\n");
+            continue;
+        }
+        pid_params_publish(&loop->params, &params);
+        loop->published = params;
+        printf("Published Kp=%.2f, Ki=%.2f, Kd=%.3f\n", params.kp, params.ki, params.kd);
+    }
+    return NULL;
+}
+
+static int control_step(void* context, uint64_t tick) {
+    RtControlLoop* loop = (RtControlLoop*)context;
+
+    pid_params_poll(&loop->params, &loop->pid);
+    // Fires once, even if an overrun skipped the exact tick
+    if (tick >= loop->step_tick) {
+        pid_set_setpoint(&loop->pid, STEP_PROFILE_STEP_SETPOINT);
+        loop->step_tick = UINT64_MAX;
+    }
+
+    float control_signal = pid_compute(&loop->pid, valve_get_position(&loop->valve));
+    if (control_signal < 0.0f) control_signal = 0.0f;
+    if (control_signal > 100.0f) control_signal = 100.0f;
+    valve_update(&loop->valve, control_signal, loop->dt);
+
+    return stop_requested;
+}
+
+int main(int argc, char* argv[])
+{
+    // Defaults: 1 kHz for 15 s, no pinning, normal scheduling
+    double rate_hz = 1000.0;
+    double duration = 15.0;
+    int cpu = -1;
+    int priority = 0;
+
+    if (argc >= 2) rate_hz = atof(argv[1]);
+    if (argc >= 3) duration = atof(argv[2]);
+    if (argc >= 4) cpu = atoi(argv[3]);
+    if (argc >= 5) priority = atoi(argv[4]);
+
+    if (rate_hz <= 0.0 || duration <= 0.0)
+        {
+            printf("Usage: %s [rate_hz] [duration_s] [cpu] [fifo_priority]\n", argv[0]);
+            return -1;
+        }
+
+    RtControlLoop loop;
+    loop.dt = (float)(1.0 / rate_hz);
+    loop.step_tick = (uint64_t)(STEP_PROFILE_STEP_TIME * rate_hz + 0.5);
+    pid_init(&loop.pid, STEP_PROFILE_KP, STEP_PROFILE_KI, STEP_PROFILE_KD, loop.dt);
+    pid_set_setpoint(&loop.pid, STEP_PROFILE_INITIAL_SETPOINT);
+    valve_init(&loop.valve, STEP_PROFILE_VALVE_TAU, 0.0f);
+    loop.valve.disturbance = 0.0f;
+    pid_params_exchange_init(&loop.params, &loop.pid);
+    pid_params_get(&loop.pid, &loop.published);
+
+    // Started before the executor pins this thread, so it stays unpinned and
+    // at normal priority; it ends with the process
+    pthread_t supervisor;
+    if (pthread_create(&supervisor, NULL, supervisor_thread, &loop) == 0)
+        {
+            pthread_detach(supervisor);
+        }
+
+    uint64_t period_ns = (uint64_t)(1e9 / rate_hz + 0.5);
+    uint64_t ticks = (uint64_t)(duration * rate_hz + 0.5);
+
+    RtExecutor exec;
+    if (rt_executor_init(&exec, period_ns, cpu, priority) != 0)
+        {
+            printf("Warning: could not apply CPU pinning / SCHED_FIFO (need privileges?)\n");
+        }
+
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
+
+    printf("Real-Time Valve Control Loop\n");
+    printf("- Rate: %.1f Hz (period %.3f us)\n", rate_hz, period_ns / 1000.0);
+    printf("- Duration: %.1f s (%llu ticks)\n", duration, (unsigned long long)ticks);
+    printf("- CPU: %d, SCHED_FIFO priority: %d\n", cpu, priority);
+    printf("- Retune: type \"kp ki kd [filter [rate_limit [ramp_rate]]]\" and Enter\n");
+
+    if (rt_executor_run(&exec, control_step, &loop, ticks) != 0)
+        {
+            printf("Error: clock_nanosleep failed!\n");
+            return -1;
+        }
+
+    printf("\nFinal Position: %.1f%%\n", loop.valve.position);
+    printf("Final Error: %.1f%%\n", loop.pid.setpoint - loop.valve.position);
+    printf("Parameter sets applied: %llu\n", (unsigned long long)loop.params.applied);
+    rt_executor_dump(&exec, stdout);
+
+    return exec.deadline_misses > 0 ? 1 : 0;
+}
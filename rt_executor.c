@@ -0,0 +1,168 @@
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include "rt_executor.h"
+
+#define NSEC_PER_SEC 1000000000ull
+
+static uint64_t timespec_to_ns(const struct timespec* ts) {
+    return (uint64_t)ts->tv_sec * NSEC_PER_SEC + (uint64_t)ts->tv_nsec;
+}
+
+static struct timespec ns_to_timespec(uint64_t ns) {
+    struct timespec ts;
+    ts.tv_sec = (time_t)(ns / NSEC_PER_SEC);
+    ts.tv_nsec = (long)(ns % NSEC_PER_SEC);
+    return ts;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return timespec_to_ns(&ts);
+}
+
+void rt_histogram_reset(RtHistogram* hist) {
+    memset(hist, 0, sizeof(*hist));
+    hist->min_ns = UINT64_MAX;
+}
+
+// Record one sample - constant time, no allocation
+void rt_histogram_add(RtHistogram* hist, uint64_t ns) {
+    int bucket = 0;
+    if (ns > 0) bucket = 63 - __builtin_clzll(ns);
+    if (bucket >= RT_HIST_BUCKETS) bucket = RT_HIST_BUCKETS - 1;
+
+    hist->buckets[bucket]++;
+    hist->count++;
+    hist->sum_ns += ns;
+    if (ns < hist->min_ns) hist->min_ns = ns;
+    if (ns > hist->max_ns) hist->max_ns = ns;
+}
+
+// Upper bound of the bucket holding the given quantile
+static uint64_t rt_histogram_quantile(const RtHistogram* hist, double q) {
+    uint64_t target = (uint64_t)(q * (double)hist->count);
+    uint64_t seen = 0;
+    for (int b = 0; b < RT_HIST_BUCKETS; b++) {
+        seen += hist->buckets[b];
+        if (seen > target) {
+            uint64_t upper = 2ull << b;
+            return upper < hist->max_ns ? upper : hist->max_ns;
+        }
+    }
+    return hist->max_ns;
+}
+
+void rt_histogram_print(const RtHistogram* hist, const char* name, FILE* out) {
+    fprintf(out, "%s (%llu samples)\n", name, (unsigned long long)hist->count);
+    if (hist->count == 0) return;
+
+    fprintf(out, "  min %.3f us  mean %.3f us  max %.3f us\n",
+            hist->min_ns / 1000.0,
+            (double)hist->sum_ns / (double)hist->count / 1000.0,
+            hist->max_ns / 1000.0);
+    fprintf(out, "  p50 <= %.3f us  p99 <= %.3f us  p99.9 <= %.3f us\n",
+            rt_histogram_quantile(hist, 0.50) / 1000.0,
+            rt_histogram_quantile(hist, 0.99) / 1000.0,
+            rt_histogram_quantile(hist, 0.999) / 1000.0);
+
+    fprintf(out, "  Range (us)              Count\n");
+    for (int b = 0; b < RT_HIST_BUCKETS; b++) {
+        if (hist->buckets[b] == 0) continue;
+        uint64_t lo = (b == 0) ? 0 : (1ull << b);
+        uint64_t hi = 2ull << b;
+        fprintf(out, "  %9.3f - %-9.3f  %llu\n",
+                lo / 1000.0, hi / 1000.0, (unsigned long long)hist->buckets[b]);
+    }
+}
+
+// Configure executor and apply real-time settings to the calling thread
+int rt_executor_init(RtExecutor* exec, uint64_t period_ns, int cpu, int priority) {
+    int status = 0;
+
+    exec->period_ns = period_ns;
+    exec->cpu = cpu;
+    exec->priority = priority;
+    exec->tick = 0;
+    exec->deadline_misses = 0;
+    exec->skipped_periods = 0;
+    rt_histogram_reset(&exec->wake_latency);
+    rt_histogram_reset(&exec->compute_time);
+
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0) status = -1;
+    }
+
+    if (priority > 0) {
+        // Avoid page faults inside the loop
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) status = -1;
+
+        struct sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = priority;
+        if (sched_setscheduler(0, SCHED_FIFO, &param) != 0) status = -1;
+    }
+
+    return status;
+}
+
+// Periodic loop on absolute deadlines
+// Wake-up latency is measured against the scheduled release; a step that
+// finishes after the next release is a deadline miss, and releases that are
+// already in the past are skipped so the loop re-aligns instead of bursting.
+// Skipped releases still advance the tick, so tick always names the release.
+int rt_executor_run(RtExecutor* exec, RtStepFunction step, void* context, uint64_t max_ticks) {
+    uint64_t release = now_ns() + exec->period_ns;
+
+    while (max_ticks == 0 || exec->tick < max_ticks) {
+        struct timespec wake = ns_to_timespec(release);
+        int status;
+        while ((status = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL)) == EINTR) {
+            // Interrupted by a signal - sleep again until the same deadline
+        }
+        if (status != 0) return -1;
+
+        uint64_t start = now_ns();
+        rt_histogram_add(&exec->wake_latency, start > release ? start - release : 0);
+
+        int stop = step(context, exec->tick);
+
+        uint64_t end = now_ns();
+        rt_histogram_add(&exec->compute_time, end - start);
+        exec->tick++;
+
+        release += exec->period_ns;
+        if (end > release) {
+            exec->deadline_misses++;
+            uint64_t late = (end - release) / exec->period_ns + 1;
+            exec->skipped_periods += late;
+            exec->tick += late;
+            release += late * exec->period_ns;
+        }
+
+        if (stop) break;
+    }
+    return 0;
+}
+
+void rt_executor_dump(const RtExecutor* exec, FILE* out) {
+    fprintf(out, "\n=== Real-Time Executor Statistics ===\n");
+    fprintf(out, "Period: %.3f us (%.1f Hz)\n",
+            exec->period_ns / 1000.0, 1e9 / (double)exec->period_ns);
+    fprintf(out, "CPU: %d  SCHED_FIFO priority: %d\n", exec->cpu, exec->priority);
+    fprintf(out, "Ticks: %llu  Deadline misses: %llu  Skipped periods: %llu\n\n",
+            (unsigned long long)exec->tick,
+            (unsigned long long)exec->deadline_misses,
+            (unsigned long long)exec->skipped_periods);
+    rt_histogram_print(&exec->wake_latency, "Wake-up latency", out);
+    fprintf(out, "\n");
+    rt_histogram_print(&exec->compute_time, "Compute time", out);
+}
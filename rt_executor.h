@@ -0,0 +1,59 @@
+#ifndef RT_EXECUTOR_H
+#define RT_EXECUTOR_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Log2 histogram of durations in nanoseconds
+// Bucket k counts samples in [2^k, 2^(k+1)) ns; bucket 0 also holds 0 ns
+#define RT_HIST_BUCKETS 40
+
+typedef struct {
+    uint64_t count;
+    uint64_t min_ns;
+    uint64_t max_ns;
+    uint64_t sum_ns;
+    uint64_t buckets[RT_HIST_BUCKETS];
+} RtHistogram;
+
+// Called once per release; return nonzero to stop the executor
+// tick is the release index, which jumps after an overrun skips periods,
+// so events should fire on tick >= their tick rather than on equality
+typedef int (*RtStepFunction)(void* context, uint64_t tick);
+
+// Periodic executor driven by absolute deadlines
+// Each release time is start + tick * period, so there is no accumulated
+// drift regardless of how long a step takes. Releases skipped after an
+// overrun still count as ticks, so the contract holds across overruns.
+typedef struct {
+    // Configuration
+    uint64_t period_ns; // Loop period
+    int cpu;            // CPU to pin to (-1 = no pinning)
+    int priority;       // SCHED_FIFO priority (0 = normal scheduling)
+
+    // Statistics
+    uint64_t tick;            // Periods elapsed (steps executed + skipped_periods)
+    uint64_t deadline_misses; // Steps that finished after the next release
+    uint64_t skipped_periods; // Releases dropped to re-align after an overrun
+    RtHistogram wake_latency; // Actual wake-up minus scheduled release
+    RtHistogram compute_time; // Time spent in the step function
+} RtExecutor;
+
+// Configure executor and apply CPU pinning / SCHED_FIFO to the calling thread
+// Returns 0 on success, -1 if pinning or priority could not be applied
+// (the executor still runs, just without those guarantees)
+int rt_executor_init(RtExecutor* exec, uint64_t period_ns, int cpu, int priority);
+
+// Run step every period until it returns nonzero or max_ticks periods have
+// elapsed (0 = no limit)
+// Returns 0 when stopped, -1 if the clock could not be slept on
+int rt_executor_run(RtExecutor* exec, RtStepFunction step, void* context, uint64_t max_ticks);
+
+// Print latency / compute histograms and deadline statistics
+void rt_executor_dump(const RtExecutor* exec, FILE* out);
+
+void rt_histogram_reset(RtHistogram* hist);
+void rt_histogram_add(RtHistogram* hist, uint64_t ns);
+void rt_histogram_print(const RtHistogram* hist, const char* name, FILE* out);
+
+#endif // RT_EXECUTOR_H
@@ -0,0 +1,338 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "scenario.h"
+#include "token_parse.h"
+
+#define LINE_LENGTH 512
+
+typedef struct {
+    const char* name;
+    ScenarioEventType type;
+    int num_args;
+} ScenarioAction;
+
+static const ScenarioAction actions[SCENARIO_EVENT_TYPES] = {
+    {"setpoint",    SCENARIO_SETPOINT,    1},
+    {"ramp",        SCENARIO_RAMP,        1},
+    {"ramp_rate",   SCENARIO_RAMP_RATE,   1},
+    {"gains",       SCENARIO_GAINS,       3},
+    {"filter",      SCENARIO_FILTER,      1},
+    {"rate_limit",  SCENARIO_RATE_LIMIT,  1},
+    {"disturbance", SCENARIO_DISTURBANCE, 1},
+    {"noise",       SCENARIO_NOISE,       1}
+};
+
+static const ScenarioAction* find_action(const char* name) {
+    for (int i = 0; i < SCENARIO_EVENT_TYPES; i++) {
+        if (strcmp(actions[i].name, name) == 0) return &actions[i];
+    }
+    return NULL;
+}
+
+// Next token as a non-negative decimal integer (full 64-bit range)
+static int next_seed(char** save, uint64_t* value) {
+    char* token = strtok_r(NULL, " \t\r\n", save);
+    if (token == NULL || *token < '0' || *token > '9') return -1;
+    char* end;
+    errno = 0;
+    unsigned long long parsed = strtoull(token, &end, 10);
+    if (*end != '\0' || errno == ERANGE) return -1;
+    *value = (uint64_t)parsed;
+    return 0;
+}
+
+// Same defaults as main.c
+static void scenario_defaults(Scenario* scenario, const char* path) {
+    memset(scenario, 0, sizeof(Scenario));
+
+    // Name defaults to the file name without directory and extension
+    const char* base = strrchr(path, '/');
+    base = (base != NULL) ? base + 1 : path;
+    strncpy(scenario->name, base, SCENARIO_NAME_LENGTH - 1);
+    char* dot = strrchr(scenario->name, '.');
+    if (dot != NULL && dot != scenario->name) *dot = '\0';
+
+    scenario->sample_time = 0.01f;
+    scenario->kp = 5.0f;
+    scenario->ki = 4.0f;
+    scenario->kd = 0.1f;
+    scenario->derivative_filter = 0.1f; // pid_init() default
+    scenario->valve_time_constant = 0.2f;
+    scenario->seed = 1;
+}
+
+// Initial configuration line (no "at"); a ramp needs a time to start from
+static int scenario_set_initial(Scenario* scenario, ScenarioEventType type, const float* args) {
+    switch (type) {
+    case SCENARIO_SETPOINT:    scenario->setpoint = args[0]; break;
+    case SCENARIO_RAMP_RATE:   scenario->ramp_rate = args[0]; break;
+    case SCENARIO_FILTER:      scenario->derivative_filter = args[0]; break;
+    case SCENARIO_RATE_LIMIT:  scenario->rate_limit = args[0]; break;
+    case SCENARIO_DISTURBANCE: scenario->disturbance = args[0]; break;
+    case SCENARIO_NOISE:       scenario->noise = args[0]; break;
+    case SCENARIO_GAINS:
+        scenario->kp = args[0];
+        scenario->ki = args[1];
+        scenario->kd = args[2];
+        break;
+    default:
+        return -1;
+    }
+    return 0;
+}
+
+// Append an event; times[] runs parallel to the table until compiled
+static int scenario_add_event(Scenario* scenario, float** times, int* capacity,
+                              ScenarioEventType type, int line, float time, const float* args) {
+    if (scenario->num_events == *capacity) {
+        int grown = *capacity ? *capacity * 2 : 16;
+        ScenarioEvent* events = realloc(scenario->events, sizeof(ScenarioEvent) * grown);
+        if (events == NULL) return -1;
+        scenario->events = events;
+        float* more_times = realloc(*times, sizeof(float) * grown);
+        if (more_times == NULL) return -1;
+        *times = more_times;
+        *capacity = grown;
+    }
+    ScenarioEvent* event = &scenario->events[scenario->num_events];
+    event->type = type;
+    event->line = line;
+    memcpy(event->args, args, sizeof(event->args));
+    (*times)[scenario->num_events++] = time;
+    return 0;
+}
+
+// Events are ordered by tick, then by line so same-tick events apply in file order
+static int compare_events(const void* a, const void* b) {
+    const ScenarioEvent* ea = (const ScenarioEvent*)a;
+    const ScenarioEvent* eb = (const ScenarioEvent*)b;
+    if (ea->tick != eb->tick) return (ea->tick < eb->tick) ? -1 : 1;
+    return ea->line - eb->line;
+}
+
+int scenario_load(Scenario* scenario, const char* path) {
+    scenario_defaults(scenario, path);
+
+    FILE* file = fopen(path, "r");
+    if (file == NULL) return -1;
+
+    // Event times are kept in seconds until sample_time is known
+    float duration = 10.0f;
+    float* times = NULL;
+    int capacity = 0;
+    char line[LINE_LENGTH];
+    char* save; // strtok_r state: scenarios may be loaded on several threads
+    int line_number = 0;
+    int status = 0;
+
+    while (status == 0 && fgets(line, sizeof(line), file) != NULL) {
+        line_number++;
+        char* comment = strchr(line, '#');
+        if (comment != NULL) *comment = '\0';
+
+        char* keyword = strtok_r(line, " \t\r\n", &save);
+        if (keyword == NULL) continue; // Blank or comment-only line
+
+        if (strcmp(keyword, "name") == 0) {
+            char* name = strtok_r(NULL, "\r\n", &save);
+            while (name != NULL && (*name == ' ' || *name == '\t')) name++;
+            if (name == NULL || *name == '\0') {
+                status = -1;
+            } else {
+                size_t length = strlen(name);
+                while (length > 0 && (name[length - 1] == ' ' || name[length - 1] == '\t')) length--;
+                if (length >= SCENARIO_NAME_LENGTH) length = SCENARIO_NAME_LENGTH - 1;
+                memcpy(scenario->name, name, length);
+                scenario->name[length] = '\0';
+            }
+        } else if (strcmp(keyword, "duration") == 0) {
+            if (token_next_number(&save, &duration) != 0 || duration <= 0.0f) status = -1;
+        } else if (strcmp(keyword, "sample_time") == 0) {
+            if (token_next_number(&save, &scenario->sample_time) != 0 ||
+                scenario->sample_time <= 0.0f) status = -1;
+        } else if (strcmp(keyword, "valve") == 0) {
+            if (token_next_number(&save, &scenario->valve_time_constant) != 0 ||
+                token_next_number(&save, &scenario->valve_deadband) != 0 ||
+                scenario->valve_time_constant <= 0.0f) status = -1;
+        } else if (strcmp(keyword, "seed") == 0) {
+            if (next_seed(&save, &scenario->seed) != 0) status = -1;
+        } else if (strcmp(keyword, "schedule") == 0) {
+            char* input = strtok_r(NULL, " \t\r\n", &save);
+            if (input != NULL && strcmp(input, "position") == 0) scenario->schedule_input = GAIN_SCHEDULE_MEASUREMENT;
+            else if (input != NULL && strcmp(input, "setpoint") == 0) scenario->schedule_input = GAIN_SCHEDULE_SETPOINT;
+            else status = -1;
+        } else if (strcmp(keyword, "gain_point") == 0) {
+            GainPoint* point = &scenario->gain_points[scenario->num_gain_points];
+            if (scenario->num_gain_points == SCENARIO_MAX_GAIN_POINTS ||
+                token_next_number(&save, &point->x) != 0 ||
+                token_next_number(&save, &point->kp) != 0 ||
+                token_next_number(&save, &point->ki) != 0 ||
+                token_next_number(&save, &point->kd) != 0 ||
+                !(point->ki > 0.0f) || // gain_schedule_init() needs integral action
+                (scenario->num_gain_points > 0 && !(point->x > point[-1].x))) status = -1;
+            else scenario->num_gain_points++;
+        } else {
+            // "[at <seconds>] <action> <args>"
+            int timed = (strcmp(keyword, "at") == 0);
+            float time = 0.0f;
+            if (timed) {
+                if (token_next_number(&save, &time) != 0 || time < 0.0f) {
+                    status = -1;
+                    break;
+                }
+                keyword = strtok_r(NULL, " \t\r\n", &save);
+            }
+
+            const ScenarioAction* action = (keyword != NULL) ? find_action(keyword) : NULL;
+            float args[3] = {0.0f, 0.0f, 0.0f};
+            if (action == NULL) {
+                status = -1;
+                break;
+            }
+            for (int i = 0; i < action->num_args && status == 0; i++) {
+                if (token_next_number(&save, &args[i]) != 0) status = -1;
+            }
+            if (status != 0) break;
+
+            if (timed) status = scenario_add_event(scenario, &times, &capacity, action->type,
+                                                   line_number, time, args);
+            else status = scenario_set_initial(scenario, action->type, args);
+        }
+
+        // Anything left on the line is an error too
+        if (status == 0 && strtok_r(NULL, " \t\r\n", &save) != NULL) status = -1;
+    }
+    int read_error = ferror(file);
+    fclose(file);
+
+    // Compile: seconds to ticks, then sort
+    scenario->total_ticks = lroundf(duration / scenario->sample_time);
+    for (int i = 0; status == 0 && i < scenario->num_events; i++) {
+        scenario->events[i].tick = lroundf(times[i] / scenario->sample_time);
+        if (scenario->events[i].tick >= scenario->total_ticks) {
+            line_number = scenario->events[i].line; // Event after the end
+            status = -1;
+        }
+    }
+    free(times);
+
+    if (status != 0 || read_error) {
+        scenario->error_line = read_error ? 0 : line_number;
+        free(scenario->events);
+        scenario->events = NULL;
+        scenario->num_events = 0;
+        return -1;
+    }
+
+    qsort(scenario->events, scenario->num_events, sizeof(ScenarioEvent), compare_events);
+
+    // Gain points to an evenly spaced table over the stroke
+    if (scenario->num_gain_points > 0 &&
+        gain_schedule_init(&scenario->schedule, scenario->schedule_input, 0.0f, 100.0f,
+                           SCENARIO_SCHEDULE_SIZE, scenario->gain_points, scenario->num_gain_points) != 0) {
+        scenario->error_line = 0;
+        scenario_free(scenario);
+        return -1;
+    }
+    return 0;
+}
+
+void scenario_free(Scenario* scenario) {
+    free(scenario->events);
+    scenario->events = NULL;
+    scenario->num_events = 0;
+    if (scenario->num_gain_points > 0) gain_schedule_free(&scenario->schedule);
+    scenario->num_gain_points = 0;
+}
+
+void scenario_runner_init(ScenarioRunner* runner, const Scenario* scenario) {
+    memset(runner, 0, sizeof(ScenarioRunner));
+    runner->scenario = scenario;
+
+    pid_init(&runner->pid, scenario->kp, scenario->ki, scenario->kd, scenario->sample_time);
+    pid_set_derivative_filter(&runner->pid, scenario->derivative_filter);
+    pid_set_rate_limit(&runner->pid, scenario->rate_limit);
+    pid_set_ramp_rate(&runner->pid, scenario->ramp_rate);
+    pid_set_setpoint(&runner->pid, scenario->setpoint);
+
+    valve_init(&runner->valve, scenario->valve_time_constant, scenario->valve_deadband);
+    runner->valve.disturbance = scenario->disturbance;
+    runner->noise = scenario->noise;
+    rng_seed(&runner->rng, scenario->seed, 0);
+
+    // +/-1% settling band, 95% rise time, command saturates at 0% / 100%
+    step_metrics_init(&runner->metrics, 0.01f, 0.95f, 0.0f, 100.0f);
+    runner->worst_settling_time = 0.0f;
+}
+
+static void scenario_apply(ScenarioRunner* runner, const ScenarioEvent* event) {
+    const float* a = event->args;
+    switch (event->type) {
+    case SCENARIO_SETPOINT:    pid_set_setpoint(&runner->pid, a[0]); break;
+    case SCENARIO_RAMP:        pid_set_setpoint_ramped(&runner->pid, a[0]); break;
+    case SCENARIO_RAMP_RATE:   pid_set_ramp_rate(&runner->pid, a[0]); break;
+    case SCENARIO_GAINS:       pid_set_gains(&runner->pid, a[0], a[1], a[2]); break;
+    case SCENARIO_FILTER:      pid_set_derivative_filter(&runner->pid, a[0]); break;
+    case SCENARIO_RATE_LIMIT:  pid_set_rate_limit(&runner->pid, a[0]); break;
+    case SCENARIO_DISTURBANCE: runner->valve.disturbance = a[0]; break;
+    case SCENARIO_NOISE:       runner->noise = a[0]; break;
+    default: break;
+    }
+}
+
+// Add the metrics of the step that just ended to the whole-run summary
+static void scenario_fold_step(ScenarioRunner* runner) {
+    const StepMetrics* m = &runner->metrics;
+    runner->steps++;
+    runner->total_iae += m->iae;
+    if (m->overshoot > runner->worst_overshoot) runner->worst_overshoot = m->overshoot;
+    if (m->settling_time < 0.0f) runner->unsettled_steps++;
+    else if (m->settling_time > runner->worst_settling_time) runner->worst_settling_time = m->settling_time;
+}
+
+// Events due at this tick are at the head of the table, so finding them is
+// one comparison per step plus one per event
+int scenario_runner_step(ScenarioRunner* runner) {
+    const Scenario* scenario = runner->scenario;
+    if (runner->tick >= scenario->total_ticks) return 0;
+
+    runner->events_applied = 0;
+    while (runner->next_event < scenario->num_events &&
+           scenario->events[runner->next_event].tick == runner->tick) {
+        scenario_apply(runner, &scenario->events[runner->next_event++]);
+        runner->events_applied++;
+    }
+
+    // A new setpoint target restarts the metrics below; keep the old step first
+    if (runner->pid.setpoint_target != runner->metrics.target && runner->metrics.samples > 0) {
+        scenario_fold_step(runner);
+    }
+
+    runner->time = runner->tick * scenario->sample_time;
+    runner->measurement = runner->valve.position;
+    if (runner->noise > 0.0f) runner->measurement += runner->noise * rng_normal(&runner->rng);
+
+    // Scheduled gains for this operating point, switched bumplessly
+    if (scenario->num_gain_points > 0) {
+        gain_schedule_apply(&scenario->schedule, &runner->pid, runner->measurement);
+    }
+
+    float command = pid_compute(&runner->pid, runner->measurement);
+    if (command < 0.0f || command > 100.0f) {
+        command = command < 0.0f ? 0.0f : 100.0f;
+        PID_STAT_INC(&runner->pid, actuator_clamps);
+    }
+    runner->command = command;
+
+    step_metrics_update(&runner->metrics, &runner->pid, runner->measurement, command);
+    valve_update(&runner->valve, command, scenario->sample_time);
+
+    runner->tick++;
+    if (runner->tick == scenario->total_ticks) scenario_fold_step(runner);
+    return 1;
+}
@@ -0,0 +1,124 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <stdint.h>
+#include "pid_controller.h"
+#include "valve_simulator.h"
+#include "step_metrics.h"
+#include "rng.h"
+#include "gain_schedule.h"
+
+// Declarative test scenarios (.scn)
+// A scenario is a text file: lines without "at" set the initial
+// configuration, "at <seconds> <action> <args>" lines schedule an event.
+//
+//   name baseline                # Shown in reports
+//   duration 15                  # Seconds
+//   sample_time 0.01             # Seconds per step
+//   valve 0.2 0                  # Time constant (s), deadband (%)
+//   seed 42                      # Sensor noise generator seed
+//   gains 5 4 0.1                # kp ki kd
+//   setpoint 50                  # Also: filter, rate_limit, ramp_rate,
+//                                #       disturbance, noise
+//   at 5 setpoint 75             # Step change
+//   at 5 ramp 75                 # Ramped change (at the ramp_rate)
+//   at 8 disturbance 5           # Also: gains, filter, rate_limit,
+//   at 9 noise 0.2               #       ramp_rate (same arguments as above)
+//   schedule position            # Gain schedule indexed by position or setpoint,
+//   gain_point 10 6 5 0.1        # built from "gain_point <x> <kp> <ki> <kd>"
+//   gain_point 90 3 2 0.05       # lines (x increasing); replaces "gains"
+//
+// Loading compiles the events into a table sorted by integer tick, so the
+// runner applies them by comparing one tick counter per step: no float time
+// comparisons and no searching.
+
+#define SCENARIO_NAME_LENGTH 64
+#define SCENARIO_MAX_GAIN_POINTS 16
+#define SCENARIO_SCHEDULE_SIZE 101 // Table entries over 0-100% (1% apart)
+
+typedef enum {
+    SCENARIO_SETPOINT = 0,  // Setpoint step
+    SCENARIO_RAMP,          // Ramped setpoint change
+    SCENARIO_RAMP_RATE,     // Setpoint ramp rate (%/s)
+    SCENARIO_GAINS,         // kp ki kd
+    SCENARIO_FILTER,        // Derivative filter coefficient
+    SCENARIO_RATE_LIMIT,    // Output rate limit (%/s)
+    SCENARIO_DISTURBANCE,   // Valve disturbance (%)
+    SCENARIO_NOISE,         // Sensor noise standard deviation (%)
+    SCENARIO_EVENT_TYPES
+} ScenarioEventType;
+
+typedef struct {
+    long tick;                // Step the event applies before
+    ScenarioEventType type;
+    int line;                 // Source line (keeps same-tick events in file order)
+    float args[3];
+} ScenarioEvent;
+
+typedef struct {
+    char name[SCENARIO_NAME_LENGTH];
+    float sample_time;
+    long total_ticks;
+
+    // Initial configuration
+    float kp, ki, kd;
+    float setpoint;
+    float derivative_filter;
+    float rate_limit;
+    float ramp_rate;
+    float valve_time_constant;
+    float valve_deadband;
+    float disturbance;
+    float noise;
+    uint64_t seed;
+
+    // Gain schedule (used when num_gain_points > 0)
+    GainScheduleInput schedule_input;
+    GainPoint gain_points[SCENARIO_MAX_GAIN_POINTS];
+    int num_gain_points;
+    GainSchedule schedule; // Table compiled from the points
+
+    // Compiled event table, sorted by tick
+    ScenarioEvent* events;
+    int num_events;
+
+    int error_line; // Line of the first error when loading fails (0 = I/O error)
+} Scenario;
+
+// Parse and compile a scenario file (returns 0 on success, -1 on failure)
+int scenario_load(Scenario* scenario, const char* path);
+
+void scenario_free(Scenario* scenario);
+
+// Executes one scenario: valve, controller, sensor noise and step metrics
+typedef struct {
+    const Scenario* scenario;
+    PIDController pid;
+    ValveSimulator valve;
+    StepMetrics metrics;
+    Rng rng;
+    float noise;
+
+    long tick;          // Next step to run
+    int next_event;     // Next entry of the event table
+    int events_applied; // Events applied by the last step
+
+    // Last step
+    float time;
+    float measurement;  // Position seen by the controller (with noise)
+    float command;      // Clamped command sent to the valve
+
+    // Whole run: every setpoint step is scored, the worst one kept
+    int steps;
+    int unsettled_steps;
+    float worst_overshoot;
+    float worst_settling_time;
+    double total_iae;
+} ScenarioRunner;
+
+void scenario_runner_init(ScenarioRunner* runner, const Scenario* scenario);
+
+// Run one control step (returns 1 if a step ran, 0 once the scenario is over)
+int scenario_runner_step(ScenarioRunner* runner);
+
+#endif // SCENARIO_H
@@ -0,0 +1,210 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <time.h>
+#include "scenario.h"
+#include "worker_pool.h"
+
+// Run many scenario files in one process
+// Usage: scenario_batch [--threads N] file.scn|directory ...
+// Directories contribute every *.scn file in them. Each scenario is loaded,
+// compiled and run on a worker thread; one summary row per scenario goes to
+// scenario_summary.csv.
+
+typedef struct {
+    const char* path;
+    char name[SCENARIO_NAME_LENGTH];
+    int status;           // 0 = ran, -1 = failed to load
+    int error_line;
+    long ticks;
+    int events;
+    int steps;
+    int unsettled_steps;
+    float worst_overshoot;
+    float worst_settling_time;
+    double total_iae;
+    float final_error;
+} BatchResult;
+
+
+typedef struct {
+    char** paths;
+    int count;
+    int capacity;
+} PathList;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int path_list_add(PathList* list, const char* path) {
+    if (list->count == list->capacity) {
+        int grown = list->capacity ? list->capacity * 2 : 64;
+        char** paths = realloc(list->paths, sizeof(char*) * grown);
+        if (paths == NULL) return -1;
+        list->paths = paths;
+        list->capacity = grown;
+    }
+    list->paths[list->count] = strdup(path);
+    return (list->paths[list->count++] != NULL) ? 0 : -1;
+}
+
+static int compare_paths(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+// A file is taken as given; a directory adds its *.scn files in name order
+static int collect_paths(PathList* list, const char* path) {
+    struct stat info;
+    if (stat(path, &info) != 0 || !S_ISDIR(info.st_mode)) return path_list_add(list, path);
+
+    DIR* dir = opendir(path);
+    if (dir == NULL) return -1;
+    int first = list->count;
+    struct dirent* entry;
+    char full[4096];
+    while ((entry = readdir(dir)) != NULL) {
+        size_t length = strlen(entry->d_name);
+        if (length < 5 || strcmp(entry->d_name + length - 4, ".scn") != 0) continue;
+        snprintf(full, sizeof(full), "%s/%s", path, entry->d_name);
+        if (path_list_add(list, full) != 0) {
+            closedir(dir);
+            return -1;
+        }
+    }
+    closedir(dir);
+    qsort(list->paths + first, list->count - first, sizeof(char*), compare_paths);
+    return 0;
+}
+
+static void run_one(BatchResult* r) {
+    Scenario scenario;
+    ScenarioRunner runner;
+
+    r->status = scenario_load(&scenario, r->path);
+    memcpy(r->name, scenario.name, SCENARIO_NAME_LENGTH);
+    if (r->status != 0) {
+        r->error_line = scenario.error_line;
+        return;
+    }
+
+    scenario_runner_init(&runner, &scenario);
+    while (scenario_runner_step(&runner)) {
+        // Everything is scored inside the runner
+    }
+
+    r->ticks = scenario.total_ticks;
+    r->events = scenario.num_events;
+    r->steps = runner.steps;
+    r->unsettled_steps = runner.unsettled_steps;
+    r->worst_overshoot = runner.worst_overshoot;
+    r->worst_settling_time = runner.worst_settling_time;
+    r->total_iae = runner.total_iae;
+    r->final_error = runner.pid.setpoint_target - runner.valve.position;
+    scenario_free(&scenario);
+}
+
+static void batch_item(void* context, long index) {
+    run_one(&((BatchResult*)context)[index]);
+}
+
+static void print_usage(const char* name) {
+    printf("Usage: %s [--threads N] file.scn|directory ...\n", name);
+    printf("Example: %s scenarios\n", name);
+}
+
+int main(int argc, char* argv[])
+{
+    int num_threads = 0; // One per CPU
+    PathList list = {NULL, 0, 0};
+
+    for (int i = 1; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+                {
+                    num_threads = atoi(argv[++i]);
+                }
+            else if (collect_paths(&list, argv[i]) != 0)
+                {
+                    printf("Error reading %s!\n", argv[i]);
+                    return -1;
+                }
+        }
+    if (list.count == 0)
+        {
+            print_usage(argv[0]);
+            return -1;
+        }
+    num_threads = worker_pool_threads(num_threads, list.count);
+
+    BatchResult* results = calloc(list.count, sizeof(BatchResult));
+    if (results == NULL)
+        {
+            printf("Error allocating %d results!\n", list.count);
+            return -1;
+        }
+    for (int i = 0; i < list.count; i++) results[i].path = list.paths[i];
+
+    printf("Scenario Batch\n");
+    printf("- Scenarios: %d on %d threads\n\n", list.count, num_threads);
+
+    double start = now_s();
+    int used = worker_pool_run(list.count, num_threads, batch_item, results);
+    double elapsed = now_s() - start;
+    if (used < num_threads)
+        {
+            printf("Warning: only %d of %d threads started\n\n", used, num_threads);
+        }
+
+    FILE* summary = fopen("scenario_summary.csv", "w");
+    if (summary == NULL)
+        {
+            printf("Error opening summary file!\n");
+            free(results);
+            return -1;
+        }
+    fprintf(summary, "Scenario,File,Ticks,Events,Steps,Unsettled,WorstOvershoot,WorstSettlingTime,IAE,FinalError\n");
+
+    printf("Scenario                  Events  Steps  Unsettled  Over(%%)  Settle(s)  IAE\n");
+    printf("------------------------  ------  -----  ---------  -------  ---------  --------\n");
+    long total_ticks = 0;
+    int failures = 0;
+    for (int i = 0; i < list.count; i++)
+        {
+            const BatchResult* r = &results[i];
+            if (r->status != 0)
+                {
+                    if (r->error_line > 0) printf("Error in %s line %d!\n", r->path, r->error_line);
+                    else printf("Error opening %s!\n", r->path);
+                    failures++;
+                    continue;
+                }
+            total_ticks += r->ticks;
+            fprintf(summary, "%s,%s,%ld,%d,%d,%d,%.2f,%.2f,%.3f,%.3f\n",
+                    r->name, r->path, r->ticks, r->events, r->steps, r->unsettled_steps,
+                    r->worst_overshoot, r->worst_settling_time, r->total_iae, r->final_error);
+            if (i < 20)
+                {
+                    printf("%-24.24s  %-6d  %-5d  %-9d  %-7.2f  %-9.2f  %.3f\n",
+                           r->name, r->events, r->steps, r->unsettled_steps,
+                           r->worst_overshoot, r->worst_settling_time, r->total_iae);
+                }
+        }
+    fclose(summary);
+
+    if (list.count > 20) printf("... %d more\n", list.count - 20);
+    printf("\nRan %d scenarios (%ld steps) in %.3f s: %.1f ns/step\n",
+           list.count - failures, total_ticks, elapsed, total_ticks ? elapsed * 1e9 / total_ticks : 0.0);
+    printf("Summary written to scenario_summary.csv\n");
+
+    for (int i = 0; i < list.count; i++) free(list.paths[i]);
+    free(list.paths);
+    free(results);
+    return failures ? -1 : 0;
+}
@@ -0,0 +1,231 @@
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "shard_runtime.h"
+
+#define SPINS_BEFORE_YIELD 1024 // Give the CPU away if a wait lasts this long
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static size_t round_to_line(size_t bytes) {
+    return (bytes + SHARD_CACHE_LINE - 1) & ~(size_t)(SHARD_CACHE_LINE - 1);
+}
+
+static void spin_pause(int* spins) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+    if (++*spins >= SPINS_BEFORE_YIELD) {
+        *spins = 0;
+        sched_yield(); // More workers than free CPUs - let the others run
+    }
+}
+
+void spin_barrier_init(SpinBarrier* barrier, int parties) {
+    atomic_init(&barrier->remaining, parties);
+    atomic_init(&barrier->sense, 0);
+    barrier->parties = parties;
+}
+
+// Last thread to arrive resets the counter and flips the shared sense,
+// which releases everyone spinning on it
+void spin_barrier_wait(SpinBarrier* barrier, int* local_sense) {
+    int sense = !*local_sense;
+    *local_sense = sense;
+
+    if (atomic_fetch_sub_explicit(&barrier->remaining, 1, memory_order_acq_rel) == 1) {
+        atomic_store_explicit(&barrier->remaining, barrier->parties, memory_order_relaxed);
+        atomic_store_explicit(&barrier->sense, sense, memory_order_release);
+        return;
+    }
+
+    int spins = 0;
+    while (atomic_load_explicit(&barrier->sense, memory_order_acquire) != sense) {
+        spin_pause(&spins);
+    }
+}
+
+static void* shard_worker(void* arg);
+
+// Start one worker per shard, pinned when a CPU was given
+// A CPU that is not available leaves that shard unpinned rather than not run
+static int shard_runtime_start(ShardRuntime* rt) {
+    for (int s = 0; s < rt->num_shards; s++) {
+        ControlShard* shard = &rt->shards[s];
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        if (shard->cpu >= 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(shard->cpu, &set);
+            pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+        }
+        int rc = pthread_create(&rt->threads[s], &attr, shard_worker, shard);
+        pthread_attr_destroy(&attr);
+        if (rc != 0 && shard->cpu >= 0) {
+            shard->cpu = -1;
+            rc = pthread_create(&rt->threads[s], NULL, shard_worker, shard);
+        }
+        if (rc != 0) return -1;
+        rt->started++;
+    }
+    return 0;
+}
+
+// Carve shards, thread handles and channel blocks out of one aligned arena
+// Layout: [shard headers][threads][shard 0 channels][pad][shard 1 channels][pad]...
+int shard_runtime_init(ShardRuntime* rt, int channels, int num_shards, int first_cpu) {
+    rt->arena = NULL; // shard_runtime_free() is safe after any failure
+    if (channels <= 0 || num_shards <= 0 || num_shards > channels) return -1;
+
+    size_t header_bytes = round_to_line(sizeof(ControlShard) * (size_t)num_shards) +
+                          round_to_line(sizeof(pthread_t) * (size_t)num_shards);
+    size_t total = header_bytes;
+    for (int s = 0; s < num_shards; s++) {
+        int count = (int)((long)(s + 1) * channels / num_shards - (long)s * channels / num_shards);
+        total += round_to_line(sizeof(ChannelPair) * (size_t)count);
+    }
+
+    char* arena = aligned_alloc(SHARD_CACHE_LINE, total);
+    if (arena == NULL) return -1;
+    memset(arena, 0, total);
+
+    rt->channels = channels;
+    rt->num_shards = num_shards;
+    rt->shards = (ControlShard*)arena;
+    rt->threads = (pthread_t*)(arena + round_to_line(sizeof(ControlShard) * (size_t)num_shards));
+    rt->arena = arena;
+    rt->started = 0;
+    rt->ticks = 0;
+    rt->hook = NULL;
+    rt->context = NULL;
+    rt->generation = 0;
+    rt->active = 0;
+    rt->stop = 0;
+    spin_barrier_init(&rt->barrier, num_shards);
+
+    char* next = arena + header_bytes;
+    for (int s = 0; s < num_shards; s++) {
+        ControlShard* shard = &rt->shards[s];
+        shard->first_channel = (int)((long)s * channels / num_shards);
+        shard->count = (int)((long)(s + 1) * channels / num_shards) - shard->first_channel;
+        shard->channels = (ChannelPair*)next;
+        shard->index = s;
+        shard->cpu = (first_cpu >= 0) ? first_cpu + s : -1;
+        shard->busy_ns = 0;
+        shard->runtime = rt;
+        next += round_to_line(sizeof(ChannelPair) * (size_t)shard->count);
+    }
+
+    pthread_mutex_init(&rt->lock, NULL);
+    pthread_cond_init(&rt->wake, NULL);
+    pthread_cond_init(&rt->done, NULL);
+    if (shard_runtime_start(rt) != 0) {
+        shard_runtime_free(rt);
+        return -1;
+    }
+    return 0;
+}
+
+void shard_runtime_free(ShardRuntime* rt) {
+    if (rt->arena == NULL) return;
+
+    pthread_mutex_lock(&rt->lock);
+    rt->stop = 1;
+    pthread_cond_broadcast(&rt->wake);
+    pthread_mutex_unlock(&rt->lock);
+    for (int s = 0; s < rt->started; s++) {
+        pthread_join(rt->threads[s], NULL);
+    }
+    pthread_cond_destroy(&rt->done);
+    pthread_cond_destroy(&rt->wake);
+    pthread_mutex_destroy(&rt->lock);
+
+    free(rt->arena);
+    rt->arena = NULL;
+    rt->shards = NULL;
+    rt->channels = 0;
+    rt->num_shards = 0;
+}
+
+ChannelPair* shard_runtime_channel(ShardRuntime* rt, int index) {
+    for (int s = 0; s < rt->num_shards; s++) {
+        ControlShard* shard = &rt->shards[s];
+        if (index < shard->first_channel + shard->count) {
+            return &shard->channels[index - shard->first_channel];
+        }
+    }
+    return NULL;
+}
+
+// Same step as main.c for every channel in the shard
+static void shard_step(ControlShard* shard) {
+    ChannelPair* channels = shard->channels;
+    for (int i = 0; i < shard->count; i++) {
+        ChannelPair* c = &channels[i];
+        float control_signal = pid_compute(&c->pid, c->valve.position);
+        if (control_signal < 0.0f) control_signal = 0.0f;
+        if (control_signal > 100.0f) control_signal = 100.0f;
+        valve_update(&c->valve, control_signal, c->pid.sample_time);
+    }
+}
+
+// Persistent worker: parked until a run starts, then steps its shard in
+// lockstep with the others. The barrier sense carries over between runs.
+static void* shard_worker(void* arg) {
+    ControlShard* shard = (ControlShard*)arg;
+    ShardRuntime* rt = shard->runtime;
+    int local_sense = 0;
+    uint64_t seen = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&rt->lock);
+        while (rt->generation == seen && !rt->stop) {
+            pthread_cond_wait(&rt->wake, &rt->lock);
+        }
+        if (rt->stop) {
+            pthread_mutex_unlock(&rt->lock);
+            return NULL;
+        }
+        seen = rt->generation;
+        pthread_mutex_unlock(&rt->lock);
+
+        uint64_t busy = 0;
+        for (uint64_t tick = 0; tick < rt->ticks; tick++) {
+            uint64_t begin = now_ns();
+            if (rt->hook != NULL) rt->hook(shard, tick, rt->context);
+            shard_step(shard);
+            busy += now_ns() - begin;
+
+            spin_barrier_wait(&rt->barrier, &local_sense);
+        }
+        shard->busy_ns = busy;
+
+        pthread_mutex_lock(&rt->lock);
+        if (--rt->active == 0) pthread_cond_signal(&rt->done);
+        pthread_mutex_unlock(&rt->lock);
+    }
+}
+
+// Wake every worker for one run and wait until all have parked again
+void shard_runtime_run(ShardRuntime* rt, uint64_t ticks, ShardTickHook hook, void* context) {
+    pthread_mutex_lock(&rt->lock);
+    rt->ticks = ticks;
+    rt->hook = hook;
+    rt->context = context;
+    rt->active = rt->num_shards;
+    rt->generation++;
+    pthread_cond_broadcast(&rt->wake);
+    while (rt->active > 0) {
+        pthread_cond_wait(&rt->done, &rt->lock);
+    }
+    pthread_mutex_unlock(&rt->lock);
+}
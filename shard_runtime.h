@@ -0,0 +1,95 @@
+#ifndef SHARD_RUNTIME_H
+#define SHARD_RUNTIME_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "pid_controller.h"
+#include "valve_simulator.h"
+
+#define SHARD_CACHE_LINE 64
+
+struct ShardRuntime;
+
+// One controlled valve
+typedef struct {
+    PIDController pid;
+    ValveSimulator valve;
+} ChannelPair;
+
+// Channels owned by one worker thread
+// Aligned (and therefore padded) to a cache line, and its channel array
+// starts on a fresh line, so no two workers ever write to the same line.
+typedef struct {
+    _Alignas(SHARD_CACHE_LINE)
+    ChannelPair* channels; // Contiguous block inside the arena
+    int count;             // Channels in this shard
+    int first_channel;     // Global index of channels[0]
+    int index;             // Shard number
+    int cpu;               // CPU the worker is pinned to (-1 = not pinned or CPU unavailable)
+    uint64_t busy_ns;      // Time spent stepping channels (excludes barrier waits)
+    struct ShardRuntime* runtime; // Owning runtime
+} ControlShard;
+
+// Sense-reversing spin barrier
+// The arrival counter and the release flag sit on separate cache lines so
+// waiting threads spin on a line that only changes once per tick.
+typedef struct {
+    _Alignas(SHARD_CACHE_LINE) atomic_int remaining;
+    _Alignas(SHARD_CACHE_LINE) atomic_int sense;
+    int parties;
+} SpinBarrier;
+
+// Called by each worker at the start of every tick for its own shard
+// (e.g. to apply setpoint changes); must not allocate or block
+typedef void (*ShardTickHook)(ControlShard* shard, uint64_t tick, void* context);
+
+// Pool of PID/valve pairs split into shards, one pinned worker per shard
+// Everything is carved out of a single arena and the workers are started at
+// init; running allocates and creates nothing. Between runs the workers are
+// parked on a condition variable (blocked, not spinning); within a run they
+// meet on the spin barrier once per tick.
+typedef struct ShardRuntime {
+    int channels;
+    int num_shards;
+    ControlShard* shards;
+    SpinBarrier barrier;
+    void* arena; // Single allocation backing shards, thread handles and channels
+    pthread_t* threads;
+    int started; // Workers running (all of them once init succeeds)
+
+    // Per-run state read by the workers
+    uint64_t ticks;
+    ShardTickHook hook;
+    void* context;
+
+    // Parking: a run bumps generation; the last worker to finish signals done
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    uint64_t generation;
+    int active; // Workers still in the current run
+    int stop;   // Workers exit at the next wake-up
+} ShardRuntime;
+
+// Allocate channels split across num_shards shards and start one worker per
+// shard (returns 0 on success, -1 on allocation or thread start failure)
+// Shard s is pinned to CPU first_cpu + s, or left unpinned if first_cpu < 0.
+// Channels start zeroed; configure them through shard_runtime_channel().
+int shard_runtime_init(ShardRuntime* rt, int channels, int num_shards, int first_cpu);
+
+// Stop and join the workers, then release the arena
+void shard_runtime_free(ShardRuntime* rt);
+
+// Channel by global index
+ChannelPair* shard_runtime_channel(ShardRuntime* rt, int index);
+
+// Step every channel for ticks ticks; all shards finish tick n before any starts n + 1
+// Tick numbers passed to the hook restart at 0 on every run
+// Wakes the parked workers and returns once they are all parked again
+void shard_runtime_run(ShardRuntime* rt, uint64_t ticks, ShardTickHook hook, void* context);
+
+void spin_barrier_init(SpinBarrier* barrier, int parties);
+void spin_barrier_wait(SpinBarrier* barrier, int* local_sense);
+
+#endif // SHARD_RUNTIME_H
@@ -0,0 +1,129 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "shard_runtime.h"
+#include "step_profile.h"
+
+// Scaling study for the sharded runtime
+// Runs the main.c profile on every channel (50%, step to 75% at 5 s) with
+// 1, 2, 4, ... shards and reports throughput per channel-step. Results must be
+// identical for every shard count since each channel is stepped by exactly
+// one worker, in the same order.
+
+#define MAX_RUNS    16
+
+typedef struct {
+    int shards;
+    int pinned; // Shards whose worker could be pinned
+    double seconds;
+    double ns_per_step;
+    double checksum;
+} ScalingResult;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Setpoint change on this shard's own channels only
+static void apply_setpoint_step(ControlShard* shard, uint64_t tick, void* context) {
+    (void)context;
+    if (tick != STEP_PROFILE_STEP_TICK) return;
+    for (int i = 0; i < shard->count; i++) {
+        pid_set_setpoint(&shard->channels[i].pid, STEP_PROFILE_STEP_SETPOINT);
+    }
+}
+
+static int run_scaling(int channels, uint64_t ticks, int shards, int first_cpu, ScalingResult* result) {
+    ShardRuntime rt;
+    if (shard_runtime_init(&rt, channels, shards, first_cpu) != 0) {
+        printf("Error setting up %d channels on %d worker threads!\n", channels, shards);
+        return -1;
+    }
+
+    for (int c = 0; c < channels; c++) {
+        ChannelPair* pair = shard_runtime_channel(&rt, c);
+        pid_init(&pair->pid, STEP_PROFILE_KP, STEP_PROFILE_KI, STEP_PROFILE_KD, STEP_PROFILE_SAMPLE_TIME);
+        pid_set_setpoint(&pair->pid, STEP_PROFILE_INITIAL_SETPOINT);
+        valve_init(&pair->valve, STEP_PROFILE_VALVE_TAU + 0.0001f * (c % 1000), 0.0f);
+    }
+
+    double start = now_s();
+    shard_runtime_run(&rt, ticks, apply_setpoint_step, NULL);
+    double elapsed = now_s() - start;
+
+    result->shards = shards;
+    result->seconds = elapsed;
+    result->ns_per_step = elapsed * 1e9 / ((double)channels * (double)ticks);
+    result->pinned = 0;
+    for (int s = 0; s < shards; s++) {
+        if (rt.shards[s].cpu >= 0) result->pinned++;
+    }
+    result->checksum = 0.0;
+    for (int c = 0; c < channels; c++) {
+        result->checksum += shard_runtime_channel(&rt, c)->valve.position;
+    }
+
+    shard_runtime_free(&rt);
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    int channels = 65536;
+    uint64_t ticks = 1500;
+    int max_shards = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int first_cpu = 0;
+
+    if (argc >= 2) channels = atoi(argv[1]);
+    if (argc >= 3) ticks = strtoull(argv[2], NULL, 10);
+    if (argc >= 4) max_shards = atoi(argv[3]);
+    if (argc >= 5) first_cpu = atoi(argv[4]);
+
+    if (channels < 1 || ticks < 1 || max_shards < 1)
+        {
+            printf("Usage: %s [channels] [ticks] [max_shards] [first_cpu (-1 = no pinning)]\n", argv[0]);
+            return -1;
+        }
+    if (max_shards > channels) max_shards = channels;
+
+    printf("Sharded Runtime Scaling\n");
+    printf("- Channels: %d, ticks: %llu\n", channels, (unsigned long long)ticks);
+    printf("- Shards: 1 to %d, first CPU: %d\n\n", max_shards, first_cpu);
+
+    // 1, 2, 4, ... and finally max_shards itself
+    ScalingResult results[MAX_RUNS];
+    int runs = 0;
+    for (int s = 1; runs < MAX_RUNS; s *= 2)
+        {
+            if (s > max_shards) s = max_shards;
+            if (run_scaling(channels, ticks, s, first_cpu, &results[runs]) != 0) return -1;
+            runs++;
+            if (s == max_shards) break;
+        }
+
+    int mismatch = 0;
+    printf("Shards  Pinned  Time (s)  ns/channel-step  Speedup  Efficiency (%%)  Checksum\n");
+    printf("------  ------  --------  ---------------  -------  --------------  ------------\n");
+    for (int r = 0; r < runs; r++)
+        {
+            const ScalingResult* res = &results[r];
+            double speedup = results[0].seconds / res->seconds;
+            printf("%-6d  %-6d  %-8.3f  %-15.2f  %-7.2f  %-14.1f  %.4f\n",
+                   res->shards, res->pinned, res->seconds, res->ns_per_step, speedup,
+                   100.0 * speedup / res->shards, res->checksum);
+            if (res->checksum != results[0].checksum) mismatch = 1;
+        }
+
+    if (mismatch)
+        {
+            printf("\nError: results depend on the shard count!\n");
+            return 1;
+        }
+    printf("\nResults identical for every shard count\n");
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <math.h>
+#include "step_metrics.h"
+
+void step_metrics_init(StepMetrics* metrics, float settling_band, float rise_fraction,
+                       float command_min, float command_max) {
+    metrics->settling_band = settling_band;
+    metrics->rise_fraction = rise_fraction;
+    metrics->command_min = command_min;
+    metrics->command_max = command_max;
+
+    // NaN never compares equal, so the first update always starts a step
+    step_metrics_reset(metrics, NAN, 0.0f);
+}
+
+void step_metrics_reset(StepMetrics* metrics, float target, float start_position) {
+    metrics->target = target;
+    metrics->start_position = start_position;
+    metrics->elapsed = 0.0f;
+    metrics->last_position = start_position;
+    metrics->peak_excursion = -fabsf(target - start_position);
+    metrics->samples = 0;
+
+    metrics->rise_time = -1.0f;
+    metrics->settling_time = -1.0f;
+    metrics->overshoot = 0.0f;
+    metrics->final_error = target - start_position;
+    metrics->iae = 0.0;
+    metrics->ise = 0.0;
+    metrics->itae = 0.0;
+    metrics->control_effort = 0.0;
+    metrics->saturation_time = 0.0f;
+}
+
+// One sample, O(1) work and no storage
+// The measurement is the value pid_compute() just used, so on the step where
+// the setpoint changed it is also the position the step starts from.
+void step_metrics_update(StepMetrics* metrics, const PIDController* pid,
+                         float measurement, float command) {
+    if (pid->setpoint_target != metrics->target) {
+        step_metrics_reset(metrics, pid->setpoint_target, measurement);
+    }
+
+    float dt = pid->sample_time;
+    float t = metrics->elapsed;
+    float error = metrics->target - measurement;
+    float abs_error = fabsf(error);
+
+    // Integral criteria (rectangular rule, one sample per step)
+    metrics->iae += abs_error * dt;
+    metrics->ise += error * error * dt;
+    metrics->itae += t * abs_error * dt;
+    metrics->control_effort += fabsf(command) * dt;
+    if (command <= metrics->command_min || command >= metrics->command_max) {
+        metrics->saturation_time += dt;
+    }
+
+    // Work in the step direction so rising and falling steps are scored alike
+    float direction = (metrics->target >= metrics->start_position) ? 1.0f : -1.0f;
+    float step_size = fabsf(metrics->target - metrics->start_position);
+    float travel = (measurement - metrics->start_position) * direction;
+
+    if (metrics->rise_time < 0.0f && travel >= metrics->rise_fraction * step_size) {
+        metrics->rise_time = t;
+    }
+
+    float excursion = (measurement - metrics->target) * direction;
+    if (excursion > metrics->peak_excursion) {
+        metrics->peak_excursion = excursion;
+        if (excursion > 0.0f && step_size > 0.0f) {
+            metrics->overshoot = excursion / step_size * 100.0f;
+        }
+    }
+
+    // Settled from the first sample of the current in-band stretch
+    float band = fmaxf(metrics->settling_band * fabsf(metrics->target), STEP_METRICS_MIN_BAND);
+    if (abs_error > band) {
+        metrics->settling_time = -1.0f;
+    } else if (metrics->settling_time < 0.0f) {
+        metrics->settling_time = t;
+    }
+
+    metrics->final_error = error;
+    metrics->last_position = measurement;
+    metrics->samples++;
+    metrics->elapsed = metrics->samples * dt;
+}
+
+void step_metrics_print(const StepMetrics* metrics) {
+    printf("Step: %.1f%% -> %.1f%% (%.2f s)\n",
+           metrics->start_position, metrics->target, metrics->elapsed);
+    if (metrics->rise_time >= 0.0f)
+        printf("Rise Time (%.0f%%): %.2f s\n", metrics->rise_fraction * 100.0f, metrics->rise_time);
+    else
+        printf("Rise Time (%.0f%%): not reached\n", metrics->rise_fraction * 100.0f);
+    if (metrics->settling_time >= 0.0f)
+        printf("Settling Time (+/-%.1f%%): %.2f s\n", metrics->settling_band * 100.0f, metrics->settling_time);
+    else
+        printf("Settling Time (+/-%.1f%%): not settled\n", metrics->settling_band * 100.0f);
+    printf("Overshoot: %.2f%%\n", metrics->overshoot);
+    printf("Steady-State Error: %.3f%%\n", metrics->final_error);
+    printf("IAE: %.3f  ISE: %.3f  ITAE: %.3f\n", metrics->iae, metrics->ise, metrics->itae);
+    printf("Control Effort: %.1f  Saturated: %.2f s\n",
+           metrics->control_effort, metrics->saturation_time);
+}
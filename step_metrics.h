@@ -0,0 +1,58 @@
+#ifndef STEP_METRICS_H
+#define STEP_METRICS_H
+
+#include "pid_controller.h"
+
+// Narrowest settling band (%): the 0.1% resolution positions are logged
+// at. Keeps steps to (or near) 0% from needing an exact zero error.
+#define STEP_METRICS_MIN_BAND 0.1f
+
+// Online step-response metrics
+// Fed one sample per control step, right after pid_compute(). Uses constant
+// memory and restarts automatically whenever the controller's setpoint target
+// changes (pid_set_setpoint / pid_set_setpoint_ramped), so every field below
+// describes the response to the most recent setpoint change.
+// Errors are measured against the target setpoint, times from the change.
+typedef struct {
+    // Configuration
+    float settling_band;  // Settling band as a fraction of the target (0.01 = +/-1%),
+                          // never narrower than STEP_METRICS_MIN_BAND
+    float rise_fraction;  // Rise time is measured to this fraction of the step (0.95)
+    float command_min;    // Commands at or beyond these limits count as saturated
+    float command_max;
+
+    // Current step
+    float target;         // Setpoint target the metrics refer to
+    float start_position; // Measurement when the step started
+    float elapsed;        // Time since the step started (seconds)
+    float last_position;  // Most recent measurement
+    float peak_excursion; // Largest travel past the target in the step direction
+    long samples;         // Samples since the step started
+
+    // Metrics (-1 = not reached yet)
+    float rise_time;       // Seconds to reach rise_fraction of the step
+    float settling_time;   // Seconds after which the error stayed inside the band
+    float overshoot;       // Percent of step size
+    float final_error;     // Error at the latest sample
+    double iae;            // Integral of |error|
+    double ise;            // Integral of error^2
+    double itae;           // Integral of time * |error|
+    double control_effort; // Integral of |command|
+    float saturation_time; // Seconds spent with the command at a limit
+} StepMetrics;
+
+// Configure the band, rise fraction and command limits; the first update starts a step
+void step_metrics_init(StepMetrics* metrics, float settling_band, float rise_fraction,
+                       float command_min, float command_max);
+
+// Start a new step towards target from the given position
+void step_metrics_reset(StepMetrics* metrics, float target, float start_position);
+
+// Add one sample: the measurement passed to pid_compute() and the command applied
+void step_metrics_update(StepMetrics* metrics, const PIDController* pid,
+                         float measurement, float command);
+
+// Print a one-block summary of the current step
+void step_metrics_print(const StepMetrics* metrics);
+
+#endif // STEP_METRICS_H
@@ -0,0 +1,21 @@
+#ifndef STEP_PROFILE_H
+#define STEP_PROFILE_H
+
+// Day 4 step test: hold 50%, step to 75% at 5 s, 15 s in total
+// scenarios/baseline.scn is the same profile for main.c, and
+// tests/test_scenario.c checks that the two agree. The batch and real-time
+// tools use these constants rather than parse the file for every run.
+#define STEP_PROFILE_SAMPLE_TIME      0.01f  // s
+#define STEP_PROFILE_TOTAL_STEPS      1500   // 15 s
+#define STEP_PROFILE_STEP_TIME        5.0    // s (loops at other rates)
+#define STEP_PROFILE_STEP_TICK        500    // STEP_TIME / SAMPLE_TIME
+#define STEP_PROFILE_INITIAL_SETPOINT 50.0f  // %
+#define STEP_PROFILE_STEP_SETPOINT    75.0f  // %
+
+// Loop the profile runs on: baseline gains and a valve without deadband
+#define STEP_PROFILE_KP               5.0f
+#define STEP_PROFILE_KI               4.0f
+#define STEP_PROFILE_KD               0.1f
+#define STEP_PROFILE_VALVE_TAU        0.2f   // s
+
+#endif // STEP_PROFILE_H
@@ -0,0 +1,199 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "telemetry_log.h"
+
+#define TELEMETRY_DEFAULT_FLUSH_MS 20
+
+static void sleep_ms(uint32_t ms) {
+    struct timespec ts;
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (long)(ms % 1000) * 1000000L;
+    nanosleep(&ts, NULL);
+}
+
+// Keep the first error only
+static void telemetry_set_error(TelemetryLog* log, int error) {
+    int none = 0;
+    atomic_compare_exchange_strong(&log->write_error, &none, error != 0 ? error : EIO);
+}
+
+// Write everything currently in the ring
+// At most two fwrite() calls: up to the end of the ring, then the wrapped part
+// After a failed write the records are only counted, so the ring keeps moving
+static void telemetry_drain(TelemetryLog* log) {
+    uint64_t tail = atomic_load_explicit(&log->tail, memory_order_relaxed);
+    uint64_t head = atomic_load_explicit(&log->head, memory_order_acquire);
+
+    while (tail != head) {
+        uint32_t start = (uint32_t)tail & log->mask;
+        uint64_t available = head - tail;
+        uint64_t contiguous = log->capacity - start;
+        size_t count = (size_t)(available < contiguous ? available : contiguous);
+
+        size_t written = 0;
+        if (atomic_load_explicit(&log->write_error, memory_order_relaxed) == 0) {
+            errno = 0;
+            written = fwrite(&log->ring[start], sizeof(TelemetryRecord), count, log->file);
+            if (written != count) telemetry_set_error(log, errno);
+        }
+        if (written != count) {
+            atomic_fetch_add_explicit(&log->discarded, count - written, memory_order_relaxed);
+        }
+        tail += count;
+        atomic_store_explicit(&log->tail, tail, memory_order_release);
+    }
+}
+
+// Background writer - wakes every flush interval and drains the ring in bulk
+static void* telemetry_writer(void* arg) {
+    TelemetryLog* log = (TelemetryLog*)arg;
+
+    while (atomic_load_explicit(&log->running, memory_order_acquire)) {
+        telemetry_drain(log);
+        sleep_ms(log->flush_interval_ms);
+    }
+
+    // Final drain after the producer has stopped
+    telemetry_drain(log);
+    return NULL;
+}
+
+// Allocate the ring, write the file header and start the writer thread
+int telemetry_log_open(TelemetryLog* log, const char* path, uint32_t capacity) {
+    uint32_t size = 1;
+    while (size < capacity) size <<= 1;
+
+    log->ring = malloc(sizeof(TelemetryRecord) * size);
+    if (log->ring == NULL) return -1;
+
+    log->file = fopen(path, "wb");
+    if (log->file == NULL) {
+        free(log->ring);
+        log->ring = NULL;
+        return -1;
+    }
+
+    TelemetryFileHeader header;
+    memcpy(header.magic, TELEMETRY_MAGIC, 4);
+    header.version = TELEMETRY_VERSION;
+    header.record_size = sizeof(TelemetryRecord);
+    header.reserved = 0;
+    if (fwrite(&header, sizeof(header), 1, log->file) != 1) {
+        fclose(log->file);
+        free(log->ring);
+        log->ring = NULL;
+        return -1;
+    }
+
+    log->capacity = size;
+    log->mask = size - 1;
+    log->next_sequence = 0;
+    log->flush_interval_ms = TELEMETRY_DEFAULT_FLUSH_MS;
+    atomic_init(&log->head, 0);
+    atomic_init(&log->tail, 0);
+    atomic_init(&log->overruns, 0);
+    atomic_init(&log->discarded, 0);
+    atomic_init(&log->write_error, 0);
+    atomic_init(&log->running, 1);
+
+    if (pthread_create(&log->writer, NULL, telemetry_writer, log) != 0) {
+        fclose(log->file);
+        free(log->ring);
+        log->ring = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+// Copy one record into the ring (control-loop side)
+// If the writer has fallen behind the record is dropped and counted;
+// the sequence number still advances so the gap is visible in the file
+int telemetry_log_push(TelemetryLog* log, const TelemetryRecord* record) {
+    uint32_t sequence = log->next_sequence++;
+    uint64_t head = atomic_load_explicit(&log->head, memory_order_relaxed);
+    uint64_t tail = atomic_load_explicit(&log->tail, memory_order_acquire);
+
+    if (head - tail >= log->capacity) {
+        atomic_fetch_add_explicit(&log->overruns, 1, memory_order_relaxed);
+        return -1;
+    }
+
+    TelemetryRecord* slot = &log->ring[(uint32_t)head & log->mask];
+    *slot = *record;
+    slot->sequence = sequence;
+    atomic_store_explicit(&log->head, head + 1, memory_order_release);
+    return 0;
+}
+
+// Stop the writer thread and flush everything still queued
+// fclose() writes out the stdio buffer, so it can fail too
+int telemetry_log_close(TelemetryLog* log) {
+    if (log->ring == NULL) return -1;
+
+    atomic_store_explicit(&log->running, 0, memory_order_release);
+    pthread_join(log->writer, NULL);
+
+    errno = 0;
+    if (fclose(log->file) != 0) telemetry_set_error(log, errno);
+    free(log->ring);
+    log->ring = NULL;
+    log->file = NULL;
+    return atomic_load_explicit(&log->write_error, memory_order_relaxed) == 0 ? 0 : -1;
+}
+
+uint64_t telemetry_log_overruns(const TelemetryLog* log) {
+    return atomic_load_explicit(&log->overruns, memory_order_relaxed);
+}
+
+// Offline conversion to the CSV layout main.c has always produced
+long telemetry_export_csv(const char* bin_path, const char* csv_path, int include_internals) {
+    FILE* in = fopen(bin_path, "rb");
+    if (in == NULL) return -1;
+
+    TelemetryFileHeader header;
+    if (fread(&header, sizeof(header), 1, in) != 1 ||
+        memcmp(header.magic, TELEMETRY_MAGIC, 4) != 0 ||
+        header.record_size != sizeof(TelemetryRecord)) {
+        fclose(in);
+        return -1;
+    }
+
+    FILE* out = fopen(csv_path, "w");
+    if (out == NULL) {
+        fclose(in);
+        return -1;
+    }
+
+    if (include_internals) {
+        fprintf(out, "Time,Setpoint,Position,Error,Command,Integral,DerivativeFiltered\n");
+    } else {
+        fprintf(out, "Time,Setpoint,Position,Error,Command\n");
+    }
+
+    TelemetryRecord block[1024];
+    long total = 0;
+    size_t count;
+    while ((count = fread(block, sizeof(TelemetryRecord), 1024, in)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            const TelemetryRecord* r = &block[i];
+            if (include_internals) {
+                fprintf(out, "%.2f,%.1f,%.1f,%.1f,%.1f,%.4f,%.4f\n",
+                        r->time, r->setpoint, r->position, r->error, r->command,
+                        r->integral, r->derivative_filtered);
+            } else {
+                fprintf(out, "%.2f,%.1f,%.1f,%.1f,%.1f\n",
+                        r->time, r->setpoint, r->position, r->error, r->command);
+            }
+        }
+        total += (long)count;
+    }
+
+    int failed = ferror(in) || ferror(out);
+    if (fclose(out) != 0) failed = 1;
+    fclose(in);
+    return failed ? -1 : total;
+}
@@ -0,0 +1,82 @@
+#ifndef TELEMETRY_LOG_H
+#define TELEMETRY_LOG_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+// One control-loop sample (fixed size, written to disk as-is)
+typedef struct {
+    uint32_t sequence;         // Sample counter (gaps = overruns)
+    float time;                // Simulation time (s)
+    float setpoint;            // Active setpoint (%)
+    float position;            // Valve position (%)
+    float error;               // Setpoint - position (%)
+    float command;             // Command sent to valve (%)
+    float integral;            // PID integral state
+    float derivative_filtered; // PID filtered derivative state
+} TelemetryRecord;
+
+// Binary file header
+typedef struct {
+    char magic[4];        // "HVTL"
+    uint32_t version;     // Format version
+    uint32_t record_size; // sizeof(TelemetryRecord)
+    uint32_t reserved;
+} TelemetryFileHeader;
+
+#define TELEMETRY_MAGIC   "HVTL"
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_CACHE_LINE 64
+
+// Single-producer / single-consumer logger
+// The control loop pushes records into a preallocated ring; a background
+// thread drains it to disk in large blocks. The producer's and the writer's
+// counters sit on separate cache lines so each push does not pull the line
+// the writer is updating.
+//
+// If a write fails (e.g. disk full) the writer records the error and
+// discards records from then on, so the control loop is never held up;
+// telemetry_log_close() reports it.
+typedef struct {
+    TelemetryRecord* ring;    // Preallocated ring storage
+    uint32_t capacity;        // Ring size (power of two)
+    uint32_t mask;            // capacity - 1
+
+    // Written by the producer
+    _Alignas(TELEMETRY_CACHE_LINE) _Atomic uint64_t head; // Next slot to write
+    _Atomic uint64_t overruns; // Records dropped because the ring was full
+    uint32_t next_sequence;    // Sample counter
+
+    // Written by the writer thread
+    _Alignas(TELEMETRY_CACHE_LINE) _Atomic uint64_t tail; // Next slot to drain
+    _Atomic uint64_t discarded; // Records lost after a write error
+    _Atomic int write_error;    // errno of the first failed write (0 = none)
+    _Atomic int running;
+
+    FILE* file;
+    pthread_t writer;
+    uint32_t flush_interval_ms; // Writer sleep when the ring is nearly empty
+} TelemetryLog;
+
+// Open log file and start the writer thread (returns 0 on success, -1 on failure)
+// capacity is rounded up to a power of two
+int telemetry_log_open(TelemetryLog* log, const char* path, uint32_t capacity);
+
+// Queue one record - never blocks or allocates
+// Returns 0 if queued, -1 if dropped (ring full, counted as overrun)
+int telemetry_log_push(TelemetryLog* log, const TelemetryRecord* record);
+
+// Stop the writer, drain remaining records and close the file
+// Returns 0 if every record reached the file, -1 on a write or close error
+int telemetry_log_close(TelemetryLog* log);
+
+uint64_t telemetry_log_overruns(const TelemetryLog* log);
+
+// Convert a binary log into the Time,Setpoint,Position,Error,Command CSV
+// include_internals adds Integral,DerivativeFiltered columns
+// Returns number of records converted, or -1 on a read or write error
+long telemetry_export_csv(const char* bin_path, const char* csv_path, int include_internals);
+
+#endif // TELEMETRY_LOG_H
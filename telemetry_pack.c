@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "delta_codec.h"
+
+// Compress Time,... CSV logs into delta/varint streams (.hvdc) and back
+// Usage: telemetry_pack pack input.csv output.hvdc [resolution]
+//        telemetry_pack unpack input.hvdc output.csv [start_s end_s]
+
+#define TIME_RESOLUTION  0.01 // Matches the %.2f time column
+#define VALUE_RESOLUTION 0.1  // Matches the %.1f value columns (0.1 %)
+#define LINE_LENGTH      4096
+
+static long file_size(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) return -1;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+// Decimal places that print a multiple of resolution exactly
+static int decimals_for(double resolution) {
+    int decimals = (int)ceil(-log10(resolution) - 1e-9);
+    return decimals > 0 ? decimals : 0;
+}
+
+static int pack(const char* csv_path, const char* out_path, double resolution) {
+    FILE* in = fopen(csv_path, "r");
+    if (in == NULL)
+        {
+            printf("Error opening %s!\n", csv_path);
+            return -1;
+        }
+
+    // Header row names the signals; the first one is time
+    char line[LINE_LENGTH];
+    DeltaSignal signals[DELTA_MAX_SIGNALS];
+    int num_signals = 0;
+    if (fgets(line, sizeof(line), in) != NULL)
+        {
+            for (char* name = strtok(line, ",\r\n"); name != NULL && num_signals < DELTA_MAX_SIGNALS;
+                 name = strtok(NULL, ",\r\n"))
+                {
+                    memset(&signals[num_signals], 0, sizeof(DeltaSignal));
+                    strncpy(signals[num_signals].name, name, DELTA_NAME_LENGTH - 1);
+                    signals[num_signals].resolution = (num_signals == 0) ? TIME_RESOLUTION : resolution;
+                    num_signals++;
+                }
+        }
+    if (num_signals < 2)
+        {
+            printf("Error: %s has no Time,... header!\n", csv_path);
+            fclose(in);
+            return -1;
+        }
+
+    DeltaEncoder encoder;
+    if (delta_encoder_open(&encoder, out_path, signals, num_signals, 0) != 0)
+        {
+            printf("Error opening %s!\n", out_path);
+            fclose(in);
+            return -1;
+        }
+
+    double values[DELTA_MAX_SIGNALS];
+    while (fgets(line, sizeof(line), in) != NULL)
+        {
+            char* p = line;
+            int count = 0;
+            while (count < num_signals)
+                {
+                    char* end;
+                    values[count] = strtod(p, &end);
+                    if (end == p) break;
+                    count++;
+                    p = (*end == ',') ? end + 1 : end;
+                }
+            if (count == 0) continue; // Blank line
+            if (count != num_signals || delta_encoder_append(&encoder, values) != 0)
+                {
+                    printf("Error: bad row %llu in %s!\n", (unsigned long long)encoder.rows + 2, csv_path);
+                    delta_encoder_close(&encoder);
+                    fclose(in);
+                    return -1;
+                }
+        }
+    fclose(in);
+
+    unsigned long long rows = encoder.rows;
+    if (delta_encoder_close(&encoder) != 0)
+        {
+            printf("Error writing %s!\n", out_path);
+            return -1;
+        }
+
+    long before = file_size(csv_path);
+    long after = file_size(out_path);
+    printf("Packed %llu rows: %ld -> %ld bytes (%.1fx, %.2f bytes/row)\n",
+           rows, before, after, (double)before / after, rows ? (double)after / rows : 0.0);
+    return 0;
+}
+
+static int unpack(const char* in_path, const char* csv_path, int ranged, double start, double end) {
+    DeltaDecoder decoder;
+    if (delta_decoder_open(&decoder, in_path) != 0)
+        {
+            printf("Error opening %s!\n", in_path);
+            return -1;
+        }
+
+    FILE* out = fopen(csv_path, "w");
+    if (out == NULL)
+        {
+            printf("Error opening %s!\n", csv_path);
+            delta_decoder_close(&decoder);
+            return -1;
+        }
+
+    int decimals[DELTA_MAX_SIGNALS];
+    for (int s = 0; s < decoder.num_signals; s++)
+        {
+            decimals[s] = decimals_for(decoder.signals[s].resolution);
+            fprintf(out, "%s%s", s ? "," : "", decoder.signals[s].name);
+        }
+    fprintf(out, "\n");
+
+    if (ranged && delta_decoder_seek(&decoder, start) != 0)
+        {
+            printf("Error seeking in %s!\n", in_path);
+            fclose(out);
+            delta_decoder_close(&decoder);
+            return -1;
+        }
+
+    double values[DELTA_MAX_SIGNALS];
+    long rows = 0;
+    int status;
+    while ((status = delta_decoder_next(&decoder, values)) == 1)
+        {
+            if (ranged && values[0] >= end) break;
+            for (int s = 0; s < decoder.num_signals; s++)
+                {
+                    fprintf(out, "%s%.*f", s ? "," : "", decimals[s], values[s]);
+                }
+            fprintf(out, "\n");
+            rows++;
+        }
+    fclose(out);
+    delta_decoder_close(&decoder);
+
+    if (status < 0)
+        {
+            printf("Error: %s is corrupt after %ld rows!\n", in_path, rows);
+            return -1;
+        }
+    printf("Unpacked %ld rows to %s\n", rows, csv_path);
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc >= 4 && strcmp(argv[1], "pack") == 0)
+        {
+            double resolution = (argc >= 5) ? atof(argv[4]) : VALUE_RESOLUTION;
+            if (resolution <= 0.0)
+                {
+                    printf("Error: resolution must be positive\n");
+                    return -1;
+                }
+            return pack(argv[2], argv[3], resolution) == 0 ? 0 : -1;
+        }
+    if (argc >= 4 && strcmp(argv[1], "unpack") == 0)
+        {
+            int ranged = (argc >= 6);
+            double start = ranged ? atof(argv[4]) : 0.0;
+            double end = ranged ? atof(argv[5]) : 0.0;
+            return unpack(argv[2], argv[3], ranged, start, end) == 0 ? 0 : -1;
+        }
+
+    printf("Usage: %s pack input.csv output.hvdc [resolution]\n", argv[0]);
+    printf("       %s unpack input.hvdc output.csv [start_s end_s]\n", argv[0]);
+    return -1;
+}
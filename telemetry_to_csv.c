@@ -0,0 +1,26 @@
+#include <stdio.h>
+#include <string.h>
+#include "telemetry_log.h"
+
+// Convert a binary telemetry log (.bin) to CSV
+// Usage: telemetry_to_csv input.bin output.csv [--internals]
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+        {
+            printf("Usage: %s input.bin output.csv [--internals]\n", argv[0]);
+            return -1;
+        }
+
+    int include_internals = (argc >= 4 && strcmp(argv[3], "--internals") == 0);
+
+    long count = telemetry_export_csv(argv[1], argv[2], include_internals);
+    if (count < 0)
+        {
+            printf("Error converting %s!\n", argv[1]);
+            return -1;
+        }
+
+    printf("Converted %ld records to %s\n", count, argv[2]);
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <stdio.h>
+#include <math.h>
+#include "pid_controller.h"
+#include "cascade.h"
+#include "test_check.h"
+
+#define BASE_DT     0.0005f // 2 kHz
+#define SPOOL_DECAY 0.904837f // exp(-0.0005 / 0.005)
+
+// Spool (first order) driving a cylinder (integrator with end stops)
+typedef struct {
+    float spool;
+    float cylinder;
+} Axis;
+
+static void axis_update(Axis* axis, float drive) {
+    axis->spool = drive + (axis->spool - drive) * SPOOL_DECAY;
+    axis->cylinder += 0.5f * axis->spool * BASE_DT;
+    if (axis->cylinder < 0.0f) axis->cylinder = 0.0f;
+    if (axis->cylinder > 100.0f) axis->cylinder = 100.0f;
+}
+
+static void axis_cascade(Cascade* cascade, float drive_limit, int propagate) {
+    cascade_init(cascade, BASE_DT);
+    cascade->propagate_windup = propagate;
+    cascade_add_loop(cascade, 6.0f, 1.0f, 0.0f, 20);
+    cascade_add_loop(cascade, 3.0f, 400.0f, 0.0f, 1);
+    cascade->loops[1].pid.output_min = -drive_limit;
+    cascade->loops[1].pid.output_max = drive_limit;
+    pid_update_coefficients(&cascade->loops[1].pid);
+    pid_set_setpoint(&cascade->loops[0].pid, 20.0f);
+    cascade_build(cascade);
+}
+
+// Largest overshoot of a 20% -> 80% move
+static float move_overshoot(Cascade* cascade) {
+    Axis axis = { 0.0f, 20.0f };
+    float measurements[2];
+    float overshoot = 0.0f;
+    pid_set_setpoint(&cascade->loops[0].pid, 80.0f);
+    for (int k = 0; k < 8000; k++) {
+        measurements[0] = axis.cylinder;
+        measurements[1] = axis.spool;
+        axis_update(&axis, cascade_step(cascade, measurements));
+        if (axis.cylinder - 80.0f > overshoot) overshoot = axis.cylinder - 80.0f;
+    }
+    return overshoot;
+}
+
+int main() {
+    Cascade cascade;
+    float measurements[CASCADE_MAX_LOOPS] = {0};
+
+    printf("Testing Multi-Rate Cascade Scheduler\n\n");
+    printf("Check                                  Measured    Expected\n");
+    printf("-------------------------------------  ----------  ----------\n");
+
+    // 1) Schedule: every loop runs exactly once per divisor ticks, and the
+    //    table covers the LCM of the divisors
+    cascade_init(&cascade, BASE_DT);
+    cascade_add_loop(&cascade, 1.0f, 0.0f, 0.0f, 4);
+    cascade_add_loop(&cascade, 1.0f, 0.0f, 0.0f, 6);
+    cascade_add_loop(&cascade, 1.0f, 0.0f, 0.0f, 1);
+    check("Build", cascade_build(&cascade), 0, 0);
+    check("Hyperperiod of 4, 6, 1", cascade.hyperperiod, 12, 0);
+    check("Table entries (3 + 2 + 12)", cascade.due_start[cascade.hyperperiod], 17, 0);
+    check("Tick 0 runs all loops", cascade.due_start[1] - cascade.due_start[0], 3, 0);
+    for (int k = 0; k < 1200; k++) cascade_step(&cascade, measurements);
+    check("Runs of the divisor-4 loop", (double)cascade.loops[0].runs, 300, 0);
+    check("Runs of the divisor-6 loop", (double)cascade.loops[1].runs, 200, 0);
+    check("Runs of the divisor-1 loop", (double)cascade.loops[2].runs, 1200, 0);
+    check("Outer sample time (s)", cascade.loops[0].pid.sample_time, 4 * BASE_DT, 1e-9);
+    cascade_free(&cascade);
+
+    // 2) Without saturation the scheduler is exactly the hand-written
+    //    "outer every 20th tick, inner every tick" loop
+    PIDController outer, inner;
+    Axis reference = { 0.0f, 20.0f }, axis = { 0.0f, 20.0f };
+    axis_cascade(&cascade, 100.0f, 1);
+    pid_init(&outer, 6.0f, 1.0f, 0.0f, 20 * BASE_DT);
+    pid_init(&inner, 3.0f, 400.0f, 0.0f, BASE_DT);
+    pid_set_setpoint(&outer, 25.0f);
+    pid_set_setpoint(&cascade.loops[0].pid, 25.0f);
+    float worst = 0.0f;
+    for (int k = 0; k < 6000; k++) {
+        if (k % 20 == 0) pid_set_setpoint(&inner, pid_compute(&outer, reference.cylinder));
+        axis_update(&reference, pid_compute(&inner, reference.spool));
+
+        measurements[0] = axis.cylinder;
+        measurements[1] = axis.spool;
+        axis_update(&axis, cascade_step(&cascade, measurements));
+        if (fabsf(axis.cylinder - reference.cylinder) > worst) worst = fabsf(axis.cylinder - reference.cylinder);
+    }
+    check("Worst difference from manual loop", worst, 0.0, 0.0);
+    check("Small move needs no holds", (double)cascade.loops[0].windup_holds, 0, 0);
+    cascade_free(&cascade);
+
+    // 3) A move the limited drive cannot follow: holding the outer integrator
+    //    while the spool loop is saturated prevents the windup overshoot
+    axis_cascade(&cascade, 60.0f, 1);
+    float held = move_overshoot(&cascade);
+    check("Overshoot with propagation < 1%", held < 1.0f, 1, 0);
+    check("Outer integration held", cascade.loops[0].windup_holds > 0, 1, 0);
+    cascade_free(&cascade);
+
+    axis_cascade(&cascade, 60.0f, 0);
+    float wound = move_overshoot(&cascade);
+    check("Overshoot without propagation > 5%", wound > 5.0f, 1, 0);
+    printf("Overshoot: %.2f%% with propagation, %.2f%% without\n", held, wound);
+    cascade_free(&cascade);
+
+    // 4) Both loops saturated: the hold takes the correction off the outer
+    //    loop's unclamped output, so a large error keeps it at its limit
+    cascade_init(&cascade, BASE_DT);
+    cascade_add_loop(&cascade, 10.0f, 50.0f, 0.0f, 1);
+    cascade_add_loop(&cascade, 10.0f, 0.0f, 0.0f, 1);
+    pid_set_setpoint(&cascade.loops[0].pid, 100.0f);
+    cascade_build(&cascade);
+    measurements[0] = 0.0f;
+    measurements[1] = 0.0f;
+    for (int k = 0; k < 100; k++) cascade_step(&cascade, measurements);
+    check("Outer loop held", (double)cascade.loops[0].windup_holds, 99, 0);
+    check("Outer output stays at its limit", cascade.loops[0].output, 100.0, 0.0);
+    check("Outer loop reports saturation", cascade.loops[0].saturation, 1, 0);
+    check("Inner output at its limit", cascade.loops[1].output, 100.0, 0.0);
+    cascade_free(&cascade);
+
+    // 5) Rejected configurations
+    cascade_init(&cascade, BASE_DT);
+    check("Empty cascade rejected", cascade_build(&cascade), -1, 0);
+    cascade_add_loop(&cascade, 1.0f, 0.0f, 0.0f, 251);
+    cascade_add_loop(&cascade, 1.0f, 0.0f, 0.0f, 257);
+    cascade_add_loop(&cascade, 1.0f, 0.0f, 0.0f, 3);
+    check("Oversized hyperperiod rejected", cascade_build(&cascade), -1, 0);
+    check("Zero divisor rejected", cascade_add_loop(&cascade, 1.0f, 0.0f, 0.0f, 0), -1, 0);
+    cascade_free(&cascade);
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
@@ -0,0 +1,17 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <stdio.h>
+#include <math.h>
+
+// Shared fixture for the numeric tests: check() prints one table row and
+// records a failure; main() ends with "Test FAILED" and exit status 1 if set
+static int failed = 0;
+
+static void check(const char* name, double value, double expected, double tolerance) {
+    int ok = fabs(value - expected) <= tolerance;
+    printf("%-36s %10.4f  %10.4f  %s\n", name, value, expected, ok ? "OK" : "FAIL");
+    if (!ok) failed = 1;
+}
+
+#endif // TEST_CHECK_H
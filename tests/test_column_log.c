@@ -0,0 +1,136 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "column_log.h"
+
+#define LOG_PATH   "test_column_log.hvcl"
+#define CSV_PATH   "test_column_log.csv"
+#define LOG_ROWS   2000000   // 20000 s at 100 Hz (~5.5 hours)
+#define SAMPLE_DT  0.01
+#define NUM_SLICES 1000
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Deterministic signal so any row can be checked without keeping the data
+static float expected_value(long row, int column) {
+    return (float)((row * (column + 3)) % 1000) * 0.1f;
+}
+
+// 1) Small CSV round trip through the importer
+static int check_import(void) {
+    FILE* csv = fopen(CSV_PATH, "w");
+    if (csv == NULL) return -1;
+    fprintf(csv, "Time,Setpoint,Position,Error,Command\n");
+    for (int i = 0; i < 2500; i++) {
+        fprintf(csv, "%.2f,%.1f,%.1f,%.1f,%.1f\n", i * 0.01, 50.0, i % 100 * 1.0, 1.5, -2.5);
+    }
+    fclose(csv);
+
+    if (column_log_import_csv(CSV_PATH, LOG_PATH) != 2500) return -1;
+
+    ColumnLog log;
+    if (column_log_open(&log, LOG_PATH) != 0) return -1;
+    int ok = log.rows == 2500 && log.num_columns == 5 &&
+             column_log_find(&log, "Position") == 2 &&
+             column_log_find(&log, "Missing") == -1;
+
+    uint64_t first, count;
+    column_log_slice(&log, 10.0, 10.05, &first, &count);
+    const float* position = column_log_values(&log, 2);
+    ok = ok && first == 1000 && count == 5 && position[first + 3] == 3.0f;
+
+    column_log_close(&log);
+    remove(CSV_PATH);
+    return ok ? 0 : -1;
+}
+
+int main() {
+    int failed = 0;
+
+    printf("Testing Columnar Log Format\n\n");
+
+    if (check_import() != 0) {
+        printf("CSV import round trip: FAIL\n");
+        failed = 1;
+    } else {
+        printf("CSV import round trip: OK\n");
+    }
+
+    // 2) Large log written row by row
+    const char* names[] = {"Setpoint", "Position", "Error", "Command"};
+    ColumnLogWriter writer;
+    double t0 = now_s();
+    if (column_log_writer_open(&writer, LOG_PATH, names, 4) != 0) {
+        printf("Error opening %s!\n", LOG_PATH);
+        return 1;
+    }
+    for (long r = 0; r < LOG_ROWS; r++) {
+        float values[4];
+        for (int c = 0; c < 4; c++) values[c] = expected_value(r, c);
+        column_log_writer_append(&writer, r * SAMPLE_DT, values);
+    }
+    if (column_log_writer_close(&writer) != 0) {
+        printf("Error writing %s!\n", LOG_PATH);
+        return 1;
+    }
+    double write_s = now_s() - t0;
+
+    ColumnLog log;
+    t0 = now_s();
+    if (column_log_open(&log, LOG_PATH) != 0) {
+        printf("Error opening %s for reading!\n", LOG_PATH);
+        return 1;
+    }
+    double open_s = now_s() - t0;
+
+    // 3) Random windows: indexed slice vs. full scan of the Time column
+    srand(12345);
+    int mismatches = 0;
+    double slice_s = 0.0;
+    double scan_s = 0.0;
+    for (int i = 0; i < NUM_SLICES; i++) {
+        double start = (rand() % (LOG_ROWS + 2000)) * SAMPLE_DT - 10.0 + 0.005 * (i % 3);
+        double end = start + (rand() % 1000) * SAMPLE_DT;
+
+        uint64_t first, count;
+        t0 = now_s();
+        column_log_slice(&log, start, end, &first, &count);
+        slice_s += now_s() - t0;
+
+        t0 = now_s();
+        uint64_t scan_first = 0, scan_count = 0;
+        while (scan_first < log.rows && log.time[scan_first] < start) scan_first++;
+        while (scan_first + scan_count < log.rows && log.time[scan_first + scan_count] < end) scan_count++;
+        scan_s += now_s() - t0;
+
+        if (first != scan_first || count != scan_count) mismatches++;
+        if (count > 0) {
+            const float* command = column_log_values(&log, 4) + first;
+            if (command[count - 1] != expected_value((long)(first + count - 1), 3)) mismatches++;
+        }
+    }
+    if (mismatches > 0) failed = 1;
+
+    printf("Rows: %ld (%.1f MB)\n", (long)log.rows, log.size / 1048576.0);
+    printf("Write: %.3f s  Open (mmap): %.3f ms\n", write_s, open_s * 1000.0);
+    printf("Slice lookups: %d, mismatches vs full scan: %d\n", NUM_SLICES, mismatches);
+    printf("Average slice time: indexed %.3f us, full scan %.3f us\n",
+           slice_s / NUM_SLICES * 1e6, scan_s / NUM_SLICES * 1e6);
+
+    column_log_close(&log);
+    remove(LOG_PATH);
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
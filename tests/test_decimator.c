@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <math.h>
+#include "decimator.h"
+#include "rng.h"
+#include "test_check.h"
+
+#define SAMPLES 1037 // Not a multiple of the window: the last window is partial
+#define WINDOW  50
+#define SIGNALS 3
+
+static float times[SAMPLES];
+static float data[SAMPLES][SIGNALS];
+
+// Collected sink output
+typedef struct {
+    DecimatorWindow windows[64];
+    int count;
+} Collected;
+
+static void collect(const DecimatorWindow* window, void* context) {
+    Collected* c = (Collected*)context;
+    if (c->count < 64) c->windows[c->count] = *window;
+    c->count++;
+}
+
+// Reference LTTB over the whole array with the same buckets: anchor starts
+// at the first sample, the next point is the next bucket's mean (or the last
+// sample for the final bucket)
+static void reference_lttb(int s, float* point_time, float* point_value, int buckets) {
+    float at = times[0], av = data[0][s];
+    for (int b = 0; b < buckets; b++) {
+        int begin = b * WINDOW;
+        int end = begin + WINDOW < SAMPLES ? begin + WINDOW : SAMPLES;
+        float ct, cv;
+        if (b + 1 < buckets) {
+            int next_end = end + WINDOW < SAMPLES ? end + WINDOW : SAMPLES;
+            double st = 0.0, sv = 0.0;
+            for (int i = end; i < next_end; i++) {
+                st += times[i];
+                sv += data[i][s];
+            }
+            ct = (float)(st / (next_end - end));
+            cv = (float)(sv / (next_end - end));
+        } else {
+            ct = times[SAMPLES - 1];
+            cv = data[SAMPLES - 1][s];
+        }
+        float best_area = -1.0f;
+        int best = begin;
+        for (int i = begin; i < end; i++) {
+            float area = fabsf((at - ct) * (data[i][s] - av) - (at - times[i]) * (cv - av));
+            if (area > best_area) {
+                best_area = area;
+                best = i;
+            }
+        }
+        point_time[b] = times[best];
+        point_value[b] = data[best][s];
+        at = point_time[b];
+        av = point_value[b];
+    }
+}
+
+int main() {
+    Decimator decimator;
+    Collected stats = {0}, lttb = {0};
+    Rng rng;
+    int buckets = (SAMPLES + WINDOW - 1) / WINDOW;
+
+    // Smooth signal with a one-sample spike, a noisy signal, and a command
+    // that saturates for a few samples
+    rng_seed(&rng, 19, 0);
+    for (int i = 0; i < SAMPLES; i++) {
+        times[i] = i * 0.01f;
+        data[i][0] = 50.0f + 20.0f * sinf(times[i]) + (i == 333 ? 30.0f : 0.0f);
+        data[i][1] = 10.0f * rng_uniform(&rng);
+        data[i][2] = (i >= 610 && i < 613) ? 100.0f : 40.0f + 10.0f * rng_uniform(&rng);
+    }
+
+    printf("Testing Decimator\n\n");
+    printf("Check                                  Measured    Expected\n");
+    printf("-------------------------------------  ----------  ----------\n");
+
+    // 1) Stats mode: min/max/mean/last per window against a direct computation
+    decimator_init(&decimator, SIGNALS, WINDOW, 0);
+    decimator_add_sink(&decimator, collect, &stats);
+    for (int i = 0; i < SAMPLES; i++) decimator_push(&decimator, times[i], data[i]);
+    check("Full windows before flush", stats.count, SAMPLES / WINDOW, 0);
+    decimator_flush(&decimator);
+    decimator_free(&decimator);
+    check("Windows after flush", stats.count, buckets, 0);
+    check("Partial last window count", stats.windows[buckets - 1].count, SAMPLES % WINDOW, 0);
+
+    double worst = 0.0;
+    for (int b = 0; b < buckets; b++) {
+        const DecimatorWindow* w = &stats.windows[b];
+        int begin = b * WINDOW;
+        int end = begin + w->count;
+        for (int s = 0; s < SIGNALS; s++) {
+            float lo = data[begin][s], hi = data[begin][s];
+            double sum = 0.0;
+            for (int i = begin; i < end; i++) {
+                if (data[i][s] < lo) lo = data[i][s];
+                if (data[i][s] > hi) hi = data[i][s];
+                sum += data[i][s];
+            }
+            worst = fmax(worst, fabs(w->min[s] - lo));
+            worst = fmax(worst, fabs(w->max[s] - hi));
+            worst = fmax(worst, fabs(w->mean[s] - sum / (end - begin)));
+            worst = fmax(worst, fabs(w->last[s] - data[end - 1][s]));
+        }
+        worst = fmax(worst, fabs(w->start_time - times[begin]));
+        worst = fmax(worst, fabs(w->end_time - times[end - 1]));
+    }
+    check("Worst stats error", worst, 0.0, 1e-4);
+    check("Spike kept in window max", stats.windows[333 / WINDOW].max[0], data[333][0], 0.0);
+    check("Saturation kept in window max", stats.windows[610 / WINDOW].max[2], 100.0, 0.0);
+
+    // 2) LTTB mode: same windows one window late, points equal the batch algorithm
+    decimator_init(&decimator, SIGNALS, WINDOW, 1);
+    decimator_add_sink(&decimator, collect, &lttb);
+    for (int i = 0; i < SAMPLES; i++) decimator_push(&decimator, times[i], data[i]);
+    check("LTTB windows before flush", lttb.count, SAMPLES / WINDOW - 1, 0);
+    decimator_flush(&decimator);
+    decimator_free(&decimator);
+    check("LTTB windows after flush", lttb.count, buckets, 0);
+
+    int mismatches = 0;
+    float point_time[64], point_value[64];
+    for (int s = 0; s < SIGNALS; s++) {
+        reference_lttb(s, point_time, point_value, buckets);
+        for (int b = 0; b < buckets; b++) {
+            if (lttb.windows[b].index != b ||
+                lttb.windows[b].point_time[s] != point_time[b] ||
+                lttb.windows[b].point_value[s] != point_value[b]) mismatches++;
+        }
+    }
+    check("LTTB points differing from batch", mismatches, 0, 0);
+    check("LTTB keeps the spike", lttb.windows[333 / WINDOW].point_value[0], data[333][0], 0.0);
+    check("LTTB keeps the saturation", lttb.windows[610 / WINDOW].point_value[2], 100.0, 0.0);
+    check("LTTB window stats match stats mode", lttb.windows[7].mean[1], stats.windows[7].mean[1], 0.0);
+
+    // 3) Rejected configurations
+    check("Zero window rejected", decimator_init(&decimator, 1, 0, 0), -1, 0);
+    check("Too many signals rejected", decimator_init(&decimator, DECIMATOR_MAX_SIGNALS + 1, 10, 0), -1, 0);
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
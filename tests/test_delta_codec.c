@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "pid_controller.h"
+#include "valve_simulator.h"
+#include "delta_codec.h"
+
+#define STREAM_PATH  "test_delta_codec.hvdc"
+#define SAMPLE_TIME  0.01f
+#define TOTAL_STEPS  360000 // One hour at 100 Hz
+#define NUM_SEEKS    200
+
+// Signals exactly as main.c logs them
+static const DeltaSignal signals[5] = {
+    {"Time", 0.01}, {"Setpoint", 0.1}, {"Position", 0.1}, {"Error", 0.1}, {"Command", 0.1}
+};
+
+// One hour of closed loop with a new setpoint every 30 s
+static void simulate_row(PIDController* pid, ValveSimulator* valve, long tick, double* row) {
+    static const float setpoints[] = {50.0f, 75.0f, 25.0f, 100.0f, 60.0f, 0.0f};
+    if (tick % 3000 == 0) pid_set_setpoint(pid, setpoints[(tick / 3000) % 6]);
+
+    float command = pid_compute(pid, valve->position);
+    if (command < 0.0f) command = 0.0f;
+    if (command > 100.0f) command = 100.0f;
+    valve_update(valve, command, SAMPLE_TIME);
+
+    row[0] = tick * 0.01;
+    row[1] = pid->setpoint;
+    row[2] = valve->position;
+    row[3] = pid->setpoint - valve->position;
+    row[4] = command;
+}
+
+// Drop the last bytes of a file, as if the writer died mid-block
+static int truncate_file(const char* path, long bytes) {
+    FILE* in = fopen(path, "rb");
+    if (in == NULL) return -1;
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    rewind(in);
+    char* data = malloc(size);
+    size_t got = (data != NULL) ? fread(data, 1, size, in) : 0;
+    fclose(in);
+
+    FILE* out = fopen(path, "wb");
+    if (out == NULL || got != (size_t)size) {
+        if (out != NULL) fclose(out);
+        free(data);
+        return -1;
+    }
+    fwrite(data, 1, size - bytes, out);
+    fclose(out);
+    free(data);
+    return 0;
+}
+
+int main() {
+    int failed = 0;
+    PIDController pid;
+    ValveSimulator valve;
+    DeltaEncoder encoder;
+    double row[5];
+    char text[128];
+
+    printf("Testing Delta/Varint Telemetry Codec\n\n");
+
+    pid_init(&pid, 5.0f, 4.0f, 0.1f, SAMPLE_TIME);
+    valve_init(&valve, 0.2f, 0.0f);
+    if (delta_encoder_open(&encoder, STREAM_PATH, signals, 5, 0) != 0) {
+        printf("Error opening %s!\n", STREAM_PATH);
+        return 1;
+    }
+
+    // Encode, and count what the same rows cost as main.c CSV text
+    long csv_bytes = 0;
+    for (long tick = 0; tick < TOTAL_STEPS; tick++) {
+        simulate_row(&pid, &valve, tick, row);
+        csv_bytes += snprintf(text, sizeof(text), "%.2f,%.1f,%.1f,%.1f,%.1f\n",
+                              row[0], row[1], row[2], row[3], row[4]);
+        delta_encoder_append(&encoder, row);
+    }
+    if (delta_encoder_close(&encoder) != 0) failed = 1;
+    long packed_bytes = (long)encoder.bytes_written;
+
+    // 1) Decode everything and compare against a second identical simulation
+    DeltaDecoder decoder;
+    double decoded[5];
+    double max_error[5] = {0};
+    long rows = 0;
+    pid_init(&pid, 5.0f, 4.0f, 0.1f, SAMPLE_TIME);
+    valve_init(&valve, 0.2f, 0.0f);
+    if (delta_decoder_open(&decoder, STREAM_PATH) != 0) {
+        printf("Error reading %s!\n", STREAM_PATH);
+        return 1;
+    }
+    while (delta_decoder_next(&decoder, decoded) == 1) {
+        simulate_row(&pid, &valve, rows, row);
+        for (int s = 0; s < 5; s++) {
+            double e = fabs(decoded[s] - row[s]);
+            if (e > max_error[s]) max_error[s] = e;
+        }
+        rows++;
+    }
+    if (rows != TOTAL_STEPS) failed = 1;
+
+    printf("Signal    Resolution  Max error\n");
+    printf("--------  ----------  ---------\n");
+    for (int s = 0; s < 5; s++) {
+        printf("%-8s  %-10.2f  %.4f\n", signals[s].name, signals[s].resolution, max_error[s]);
+        if (max_error[s] > signals[s].resolution * 0.5 + 1e-6) failed = 1;
+    }
+
+    // 2) Seeks land on the first row at or after the requested time
+    srand(7);
+    int bad_seeks = 0;
+    for (int i = 0; i < NUM_SEEKS; i++) {
+        double t = (rand() % (TOTAL_STEPS + 100)) * 0.01 - 0.5 + 0.003 * (i % 4);
+        double expected = ceil(t * 100.0 - 1e-9) / 100.0;
+        if (expected < 0.0) expected = 0.0;
+        int status = delta_decoder_seek(&decoder, t);
+        int got = delta_decoder_next(&decoder, decoded);
+        int past_end = expected > (TOTAL_STEPS - 1) * 0.01 + 1e-9;
+        if (status != 0) bad_seeks++;
+        else if (past_end && got != 0) bad_seeks++;
+        else if (!past_end && (got != 1 || fabs(decoded[0] - expected) > 1e-6)) bad_seeks++;
+    }
+    delta_decoder_close(&decoder);
+    if (bad_seeks > 0) failed = 1;
+
+    // 3) A truncated stream is reported as an error, not misread
+    if (truncate_file(STREAM_PATH, 37) != 0) failed = 1;
+    int status = 0;
+    long truncated_rows = 0;
+    if (delta_decoder_open(&decoder, STREAM_PATH) == 0) {
+        while ((status = delta_decoder_next(&decoder, decoded)) == 1) truncated_rows++;
+        delta_decoder_close(&decoder);
+    }
+    remove(STREAM_PATH);
+    if (status != -1) failed = 1;
+
+    printf("\nRows: %ld (one hour at 100 Hz)\n", rows);
+    printf("CSV text: %ld bytes (%.1f bytes/row)\n", csv_bytes, (double)csv_bytes / TOTAL_STEPS);
+    printf("Packed:   %ld bytes (%.2f bytes/row), ratio %.1fx\n",
+           packed_bytes, (double)packed_bytes / TOTAL_STEPS, (double)csv_bytes / packed_bytes);
+    printf("Seeks: %d, wrong: %d\n", NUM_SEEKS, bad_seeks);
+    printf("Truncated stream: %ld rows then %s\n", truncated_rows, status == -1 ? "error" : "no error");
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
@@ -0,0 +1,156 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "pid_controller.h"
+#include "valve_simulator.h"
+#include "pid_fixed.h"
+#include "valve_fixed.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLE_UNIT "cycles"
+static uint64_t read_cycles(void) { return __rdtsc(); }
+#else
+#define CYCLE_UNIT "ns"
+static uint64_t read_cycles(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+#define SAMPLE_TIME   0.01f
+#define TIMING_REPEAT 200
+
+// The three recorded scenarios (data/day4 baseline, data/day5 tests)
+typedef struct {
+    const char* name;
+    int steps;
+    float filter_coeff; // < 0 = leave default
+    float rate_limit;
+    float ramp_rate;
+} Scenario;
+
+static const Scenario scenarios[] = {
+    {"baseline (main.c)",        1500, -1.0f,   0.0f,  0.0f},
+    {"advanced_features_test",   1000,  0.1f, 100.0f,  0.0f},
+    {"setpoint_ramping_test",    1000,  0.1f, 100.0f, 10.0f},
+};
+
+static volatile float sink_f;
+static volatile q16_t sink_q;
+
+static void run_float(const Scenario* s, float* positions, float* commands) {
+    PIDController pid;
+    ValveSimulator valve;
+
+    pid_init(&pid, 5.0f, 4.0f, 0.1f, SAMPLE_TIME);
+    if (s->filter_coeff >= 0.0f) pid_set_derivative_filter(&pid, s->filter_coeff);
+    pid_set_rate_limit(&pid, s->rate_limit);
+    pid_set_ramp_rate(&pid, s->ramp_rate);
+    pid_set_setpoint(&pid, 50.0f);
+    valve_init(&valve, 0.2f, 0.0f);
+    valve.disturbance = 0.0f;
+
+    for (int i = 0; i < s->steps; i++) {
+        if (i == 500) pid_set_setpoint_ramped(&pid, 75.0f);
+        float cmd = pid_compute(&pid, valve.position);
+        if (cmd < 0.0f) cmd = 0.0f;
+        if (cmd > 100.0f) cmd = 100.0f;
+        valve_update(&valve, cmd, SAMPLE_TIME);
+        if (positions) {
+            positions[i] = valve.position;
+            commands[i] = cmd;
+        }
+    }
+    sink_f = valve.position;
+}
+
+static void run_fixed(const Scenario* s, float* positions, float* commands) {
+    PIDControllerQ16 pid;
+    ValveSimulatorQ16 valve;
+
+    pid_q16_init(&pid, 5.0f, 4.0f, 0.1f, SAMPLE_TIME);
+    if (s->filter_coeff >= 0.0f) pid_q16_set_derivative_filter(&pid, s->filter_coeff);
+    pid_q16_set_rate_limit(&pid, s->rate_limit);
+    pid_q16_set_ramp_rate(&pid, s->ramp_rate);
+    pid_q16_set_setpoint(&pid, 50 * Q16_ONE);
+    valve_q16_init(&valve, 0.2f, 0.0f, SAMPLE_TIME);
+
+    for (int i = 0; i < s->steps; i++) {
+        if (i == 500) pid_q16_set_setpoint_ramped(&pid, 75 * Q16_ONE);
+        q16_t cmd = q16_clamp(pid_q16_compute(&pid, valve.position), 0, 100 * Q16_ONE);
+        valve_q16_update(&valve, cmd);
+        if (positions) {
+            positions[i] = Q16_TO_FLOAT(valve.position);
+            commands[i] = Q16_TO_FLOAT(cmd);
+        }
+    }
+    sink_q = valve.position;
+}
+
+int main() {
+    static float pos_f[1500], cmd_f[1500], pos_q[1500], cmd_q[1500];
+
+    printf("Fixed-Point (Q16.16) vs Float Controller\n");
+    printf("- Errors in %% (fixed minus float trajectory)\n");
+    printf("- Cost in %s per closed-loop step (PID + valve)\n\n", CYCLE_UNIT);
+    printf("Scenario                  MaxPosErr  RMSPosErr  MaxCmdErr  Float   Fixed\n");
+    printf("------------------------  ---------  ---------  ---------  ------  ------\n");
+
+    int failed = 0;
+    int count = (int)(sizeof(scenarios) / sizeof(scenarios[0]));
+    for (int s = 0; s < count; s++) {
+        const Scenario* sc = &scenarios[s];
+
+        run_float(sc, pos_f, cmd_f);
+        run_fixed(sc, pos_q, cmd_q);
+
+        float max_pos = 0.0f, max_cmd = 0.0f;
+        double sum_sq = 0.0;
+        for (int i = 0; i < sc->steps; i++) {
+            float dp = fabsf(pos_f[i] - pos_q[i]);
+            float dc = fabsf(cmd_f[i] - cmd_q[i]);
+            if (dp > max_pos) max_pos = dp;
+            if (dc > max_cmd) max_cmd = dc;
+            sum_sq += (double)dp * dp;
+        }
+        float rms_pos = (float)sqrt(sum_sq / sc->steps);
+
+        // Closed-loop cost per step (controller + plant), no recording
+        uint64_t t0 = read_cycles();
+        for (int r = 0; r < TIMING_REPEAT; r++) run_float(sc, NULL, NULL);
+        uint64_t t1 = read_cycles();
+        for (int r = 0; r < TIMING_REPEAT; r++) run_fixed(sc, NULL, NULL);
+        uint64_t t2 = read_cycles();
+
+        double steps = (double)TIMING_REPEAT * sc->steps;
+        printf("%-24s  %-9.4f  %-9.4f  %-9.4f  %-6.1f  %.1f\n",
+               sc->name, max_pos, rms_pos, max_cmd,
+               (double)(t1 - t0) / steps, (double)(t2 - t1) / steps);
+
+        // Positions should agree to well inside the 0.1% logging resolution
+        if (max_pos > 0.1f) failed = 1;
+    }
+
+    // Coefficients out of the Q16 range saturate instead of overflowing the cast:
+    // kd = 1 unfiltered at 100 kHz needs a derivative gain of 1e5
+    PIDControllerQ16 fast;
+    pid_q16_init(&fast, 1e6f, 0.0f, 1.0f, 1e-5f);
+    pid_q16_set_derivative_filter(&fast, 1.0f);
+    int saturated = fast.c_kp == Q16_MAX && fast.c_d_gain == Q16_MAX &&
+                    q16_from_float(-1e9f) == Q16_MIN && q16_from_float(NAN) == 0 &&
+                    q16_from_float(-1.5f) == -3 * Q16_ONE / 2;
+    printf("\nOut-of-range coefficients saturate: %s\n", saturated ? "OK" : "FAIL");
+    if (!saturated) failed = 1;
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
@@ -0,0 +1,102 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <math.h>
+#include <complex.h>
+#include <time.h>
+#include "pid_controller.h"
+#include "plant_bank.h"
+#include "freq_response.h"
+#include "test_check.h"
+
+#define POINTS 40
+#define PI_D   3.14159265358979323846
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Exact loop gain of a P controller on the sampled first-order valve:
+// position[n+1] = a position[n] + (1 - a) command[n]  ->  kp (1 - a) / (z - a)
+static double complex p_loop_gain(double kp, double tau, double dt, double f) {
+    double a = exp(-dt / tau);
+    double complex z = cexp(I * 2.0 * PI_D * f * dt);
+    return kp * (1.0 - a) / (z - a);
+}
+
+int main() {
+    PIDController pid;
+    PlantParams plant;
+    FreqOptions options;
+    FreqPoint points[POINTS];
+    FreqPoint other[POINTS];
+    FreqMargins margins;
+
+    printf("Testing Frequency Response\n\n");
+    printf("Check                                  Measured    Expected\n");
+    printf("-------------------------------------  ----------  ----------\n");
+
+    plant_params_default(&plant);
+    freq_options_default(&options);
+    options.points = POINTS;
+
+    // 1) Linear loop: matches the analytic response at every frequency
+    pid_init(&pid, 5.0f, 0.0f, 0.0f, 0.01f);
+    check("P-only sweep runs", freq_response_run(&pid, &plant, &options, points), 0, 0);
+    double worst_gain = 0.0, worst_phase = 0.0, worst_closed = 0.0;
+    for (int k = 0; k < POINTS; k++) {
+        double complex l = p_loop_gain(5.0, plant.time_constant, 0.01, points[k].frequency);
+        double complex t = l / (1.0 + l);
+        worst_gain = fmax(worst_gain, fabs(points[k].open_gain - 20.0 * log10(cabs(l))));
+        worst_phase = fmax(worst_phase, fabs(points[k].open_phase - carg(l) * 180.0 / PI_D));
+        worst_closed = fmax(worst_closed, fabs(points[k].closed_gain - 20.0 * log10(cabs(t))));
+    }
+    check("Worst |L| error (dB)", worst_gain, 0.0, 0.01);
+    check("Worst L phase error (deg)", worst_phase, 0.0, 0.1);
+    check("Worst |T| error (dB)", worst_closed, 0.0, 0.01);
+    check("Frequencies rise", points[1].frequency > points[0].frequency, 1, 0);
+    check("First frequency (snapped)", points[0].frequency, options.f_min, 0.001);
+
+    // 2) Baseline PID: integral action, finite margins
+    pid_init(&pid, 5.0f, 4.0f, 0.1f, 0.01f);
+    double start = now_s();
+    freq_response_run(&pid, &plant, &options, points);
+    double elapsed = now_s() - start;
+    freq_response_margins(points, POINTS, &margins);
+    check("Tracks slow setpoints (|T| dB)", points[0].closed_gain, 0.0, 0.1);
+    check("Crossover found", isfinite(margins.crossover), 1, 0);
+    check("Phase margin positive", margins.phase_margin > 0.0f, 1, 0);
+    check("Bandwidth above crossover/2", margins.bandwidth > 0.5f * margins.crossover, 1, 0);
+    check("Integral rejects slow errors (|S|)", points[0].sensitivity < -20.0f, 1, 0);
+    check("40-point sweep under a second", elapsed < 1.0, 1, 0);
+
+    // 3) Disturbance injection measures the same loop gain
+    options.injection = FREQ_INJECT_DISTURBANCE;
+    freq_response_run(&pid, &plant, &options, other);
+    double worst_match = 0.0;
+    for (int k = 0; k < POINTS; k++) {
+        worst_match = fmax(worst_match, fabs(other[k].open_gain - points[k].open_gain));
+    }
+    check("Setpoint vs disturbance |L| (dB)", worst_match, 0.0, 0.05);
+    options.injection = FREQ_INJECT_SETPOINT;
+
+    // 4) A heavier derivative filter costs phase at crossover
+    FreqMargins filtered;
+    pid_set_derivative_filter(&pid, 0.02f);
+    freq_response_run(&pid, &plant, &options, other);
+    freq_response_margins(other, POINTS, &filtered);
+    check("Filter lowers phase margin", filtered.phase_margin < margins.phase_margin, 1, 0);
+
+    // 5) Bad options are rejected
+    options.f_max = 40.0f; // Under 4 samples per period at 100 Hz
+    check("Frequency too high rejected", freq_response_run(&pid, &plant, &options, points), -1, 0);
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
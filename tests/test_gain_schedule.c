@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <math.h>
+#include "pid_controller.h"
+#include "pid_bank.h"
+#include "gain_schedule.h"
+#include "rng.h"
+#include "test_check.h"
+
+#define CHANNELS 64
+#define STEPS    2000
+
+int main() {
+    GainSchedule schedule;
+    PIDController pid;
+    float kp, ki, kd;
+
+    // Baseline gains mid-stroke, softer towards the ends
+    const GainPoint points[3] = {
+        { 10.0f, 3.0f, 2.0f, 0.05f },
+        { 50.0f, 5.0f, 4.0f, 0.1f },
+        { 90.0f, 3.0f, 2.0f, 0.05f }
+    };
+
+    printf("Testing Gain Schedule\n\n");
+    printf("Check                                  Measured    Expected\n");
+    printf("-------------------------------------  ----------  ----------\n");
+
+    // 1) Table lookups: exact at the points, linear between them, flat outside
+    check("Table builds", gain_schedule_init(&schedule, GAIN_SCHEDULE_MEASUREMENT, 0.0f, 100.0f,
+                                             101, points, 3), 0, 0);
+    gain_schedule_lookup(&schedule, 50.0f, &kp, &ki, &kd);
+    check("kp at 50%", kp, 5.0, 1e-6);
+    gain_schedule_lookup(&schedule, 30.0f, &kp, &ki, &kd);
+    check("ki at 30% (halfway)", ki, 3.0, 1e-5);
+    gain_schedule_lookup(&schedule, 70.25f, &kp, &ki, &kd);
+    check("kp at 70.25% (between entries)", kp, 5.0 - 2.0 * 20.25 / 40.0, 1e-5);
+    gain_schedule_lookup(&schedule, 3.0f, &kp, &ki, &kd);
+    check("kd below the first point", kd, 0.05, 1e-7);
+    gain_schedule_lookup(&schedule, 250.0f, &kp, &ki, &kd);
+    check("kp beyond the table", kp, 3.0, 1e-6);
+    gain_schedule_lookup(&schedule, NAN, &kp, &ki, &kd);
+    check("NaN maps into the table", isfinite(kp) && kp >= 3.0f && kp <= 5.0f, 1, 0);
+
+    // 2) Bumpless: the integral term ki * integral survives a gain change
+    pid_init(&pid, 5.0f, 4.0f, 0.1f, 0.01f);
+    pid.integral = 7.5f;
+    float i_term = pid.ki * pid.integral;
+    gain_schedule_apply(&schedule, &pid, 10.0f);
+    check("Scheduled ki at 10%", pid.ki, 2.0, 1e-6);
+    check("Integral term kept", pid.ki * pid.integral, i_term, 1e-5);
+    check("Anti-windup limit follows ki", pid.integral_max, pid.output_max / pid.ki, 1e-4);
+    pid_set_gains_bumpless(&pid, 5.0f, 8.0f, 0.1f);
+    check("pid_set_gains_bumpless keeps it", pid.ki * pid.integral, i_term, 1e-5);
+    pid_set_gains_bumpless(&pid, 5.0f, 0.0f, 0.1f);
+    check("ki = 0 clears the integral", pid.integral, 0.0, 0.0);
+
+    // 3) A scheduled closed loop crossing the stroke never kicks the output:
+    //    compare with switching the same gains by pid_set_gains()
+    float position = 5.0f, worst_bumpless = 0.0f, worst_plain = 0.0f;
+    PIDController plain;
+    pid_init(&pid, 3.0f, 2.0f, 0.05f, 0.01f);
+    pid_init(&plain, 3.0f, 2.0f, 0.05f, 0.01f);
+    pid_set_setpoint(&pid, 95.0f);
+    pid_set_setpoint(&plain, 95.0f);
+    for (int k = 0; k < 1500; k++) {
+        // Same state, new gains: the output difference is the transfer bump
+        float before = pid.ki * pid.integral;
+        plain = pid;
+        gain_schedule_apply(&schedule, &pid, position);
+        pid_set_gains(&plain, pid.kp, pid.ki, pid.kd);
+        float bump = fabsf(pid.ki * pid.integral - before);
+        float plain_bump = fabsf(plain.ki * plain.integral - before);
+        if (bump > worst_bumpless) worst_bumpless = bump;
+        if (plain_bump > worst_plain) worst_plain = plain_bump;
+
+        float command = pid_compute(&pid, position);
+        position += (command - position) * (1.0f - expf(-0.01f / 0.2f));
+    }
+    printf("(largest integral-term jump with pid_set_gains: %.4f%%)\n", worst_plain);
+    check("Largest integral-term jump (%)", worst_bumpless, 0.0, 1e-4);
+    check("Reaches the top of the stroke", position, 95.0, 0.5);
+    gain_schedule_free(&schedule);
+
+    // 4) Batch apply matches the scalar path bit for bit (setpoint-indexed)
+    PIDBank bank;
+    PIDController scalar[CHANNELS];
+    float measurements[CHANNELS], outputs[CHANNELS];
+    Rng rng;
+    rng_seed(&rng, 21, 0);
+    gain_schedule_init(&schedule, GAIN_SCHEDULE_SETPOINT, 0.0f, 100.0f, 64, points, 3);
+    pid_bank_init(&bank, CHANNELS);
+    for (int i = 0; i < CHANNELS; i++) {
+        pid_init(&scalar[i], 5.0f, 4.0f, 0.1f, 0.01f);
+        pid_set_setpoint(&scalar[i], 100.0f * rng_uniform(&rng));
+        pid_bank_load(&bank, i, &scalar[i]);
+    }
+    int mismatches = 0;
+    for (int k = 0; k < STEPS; k++) {
+        for (int i = 0; i < CHANNELS; i++) measurements[i] = 100.0f * rng_uniform(&rng);
+        if (k % 500 == 0) {
+            for (int i = 0; i < CHANNELS; i++) {
+                float setpoint = 100.0f * rng_uniform(&rng);
+                pid_set_setpoint(&scalar[i], setpoint);
+                pid_bank_set_setpoint(&bank, i, setpoint);
+            }
+        }
+        gain_schedule_apply_bank(&schedule, &bank, measurements, CHANNELS);
+        pid_bank_compute(&bank, measurements, outputs, CHANNELS);
+        for (int i = 0; i < CHANNELS; i++) {
+            gain_schedule_apply(&schedule, &scalar[i], measurements[i]);
+            float output = pid_compute(&scalar[i], measurements[i]);
+            if (output != outputs[i] || scalar[i].integral != bank.integral[i]) mismatches++;
+        }
+    }
+    check("Bank vs scalar mismatches", mismatches, 0, 0);
+    pid_bank_free(&bank);
+    gain_schedule_free(&schedule);
+
+    // 5) Invalid tables are rejected
+    check("Single-entry table rejected",
+          gain_schedule_init(&schedule, GAIN_SCHEDULE_SETPOINT, 0.0f, 100.0f, 1, points, 3), -1, 0);
+    check("Empty range rejected",
+          gain_schedule_init(&schedule, GAIN_SCHEDULE_SETPOINT, 50.0f, 50.0f, 11, points, 3), -1, 0);
+    const GainPoint unordered[2] = { { 60.0f, 5.0f, 4.0f, 0.1f }, { 40.0f, 3.0f, 2.0f, 0.0f } };
+    check("Unordered points rejected",
+          gain_schedule_init(&schedule, GAIN_SCHEDULE_SETPOINT, 0.0f, 100.0f, 11, unordered, 2), -1, 0);
+    const GainPoint no_integral[2] = { { 40.0f, 3.0f, 0.0f, 0.0f }, { 60.0f, 5.0f, 4.0f, 0.1f } };
+    check("Point with ki = 0 rejected",
+          gain_schedule_init(&schedule, GAIN_SCHEDULE_SETPOINT, 0.0f, 100.0f, 11, no_integral, 2), -1, 0);
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
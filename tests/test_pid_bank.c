@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <math.h>
+#include "pid_controller.h"
+#include "pid_bank.h"
+#include "valve_simulator.h"
+
+#define NUM_CHANNELS 256
+#define NUM_STEPS    1500
+#define TOLERANCE    1e-4f
+
+int main() {
+    static PIDController scalar[NUM_CHANNELS];
+    static ValveSimulator scalar_valve[NUM_CHANNELS];
+    static ValveSimulator bank_valve[NUM_CHANNELS];
+    static float measurements[NUM_CHANNELS];
+    static float outputs[NUM_CHANNELS];
+    PIDBank bank;
+
+    if (pid_bank_init(&bank, NUM_CHANNELS) != 0) {
+        printf("Error allocating PID bank!\n");
+        return -1;
+    }
+
+    // Spread channels over every feature combination and a range of gains
+    for (int i = 0; i < NUM_CHANNELS; i++) {
+        PIDController* pid = &scalar[i];
+        pid_init(pid, 3.0f + 0.02f * i, 1.0f + 0.01f * i, 0.05f + 0.001f * i, 0.01f);
+        pid_set_derivative_filter(pid, (i & 1) ? 0.1f : 1.0f);
+        pid_set_rate_limit(pid, (i & 2) ? 100.0f : 0.0f);
+        pid_set_ramp_rate(pid, (i & 4) ? 10.0f : 0.0f);
+        pid_set_setpoint(pid, 50.0f);
+        pid_bank_load(&bank, i, pid);
+
+        valve_init(&scalar_valve[i], 0.1f + 0.001f * i, 0.0f);
+        scalar_valve[i].disturbance = 0.0f;
+        bank_valve[i] = scalar_valve[i];
+    }
+
+    printf("Testing PID Bank vs Scalar pid_compute\n");
+    printf("- Channels: %d\n", NUM_CHANNELS);
+    printf("- Steps: %d\n", NUM_STEPS);
+    printf("- Tolerance: %g\n\n", TOLERANCE);
+
+    float max_diff = 0.0f;
+    int exact = 1;
+
+    for (int step = 0; step < NUM_STEPS; step++) {
+        // Setpoint change at 5 seconds
+        if (step == 500) {
+            for (int i = 0; i < NUM_CHANNELS; i++) {
+                pid_set_setpoint_ramped(&scalar[i], 75.0f);
+                pid_bank_set_setpoint_ramped(&bank, i, 75.0f);
+            }
+        }
+
+        for (int i = 0; i < NUM_CHANNELS; i++) {
+            measurements[i] = valve_get_position(&bank_valve[i]);
+        }
+        pid_bank_compute(&bank, measurements, outputs, NUM_CHANNELS);
+
+        for (int i = 0; i < NUM_CHANNELS; i++) {
+            float expected = pid_compute(&scalar[i], valve_get_position(&scalar_valve[i]));
+            float diff = fabsf(expected - outputs[i]);
+            if (diff > max_diff) max_diff = diff;
+            if (expected != outputs[i]) exact = 0;
+
+            // Close both loops with the same valve model
+            float cmd = expected;
+            if (cmd < 0.0f) cmd = 0.0f;
+            if (cmd > 100.0f) cmd = 100.0f;
+            valve_update(&scalar_valve[i], cmd, 0.01f);
+
+            cmd = outputs[i];
+            if (cmd < 0.0f) cmd = 0.0f;
+            if (cmd > 100.0f) cmd = 100.0f;
+            valve_update(&bank_valve[i], cmd, 0.01f);
+        }
+    }
+
+    // Final state must also agree
+    float max_state_diff = 0.0f;
+    for (int i = 0; i < NUM_CHANNELS; i++) {
+        PIDController restored;
+        pid_bank_store(&bank, i, &restored);
+        float d = fabsf(restored.integral - scalar[i].integral);
+        if (d > max_state_diff) max_state_diff = d;
+        d = fabsf(restored.setpoint - scalar[i].setpoint);
+        if (d > max_state_diff) max_state_diff = d;
+    }
+
+    pid_bank_free(&bank);
+
+    printf("Max output difference: %g\n", max_diff);
+    printf("Max state difference:  %g\n", max_state_diff);
+    printf("Bit-for-bit identical: %s\n", exact ? "yes" : "no");
+
+    if (max_diff > TOLERANCE || max_state_diff > TOLERANCE) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
@@ -0,0 +1,147 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <sched.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "pid_controller.h"
+#include "pid_params.h"
+#include "test_check.h"
+
+#define WRITER_PUBLISHES 200000
+#define READER_TICKS     2000000
+
+// Every published set is a function of one counter, so a torn set shows up
+static void make_params(uint32_t n, PidParams* params) {
+    params->kp = (float)n;
+    params->ki = 2.0f * n + 1.0f;
+    params->kd = 3.0f * n;
+    params->derivative_filter_coeff = 0.5f;
+    params->max_rate_of_change = 4.0f * n;
+    params->setpoint_ramp_rate = 5.0f * n;
+}
+
+static int consistent(const PIDController* pid) {
+    float n = pid->kp;
+    return pid->ki == 2.0f * n + 1.0f && pid->kd == 3.0f * n &&
+           pid->max_rate_of_change == 4.0f * n && pid->setpoint_ramp_rate == 5.0f * n;
+}
+
+typedef struct {
+    PidParamsExchange* exchange;
+    atomic_int done;
+} WriterContext;
+
+static void* writer_thread(void* arg) {
+    WriterContext* w = (WriterContext*)arg;
+    PidParams params;
+    for (uint32_t n = 1; n <= WRITER_PUBLISHES; n++) {
+        make_params(n, &params);
+        pid_params_publish(w->exchange, &params);
+        sched_yield(); // Interleave with the reader even on one core
+    }
+    atomic_store(&w->done, 1);
+    return NULL;
+}
+
+int main() {
+    PIDController pid;
+    PidParamsExchange exchange;
+    PidParams params;
+
+    printf("Testing Parameter Hot-Swap\n\n");
+    printf("Check                                  Measured    Expected\n");
+    printf("-------------------------------------  ----------  ----------\n");
+
+    // 1) Nothing published: polls are no-ops
+    pid_init(&pid, 5.0f, 4.0f, 0.1f, 0.01f);
+    pid_set_setpoint(&pid, 60.0f);
+    pid_params_exchange_init(&exchange, &pid);
+    check("Poll with nothing published", pid_params_poll(&exchange, &pid), 0, 0);
+
+    // 2) A new ki is bumpless: the integral term ki * integral is kept
+    for (int i = 0; i < 200; i++) pid_compute(&pid, 59.0f);
+    float integral_term = pid.ki * pid.integral;
+    pid_params_get(&pid, &params);
+    params.ki = 8.0f;
+    params.max_rate_of_change = 50.0f;
+    pid_params_publish(&exchange, &params);
+    check("Poll picks up the new set", pid_params_poll(&exchange, &pid), 1, 0);
+    check("Second poll is a no-op", pid_params_poll(&exchange, &pid), 0, 0);
+    check("ki applied", pid.ki, 8.0, 0);
+    check("Integral term unchanged", pid.ki * pid.integral, integral_term, 1e-4);
+    check("Anti-windup limit follows ki", pid.integral_max, pid.output_max / 8.0f, 1e-6);
+    check("Rate limit coefficient rebuilt", pid.rate_step, 50.0f * 0.01f, 1e-6);
+
+    // At zero error nothing integrates, so the output must match the old gains exactly
+    PIDController same = pid;
+    pid_params_get(&pid, &params);
+    params.ki = 2.0f;
+    pid_params_publish(&exchange, &params);
+    float before = pid_compute(&same, 60.0f);
+    pid_params_poll(&exchange, &pid);
+    float after = pid_compute(&pid, 60.0f);
+    check("No output bump on ki change", after, before, 1e-3);
+
+    // 3) ki = 0 holds the integral at zero
+    params.ki = 0.0f;
+    pid_params_publish(&exchange, &params);
+    pid_params_poll(&exchange, &pid);
+    check("ki = 0 clears the integral", pid.integral, 0.0, 0);
+
+    // A slot the writer is still filling is left for the next tick
+    params.kp = 7.0f;
+    pid_params_publish(&exchange, &params);
+    PidParamsSlot* slot = &exchange.slots[atomic_load(&exchange.version) & 1];
+    atomic_fetch_add(&slot->sequence, 1);
+    check("Busy slot skipped", pid_params_poll(&exchange, &pid), 0, 0);
+    check("Torn copy counted", exchange.torn, 1, 0);
+    atomic_fetch_add(&slot->sequence, 1);
+    check("Taken on the next tick", pid_params_poll(&exchange, &pid), 1, 0);
+    check("kp applied", pid.kp, 7.0, 0);
+
+    // Out-of-range values are clamped like the setters clamp them
+    params.derivative_filter_coeff = 1.5f;
+    params.max_rate_of_change = -10.0f;
+    params.setpoint_ramp_rate = NAN;
+    pid_params_publish(&exchange, &params);
+    pid_params_poll(&exchange, &pid);
+    check("Filter clamped to 1", pid.derivative_filter_coeff, 1.0, 0);
+    check("Filter keep not negative", pid.derivative_keep, 0.0, 0);
+    check("Negative rate limit disables it", pid.rate_step, 0.0, 0);
+    check("NaN ramp rate disables ramping", pid.setpoint_ramp_rate, 0.0, 0);
+    check("Output stays finite", isfinite(pid_compute(&pid, 50.0f)), 1, 0);
+
+    // 4) Concurrent publishes never reach the controller half-written
+    pid_init(&pid, 5.0f, 4.0f, 0.1f, 0.01f);
+    make_params(0, &params);
+    pid_params_apply(&pid, &params);
+    pid_params_exchange_init(&exchange, &pid);
+
+    WriterContext writer = { &exchange, 0 };
+    pthread_t thread;
+    pthread_create(&thread, NULL, writer_thread, &writer);
+    long torn_sets = 0;
+    long ticks = 0;
+    while (ticks < READER_TICKS || !atomic_load(&writer.done)) {
+        if (pid_params_poll(&exchange, &pid) && !consistent(&pid)) torn_sets++;
+        pid_compute(&pid, 50.0f);
+        if (++ticks % 64 == 0) sched_yield();
+    }
+    pthread_join(thread, NULL);
+    pid_params_poll(&exchange, &pid);
+
+    check("Inconsistent parameter sets", torn_sets, 0, 0);
+    check("Sets applied while running", exchange.applied > 0, 1, 0);
+    check("Last publish applied", pid.kp, WRITER_PUBLISHES, 0);
+    printf("(%llu sets applied, %llu torn copies retried)\n",
+           (unsigned long long)exchange.applied, (unsigned long long)exchange.torn);
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
@@ -0,0 +1,159 @@
+// Build with -DPID_INSTRUMENTATION (see GETTING_STARTED.md)
+#include <stdio.h>
+#include <math.h>
+#include <pthread.h>
+#include "pid_controller.h"
+#include "pid_bank.h"
+#include "test_check.h"
+
+#ifndef PID_INSTRUMENTATION
+#error "test_pid_stats needs -DPID_INSTRUMENTATION"
+#endif
+
+#define WRITER_TICKS 2000000
+
+static uint64_t hist_total(const uint64_t* hist) {
+    uint64_t total = 0;
+    for (int b = 0; b < PID_STAT_BUCKETS; b++) total += hist[b];
+    return total;
+}
+
+// Control thread for the concurrent snapshot check
+static void* writer(void* arg) {
+    PIDController* pid = (PIDController*)arg;
+    float measurement = 0.0f;
+    for (int k = 0; k < WRITER_TICKS; k++) {
+        float output = pid_compute(pid, measurement);
+        measurement += 0.001f * (output - measurement);
+    }
+    return NULL;
+}
+
+int main() {
+    PIDController pid;
+    PidStatsSnapshot snap, fleet = {0};
+
+    printf("Testing PID Instrumentation\n\n");
+    printf("Check                                  Measured    Expected\n");
+    printf("-------------------------------------  ----------  ----------\n");
+
+    // 1) Histogram buckets come from the float exponent
+    check("Bucket of 0", pid_stat_bucket(0.0f), 0, 0);
+    check("Bucket floor of 1.0", pid_stats_bucket_floor(pid_stat_bucket(1.0f)), 1.0, 0.0);
+    check("Bucket floor of -3.0", pid_stats_bucket_floor(pid_stat_bucket(-3.0f)), 2.0, 0.0);
+    check("Bucket of 1e9 is the last", pid_stat_bucket(1e9f), PID_STAT_BUCKETS - 1, 0);
+
+    // 2) Setpoint ramp 0 -> 5% at 10%/s: 0.1% per tick for about 50 ticks
+    pid_init(&pid, 1.0f, 0.0f, 0.0f, 0.01f);
+    pid_set_ramp_rate(&pid, 10.0f);
+    pid_set_setpoint_ramped(&pid, 5.0f);
+    for (int k = 0; k < 100; k++) pid_compute(&pid, pid.setpoint);
+    pid_stats_snapshot(&pid.stats, &snap);
+    check("Ramp ticks", snap.ramp_ticks, 49, 1);
+    check("Ticks", snap.ticks, 100, 0);
+    check("|error| samples = ticks", hist_total(snap.error_hist), 100, 0);
+    pid_stats_accumulate(&fleet, &snap);
+
+    // 3) Integral alone at a constant 100% error: grows 1 per tick up to
+    //    output_max / ki = 100, then is clamped every tick
+    pid_init(&pid, 0.0f, 1.0f, 0.0f, 0.01f);
+    pid_set_setpoint(&pid, 100.0f);
+    for (int k = 0; k < 200; k++) pid_compute(&pid, 0.0f);
+    pid_stats_snapshot(&pid.stats, &snap);
+    check("Integral clamp hits", snap.integral_clamps, 100, 1);
+    check("No output saturation", snap.output_saturations, 0, 0);
+    check("|error| p50 bucket (%)", pid_stats_quantile(snap.error_hist, 0.5), 64.0, 0.0);
+    pid_stats_accumulate(&fleet, &snap);
+
+    // 4) Rate limit of 100%/s on a 50% step: about 49 limited ticks
+    pid_init(&pid, 1.0f, 0.0f, 0.0f, 0.01f);
+    pid_set_derivative_filter(&pid, 1.0f);
+    pid_set_rate_limit(&pid, 100.0f);
+    pid_set_setpoint(&pid, 50.0f);
+    for (int k = 0; k < 100; k++) pid_compute(&pid, 0.0f);
+    pid_stats_snapshot(&pid.stats, &snap);
+    check("Rate limit activations", snap.rate_limits, 49, 1);
+    check("|output change| p90 bucket (%)", pid_stats_quantile(snap.delta_hist, 0.9), 1.0, 0.0);
+    pid_stats_accumulate(&fleet, &snap);
+
+    // 5) kp = 5 on a 50% error asks for 250%: saturated every tick
+    pid_init(&pid, 5.0f, 0.0f, 0.0f, 0.01f);
+    pid_set_setpoint(&pid, 50.0f);
+    for (int k = 0; k < 100; k++) pid_compute(&pid, 0.0f);
+    pid_stats_snapshot(&pid.stats, &snap);
+    check("Output saturated ticks", snap.output_saturations, 100, 0);
+    pid_stats_accumulate(&fleet, &snap);
+    check("Fleet total ticks", fleet.ticks, 500, 0);
+
+    // 6) pid_init() starts the counters over
+    pid_init(&pid, 5.0f, 0.0f, 0.0f, 0.01f);
+    pid_stats_snapshot(&pid.stats, &snap);
+    check("Counters reset by pid_init", snap.ticks + snap.output_saturations, 0, 0);
+
+    // 7) Snapshots taken while another thread runs the controller
+    pthread_t thread;
+    int snapshots = 0, went_back = 0;
+    uint64_t previous = 0;
+    pid_init(&pid, 2.0f, 1.0f, 0.05f, 0.001f);
+    pid_set_setpoint(&pid, 60.0f);
+    pthread_create(&thread, NULL, writer, &pid);
+    do {
+        pid_stats_snapshot(&pid.stats, &snap);
+        if (snap.ticks < previous) went_back++;
+        previous = snap.ticks;
+        snapshots++;
+    } while (snap.ticks < WRITER_TICKS);
+    pthread_join(thread, NULL);
+    pid_stats_snapshot(&pid.stats, &snap);
+    printf("(%d snapshots while running)\n", snapshots);
+    check("Tick count never went backwards", went_back, 0, 0);
+    check("Final ticks", snap.ticks, WRITER_TICKS, 0);
+    check("Final |error| samples", hist_total(snap.error_hist), WRITER_TICKS, 0);
+    check("Final |output change| samples", hist_total(snap.delta_hist), WRITER_TICKS, 0);
+
+    // 8) The bank kernel counts the same events as pid_compute() per channel
+    PIDController scalar[4];
+    PIDBank bank;
+    float inputs[4] = {0}, outputs[4];
+    pid_init(&scalar[0], 1.0f, 0.0f, 0.0f, 0.01f);
+    pid_set_ramp_rate(&scalar[0], 10.0f);
+    pid_set_setpoint_ramped(&scalar[0], 5.0f);
+    pid_init(&scalar[1], 0.0f, 1.0f, 0.0f, 0.01f);
+    pid_set_setpoint(&scalar[1], 100.0f);
+    pid_init(&scalar[2], 1.0f, 0.0f, 0.0f, 0.01f);
+    pid_set_derivative_filter(&scalar[2], 1.0f);
+    pid_set_rate_limit(&scalar[2], 100.0f);
+    pid_set_setpoint(&scalar[2], 50.0f);
+    pid_init(&scalar[3], 5.0f, 0.0f, 0.0f, 0.01f);
+    pid_set_setpoint(&scalar[3], -50.0f);
+    pid_bank_init(&bank, 4);
+    for (int c = 0; c < 4; c++) pid_bank_load(&bank, c, &scalar[c]);
+    for (int k = 0; k < 200; k++) {
+        for (int c = 0; c < 4; c++) pid_compute(&scalar[c], inputs[c]);
+        pid_bank_compute(&bank, inputs, outputs, 4);
+    }
+    int mismatches = 0;
+    for (int c = 0; c < 4; c++) {
+        PidStatsSnapshot bank_snap;
+        pid_stats_snapshot(&scalar[c].stats, &snap);
+        pid_bank_stats(&bank, c, &bank_snap);
+        if (bank_snap.ticks != snap.ticks || bank_snap.ramp_ticks != snap.ramp_ticks ||
+            bank_snap.integral_clamps != snap.integral_clamps ||
+            bank_snap.rate_limits != snap.rate_limits ||
+            bank_snap.output_saturations != snap.output_saturations) mismatches++;
+    }
+    check("Bank channels matching pid_compute", 4 - mismatches, 4, 0);
+    pid_bank_stats(&bank, 3, &snap);
+    check("Bank low-side saturations", snap.output_saturations, 200, 0);
+    pid_bank_load(&bank, 3, &scalar[3]);
+    pid_bank_stats(&bank, 3, &snap);
+    check("Counters reset by pid_bank_load", snap.ticks, 0, 0);
+    pid_bank_free(&bank);
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <stdio.h>
+#include <math.h>
+#include "valve_simulator.h"
+#include "plant_bank.h"
+#include "rng.h"
+#include "test_check.h"
+
+#define CHANNELS 64
+#define DT       0.001f
+
+// Run one channel for steps with a constant command, return its position
+static float hold(PlantBank* bank, float command, int steps) {
+    for (int k = 0; k < steps; k++) plant_bank_update(bank, &command, 1);
+    return bank->position[0];
+}
+
+// Worst deviation of a 0 -> 50% step from the analytic second-order response
+static double second_order_error(float wn, float zeta) {
+    PlantBank bank;
+    PlantParams params;
+    plant_bank_init(&bank, 1, DT);
+    plant_params_default(&params);
+    params.model = PLANT_SECOND_ORDER;
+    params.natural_frequency = wn;
+    params.damping = zeta;
+    plant_bank_configure(&bank, 0, &params);
+
+    double worst = 0.0;
+    float command = 50.0f;
+    for (int k = 1; k <= 500; k++) {
+        plant_bank_update(&bank, &command, 1);
+        double t = k * (double)DT, x;
+        if (zeta < 1.0f) {
+            double wd = wn * sqrt(1.0 - zeta * zeta);
+            x = 1.0 - exp(-zeta * wn * t) * (cos(wd * t) + zeta / sqrt(1.0 - zeta * zeta) * sin(wd * t));
+        } else if (zeta == 1.0f) {
+            x = 1.0 - exp(-wn * t) * (1.0 + wn * t);
+        } else {
+            double r = wn * sqrt(zeta * zeta - 1.0);
+            double s1 = -zeta * wn + r, s2 = -zeta * wn - r;
+            x = 1.0 + (s2 * exp(s1 * t) - s1 * exp(s2 * t)) / (s1 - s2);
+        }
+        double error = fabs(bank.position[0] - 50.0 * x);
+        if (error > worst) worst = error;
+    }
+    plant_bank_free(&bank);
+    return worst;
+}
+
+int main() {
+    PlantBank bank;
+    PlantParams params;
+    ValveSimulator valves[CHANNELS];
+    float commands[CHANNELS];
+    Rng rng;
+
+    printf("Testing Plant Bank\n\n");
+    printf("Check                                  Measured    Expected\n");
+    printf("-------------------------------------  ----------  ----------\n");
+
+    // 1) First-order channels step exactly like valve_update(), including
+    //    deadband, disturbance and saturation at 0/100%
+    rng_seed(&rng, 18, 0);
+    plant_bank_init(&bank, CHANNELS, DT);
+    for (int i = 0; i < CHANNELS; i++) {
+        valve_init(&valves[i], 0.05f + 0.5f * rng_uniform(&rng), (i % 3) * 0.5f);
+        valves[i].disturbance = 4.0f * rng_uniform(&rng) - 2.0f;
+        valves[i].position = 100.0f * rng_uniform(&rng);
+        plant_bank_load_valve(&bank, i, &valves[i]);
+    }
+    float worst = 0.0f;
+    for (int k = 0; k < 3000; k++) {
+        for (int i = 0; i < CHANNELS; i++) {
+            commands[i] = ((k / 500 + i) % 4 == 0) ? 110.0f : 120.0f * rng_uniform(&rng) - 10.0f;
+            valve_update(&valves[i], commands[i], DT);
+        }
+        plant_bank_update(&bank, commands, CHANNELS);
+        for (int i = 0; i < CHANNELS; i++) {
+            float diff = fabsf(bank.position[i] - valves[i].position);
+            if (diff > worst) worst = diff;
+        }
+    }
+    check("Worst difference from valve_update", worst, 0.0, 0.0);
+    plant_bank_free(&bank);
+
+    // 2) Second-order spool: exact discretization of the analytic response
+    check("Underdamped (zeta 0.3) error (%)", second_order_error(60.0f, 0.3f), 0.0, 1e-3);
+    check("Critically damped error (%)", second_order_error(60.0f, 1.0f), 0.0, 1e-3);
+    check("Overdamped (zeta 2) error (%)", second_order_error(60.0f, 2.0f), 0.0, 1e-3);
+
+    // 3) Deadband: a gap inside the band does not move the valve
+    plant_bank_init(&bank, 1, DT);
+    plant_params_default(&params);
+    params.time_constant = 0.01f;
+    params.deadband = 1.0f;
+    plant_bank_configure(&bank, 0, &params);
+    bank.position[0] = 50.0f;
+    check("Deadband: 0.8% gap ignored", hold(&bank, 50.8f, 200), 50.0, 0.0);
+    check("Deadband: stops within 1% of 60%", hold(&bank, 60.0f, 500), 59.5, 0.5);
+
+    // 4) Backlash of 4%: the valve lags 2% behind the command and does not
+    //    reverse until the command comes back across the play
+    params.deadband = 0.0f;
+    params.backlash = 4.0f;
+    plant_bank_configure(&bank, 0, &params);
+    bank.position[0] = 0.0f;
+    bank.backlash_out[0] = 0.0f;
+    check("Backlash: rising to 60% stops at", hold(&bank, 60.0f, 500), 58.0, 0.01);
+    check("Backlash: 57% is inside the play", hold(&bank, 57.0f, 500), 58.0, 0.01);
+    check("Backlash: falling to 50% stops at", hold(&bank, 50.0f, 500), 52.0, 0.01);
+
+    // 5) Flow saturation: a full-scale step moves at the 10 %/s limit
+    params.backlash = 0.0f;
+    params.max_rate = 10.0f;
+    plant_bank_configure(&bank, 0, &params);
+    bank.position[0] = 0.0f;
+    check("Flow limit: position after 1 s", hold(&bank, 100.0f, 1000), 10.0, 0.01);
+    check("Flow limit: velocity (%/s)", bank.velocity[0], 10.0, 0.01);
+
+    // 6) Load: a spring load costs a share of the command, an external
+    //    load adds its offset
+    params.max_rate = 0.0f;
+    params.load_stiffness = 0.25f;
+    params.load_gain = 2.0f;
+    plant_bank_configure(&bank, 0, &params);
+    check("Spring load: 50% command settles at", hold(&bank, 50.0f, 2000), 40.0, 0.01);
+    bank.load[0] = 5.0f;
+    check("External load +10%: settles at", hold(&bank, 50.0f, 2000), 48.0, 0.01);
+
+    // 7) Invalid parameters are rejected
+    params.time_constant = 0.0f;
+    check("Zero time constant rejected", plant_bank_configure(&bank, 0, &params), -1, 0);
+    plant_params_default(&params);
+    params.model = PLANT_SECOND_ORDER;
+    check("Missing natural frequency rejected", plant_bank_configure(&bank, 0, &params), -1, 0);
+    plant_bank_free(&bank);
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
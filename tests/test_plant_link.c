@@ -0,0 +1,143 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "pid_controller.h"
+#include "valve_simulator.h"
+#include "plant_link.h"
+#include "test_check.h"
+
+#define SAMPLE_TIME 0.01f
+#define STEPS       1500
+
+static char link_name[64];
+
+static void sleep_ms(long ms) {
+    struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+
+// Fork a plant server process and attach to its channel 0
+static pid_t start_server(PlantClient* client, uint64_t delay_ns, uint32_t drop_every,
+                          uint64_t wait_ns) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        PlantServer server;
+        if (plant_server_open(&server, link_name, 1, 0.2f, 0.0f) != 0) _exit(2);
+        server.delay_ns = delay_ns;
+        server.drop_every = drop_every;
+        plant_server_run(&server);
+        plant_server_close(&server);
+        _exit(0);
+    }
+    for (int i = 0; i < 2000; i++) {
+        if (plant_client_open(client, link_name, 0, wait_ns) == 0) return pid;
+        sleep_ms(1);
+    }
+    return -1;
+}
+
+static void stop_server(PlantClient* client, pid_t pid) {
+    plant_client_stop_server(client);
+    plant_client_close(client);
+    waitpid(pid, NULL, 0);
+}
+
+// main.c's loop against either plant; the command comes from the position read
+static float run_loop(ValveSimulator* valve, PlantClient* client, int steps, float* trace) {
+    PIDController pid;
+    pid_init(&pid, 5.0f, 4.0f, 0.1f, SAMPLE_TIME);
+    pid_set_setpoint(&pid, 50.0f);
+    float position = 0.0f;
+    for (int k = 0; k < steps; k++) {
+        if (k == 500) pid_set_setpoint(&pid, 75.0f);
+        position = client ? plant_client_get_position(client) : valve_get_position(valve);
+        trace[k] = position;
+        float command = pid_compute(&pid, position);
+        if (command < 0.0f) command = 0.0f;
+        if (command > 100.0f) command = 100.0f;
+        if (client) plant_client_update(client, command, SAMPLE_TIME);
+        else valve_update(valve, command, SAMPLE_TIME);
+    }
+    return position;
+}
+
+int main() {
+    PlantClient client;
+    ValveSimulator valve;
+    static float local_trace[STEPS], remote_trace[STEPS];
+    pid_t pid;
+
+    snprintf(link_name, sizeof(link_name), "/hv_plant_test_%d", (int)getpid());
+
+    printf("Testing Shared-Memory Plant Link\n\n");
+    printf("Check                                  Measured    Expected\n");
+    printf("-------------------------------------  ----------  ----------\n");
+
+    // 1) Lock-step: the remote valve reproduces the in-process loop exactly
+    pid = start_server(&client, 0, 0, PLANT_LINK_WAIT_FOREVER);
+    check("Server started", pid > 0, 1, 0);
+    if (pid <= 0) return 1;
+    valve_init(&valve, 0.2f, 0.0f);
+    run_loop(&valve, NULL, STEPS, local_trace);
+    run_loop(NULL, &client, STEPS, remote_trace);
+    plant_client_get_position(&client); // Collect the reply to the last command
+    float worst = 0.0f;
+    for (int k = 0; k < STEPS; k++) {
+        float diff = fabsf(local_trace[k] - remote_trace[k]);
+        if (diff > worst) worst = diff;
+    }
+    check("Worst position difference (%)", worst, 0.0, 0.0);
+    check("Missed samples", (double)client.missed, 0, 0);
+    check("Round trips measured", (double)client.round_trip.count, STEPS, 0);
+    check("Server applied", (double)atomic_load(&client.shared->applied), STEPS, 0);
+    printf("Round trip: min %llu ns, mean %llu ns\n",
+           (unsigned long long)client.round_trip.min_ns,
+           (unsigned long long)(client.round_trip.sum_ns / client.round_trip.count));
+    stop_server(&client, pid);
+
+    // 2) Lost replies: each one is a missed sample, the last position is held
+    //    and the next reply resynchronizes
+    pid = start_server(&client, 0, 20, 20000000ull);
+    run_loop(NULL, &client, 200, remote_trace);
+    check("Missed with every 20th reply lost", (double)client.missed, 9, 0);
+    check("...held the last position", (double)client.stale, 9, 0);
+    check("Held value equals previous sample", remote_trace[20], remote_trace[19], 0.0);
+    check("Server dropped", (double)atomic_load(&client.shared->dropped), 9.5, 0.5);
+    stop_server(&client, pid);
+
+    // 3) Injected latency: a reply is never seen before the delay has passed
+    pid = start_server(&client, 20000000ull, 0, 0);
+    float before = plant_client_get_position(&client);
+    plant_client_update(&client, 100.0f, SAMPLE_TIME);
+    float early = plant_client_get_position(&client);
+    check("Read before delay is missed", (double)client.missed, 1, 0);
+    check("...and holds the old position", early, before, 0.0);
+    sleep_ms(60);
+    float late = plant_client_get_position(&client);
+    check("Reply arrives after the delay", late > before, 1, 0);
+    check("Round trip >= injected 20 ms", client.round_trip.min_ns >= 20000000ull, 1, 0);
+
+    // 4) Sequence numbers: a burst longer than the ring laps the server; the
+    //    overwritten commands are counted, the newest reply is still matched
+    for (int i = 0; i < 100; i++) plant_client_update(&client, 50.0f, SAMPLE_TIME);
+    sleep_ms(60);
+    client.wait_ns = 100000000ull;
+    plant_client_get_position(&client);
+    check("Newest reply matched", (double)client.received, 101, 0);
+    check("Server overruns", (double)atomic_load(&client.shared->overruns),
+          100 - (double)(atomic_load(&client.shared->applied) - 1), 0);
+    check("...only the commands overwritten", (double)atomic_load(&client.shared->overruns),
+          100 - PLANT_LINK_RING, 0);
+    stop_server(&client, pid);
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include <math.h>
+#include "pid_controller.h"
+#include "valve_simulator.h"
+#include "plant.h"
+#include "relay_autotune.h"
+#include "step_metrics.h"
+#include "test_check.h"
+
+#define SAMPLE_TIME 0.01f
+#define MAX_DELAY   256
+
+// First-order plus dead time plant: gain * exp(-delay s) / (tau s + 1)
+// Exposed through the plant interface to show the tuner needs nothing else
+typedef struct {
+    float gain;
+    float tau;
+    int delay_steps;
+    float output;
+    float pending[MAX_DELAY]; // Commands still in the dead time
+    int head;
+} DeadTimePlant;
+
+static void dead_time_update(void* state, float command, float dt) {
+    DeadTimePlant* p = (DeadTimePlant*)state;
+    float delayed = p->pending[p->head];
+    p->pending[p->head] = command;
+    p->head = (p->head + 1) % p->delay_steps;
+    p->output += (p->gain * delayed - p->output) * (1.0f - expf(-dt / p->tau));
+}
+
+static float dead_time_get_position(void* state) {
+    return ((DeadTimePlant*)state)->output;
+}
+
+static void dead_time_init(DeadTimePlant* p, PlantInterface* plant, float gain, float tau,
+                           float delay, float initial_command) {
+    p->gain = gain;
+    p->tau = tau;
+    p->delay_steps = (int)(delay / SAMPLE_TIME + 0.5f);
+    p->output = gain * initial_command;
+    for (int i = 0; i < MAX_DELAY; i++) p->pending[i] = initial_command;
+    p->head = 0;
+    plant->state = p;
+    plant->update = dead_time_update;
+    plant->get_position = dead_time_get_position;
+}
+
+// Analytic ultimate frequency: phase atan(w tau) + w L reaches pi
+static void ultimate_point(float gain, float tau, float delay, float* ku, float* pu) {
+    double lo = 0.0, hi = 3.14159265 / delay;
+    for (int i = 0; i < 60; i++) {
+        double w = 0.5 * (lo + hi);
+        if (atan(w * tau) + w * delay < 3.14159265) lo = w;
+        else hi = w;
+    }
+    *ku = (float)(sqrt(1.0 + lo * lo * tau * tau) / gain);
+    *pu = (float)(2.0 * 3.14159265 / lo);
+}
+
+int main() {
+    PlantInterface plant;
+    DeadTimePlant dead_time;
+    RelayAutotune tune;
+    PIDController pid;
+    float ku, pu;
+
+    printf("Testing Relay-Feedback Auto-Tuner\n\n");
+    printf("Check                                  Measured    Expected\n");
+    printf("-------------------------------------  ----------  ----------\n");
+
+    // 1) Dead-time plant: Ku and Pu match the analytic ultimate point to a few
+    //    percent (the describing-function approximation error)
+    dead_time_init(&dead_time, &plant, 1.0f, 1.0f, 0.5f, 40.0f);
+    relay_autotune_init(&tune, 40.0f, 40.0f, 5.0f, 0.0f, SAMPLE_TIME);
+    ultimate_point(1.0f, 1.0f, 0.5f, &ku, &pu);
+    check("Experiment finished", (float)relay_autotune_run(&tune, &plant, 120.0f), 0.0f, 0.0f);
+    check("Ultimate gain Ku", tune.ultimate_gain, ku, 0.05f * ku);
+    check("Ultimate period Pu (s)", tune.ultimate_period, pu, 0.05f * pu);
+
+    // 2) Unknown static gain and a wrong bias guess: the bias converges on
+    //    the command that holds the setpoint (40 / 2), Ku scales with 1/gain
+    dead_time_init(&dead_time, &plant, 2.0f, 1.0f, 0.5f, 10.0f);
+    relay_autotune_init(&tune, 40.0f, 25.0f, 15.0f, 0.0f, SAMPLE_TIME);
+    tune.settle_cycles = 6;
+    relay_autotune_run(&tune, &plant, 120.0f);
+    ultimate_point(2.0f, 1.0f, 0.5f, &ku, &pu);
+    check("Adapted bias (%)", tune.bias, 20.0f, 1.0f);
+    check("Ku with plant gain 2", tune.ultimate_gain, ku, 0.05f * ku);
+
+    // 3) Bumpless switchover: at the relay's last measurement the controller
+    //    reproduces the relay's last command, for every rule
+    float worst_bump = 0.0f;
+    for (int r = 0; r < TUNE_RULE_COUNT; r++) {
+        pid_init(&pid, 5.0f, 4.0f, 0.1f, SAMPLE_TIME);
+        relay_autotune_apply(&tune, (TuningRule)r, &pid);
+        float bump = fabsf(pid_compute(&pid, tune.last_measurement) - tune.command);
+        if (bump > worst_bump) worst_bump = bump;
+    }
+    check("Worst switchover bump (%)", worst_bump, 0.0f, 0.01f);
+
+    // Gains follow the rule definitions
+    float kp, ki, kd;
+    relay_autotune_gains(&tune, TUNE_ZIEGLER_NICHOLS, &kp, &ki, &kd);
+    check("ZN Kp / Ku", kp / tune.ultimate_gain, 0.6f, 1e-5f);
+    check("ZN Ti / Pu", kp / ki / tune.ultimate_period, 0.5f, 1e-5f);
+    check("ZN Td / Pu", kd / kp / tune.ultimate_period, 0.125f, 1e-5f);
+
+    // 4) The simulated valve: tune, switch over, and take main.c's step
+    ValveSimulator valve;
+    StepMetrics metrics;
+    valve_init(&valve, 0.2f, 0.0f);
+    plant_from_valve(&plant, &valve);
+    relay_autotune_init(&tune, 50.0f, 50.0f, 10.0f, 1.0f, SAMPLE_TIME);
+    check("Valve experiment finished", (float)relay_autotune_run(&tune, &plant, 60.0f), 0.0f, 0.0f);
+
+    pid_init(&pid, 5.0f, 4.0f, 0.1f, SAMPLE_TIME);
+    relay_autotune_apply(&tune, TUNE_TYREUS_LUYBEN, &pid);
+    step_metrics_init(&metrics, 0.01f, 0.95f, 0.0f, 100.0f);
+    for (int k = 0; k < 1500; k++) {
+        if (k == 500) pid_set_setpoint(&pid, 75.0f);
+        float measurement = valve.position;
+        float command = pid_compute(&pid, measurement);
+        if (command < 0.0f) command = 0.0f;
+        if (command > 100.0f) command = 100.0f;
+        step_metrics_update(&metrics, &pid, measurement, command);
+        valve_update(&valve, command, SAMPLE_TIME);
+    }
+    printf("Valve: Ku %.3f, Pu %.3f s; TL step settles in %.2f s, overshoot %.1f%%\n",
+           tune.ultimate_gain, tune.ultimate_period, metrics.settling_time, metrics.overshoot);
+    check("Tuned valve settled (+/-1%)", metrics.settling_time >= 0.0f, 1.0f, 0.0f);
+    check("Tuned valve final error (%)", metrics.final_error, 0.0f, 0.1f);
+
+    // 5) A relay too weak to reach the setpoint times out instead of hanging
+    valve_init(&valve, 0.2f, 0.0f);
+    relay_autotune_init(&tune, 80.0f, 40.0f, 5.0f, 1.0f, SAMPLE_TIME);
+    check("Unreachable setpoint times out", (float)relay_autotune_run(&tune, &plant, 5.0f), -1.0f, 0.0f);
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
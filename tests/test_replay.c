@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "pid_controller.h"
+#include "plant_bank.h"
+#include "column_log.h"
+#include "replay_engine.h"
+#include "test_check.h"
+
+#define CSV_PATH        "test_replay.csv"
+#define LOG_PATH        "test_replay.hvcl"
+#define BAD_PATH        "test_replay_bad.csv"
+#define CANDIDATES_PATH "test_replay_candidates.txt"
+#define SAMPLE_DT       0.01f
+#define LOG_ROWS        3000
+
+static double command_rms(const ReplayScore* score) {
+    return score->samples > 0 ? sqrt(score->command_sq / score->samples) : -1.0;
+}
+
+// Record a closed loop the way main.c logs it: the valve starts at 0 and the
+// position is written after the valve update
+static int write_log(const PlantParams* plant) {
+    FILE* csv = fopen(CSV_PATH, "w");
+    if (csv == NULL) return -1;
+
+    PIDController pid;
+    PlantBank valve;
+    pid_init(&pid, 5.0f, 4.0f, 0.1f, SAMPLE_DT);
+    if (plant_bank_init(&valve, 1, SAMPLE_DT) != 0 || plant_bank_configure(&valve, 0, plant) != 0) {
+        fclose(csv);
+        return -1;
+    }
+    valve.position[0] = 0.0f;
+    valve.backlash_out[0] = 0.0f;
+
+    fprintf(csv, "Time,Setpoint,Position,Error,Command\n");
+    for (int i = 0; i < LOG_ROWS; i++) {
+        float setpoint = (i < 1000) ? 50.0f : (i < 2000) ? 75.0f : 25.0f;
+        pid_set_setpoint(&pid, setpoint);
+        float command = pid_compute(&pid, valve.position[0]);
+        command = fminf(fmaxf(command, 0.0f), 100.0f);
+        plant_bank_update(&valve, &command, 1);
+        fprintf(csv, "%.2f,%.6f,%.6f,%.6f,%.6f\n", i * SAMPLE_DT, setpoint,
+                valve.position[0], setpoint - valve.position[0], command);
+    }
+    plant_bank_free(&valve);
+    fclose(csv);
+    return 0;
+}
+
+static int write_text(const char* path, const char* text) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL) return -1;
+    fputs(text, file);
+    fclose(file);
+    return 0;
+}
+
+int main() {
+    PlantParams plant;
+    plant_params_default(&plant);
+
+    printf("Testing Replay Engine\n\n");
+    printf("Check                                  Measured    Expected\n");
+    printf("-------------------------------------  ----------  ----------\n");
+
+    check("Log written", write_log(&plant), 0, 0);
+    check("Log imported", column_log_import_csv(CSV_PATH, LOG_PATH), LOG_ROWS, 0);
+
+    // Recorded gains first, then two other tunings
+    write_text(CANDIDATES_PATH,
+               "# name kp ki kd [filter [rate_limit [ramp_rate]]]\n"
+               "recorded  5 4 0.1\n"
+               "\n"
+               "soft      3 2 0.05   # comment\n"
+               "stiff     8 6 0.2 0.1 0 0\n");
+    ReplayCandidate* candidates;
+    int error_line;
+    int count = replay_load_candidates(CANDIDATES_PATH, &candidates, &error_line);
+    check("Candidates loaded", count, 3, 0);
+    if (count != 3) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    check("Candidate filter default", candidates[1].filter, 0.1, 1e-7);
+
+    // 1) CSV and columnar logs load the same trace
+    ReplayTrace csv_trace, log_trace;
+    check("CSV trace loads", replay_trace_load(&csv_trace, CSV_PATH), 0, 0);
+    check("Columnar trace loads", replay_trace_load(&log_trace, LOG_PATH), 0, 0);
+    check("CSV rows", csv_trace.rows, LOG_ROWS, 0);
+    check("Sample time from Time column", csv_trace.sample_time, SAMPLE_DT, 1e-6);
+    check("Columnar command matches CSV", log_trace.command[1500], csv_trace.command[1500], 1e-6);
+
+    // 2) Open loop: the recorded tuning reproduces the recorded commands
+    //    (the default initial position is the valve at rest, as logged)
+    ReplayOptions options;
+    replay_options_default(&options);
+    ReplayScore csv_scores[3], log_scores[3];
+    check("Open-loop replay runs", replay_run(&csv_trace, candidates, count, &options, csv_scores), 0, 0);
+    replay_run(&log_trace, candidates, count, &options, log_scores);
+    check("Recorded tuning command RMS", command_rms(&csv_scores[0]), 0.0, 1e-3);
+    check("Soft tuning diverges", command_rms(&csv_scores[1]) > 1.0, 1, 0);
+    check("Stiff tuning diverges", command_rms(&csv_scores[2]) > 1.0, 1, 0);
+    check("Columnar replay matches CSV", command_rms(&log_scores[2]), command_rms(&csv_scores[2]), 1e-3);
+    check("Samples scored", csv_scores[0].samples, LOG_ROWS, 0);
+    options.initial_position = NAN;
+    replay_run(&csv_trace, candidates, count, &options, log_scores);
+    check("Unknown start leaves row 0 out", log_scores[0].samples, LOG_ROWS - 1, 0);
+    options.initial_position = 0.0f;
+
+    // 3) Plant model: the recorded tuning also reproduces the positions
+    options.plant_model = 1;
+    options.plant = plant;
+    options.warmup = 1.0f;
+    replay_run(&log_trace, candidates, count, &options, log_scores);
+    check("Plant-model command RMS", command_rms(&log_scores[0]), 0.0, 1e-3);
+    check("Plant-model position RMS", sqrt(log_scores[0].position_sq / log_scores[0].samples), 0.0, 1e-3);
+    check("Soft tuning position diverges", log_scores[1].position_sq > log_scores[0].position_sq, 1, 0);
+    check("Warmup rows left out", log_scores[0].samples, LOG_ROWS - 100, 0);
+
+    // 4) Merging scores over files
+    ReplayScore total = { 0 };
+    replay_score_merge(&total, &csv_scores[1]);
+    replay_score_merge(&total, &log_scores[1]);
+    check("Merged samples", total.samples, csv_scores[1].samples + log_scores[1].samples, 0);
+
+    replay_trace_free(&csv_trace);
+    replay_trace_free(&log_trace);
+    free(candidates);
+
+    // 5) Errors report the offending line
+    ReplayTrace bad;
+    write_text(BAD_PATH, "Time,Setpoint,Position,Command\n0.00,50,0,10\n0.01,50,abc,10\n");
+    check("Bad CSV row rejected", replay_trace_load(&bad, BAD_PATH), -1, 0);
+    check("Bad CSV row line", bad.error_line, 3, 0);
+    write_text(BAD_PATH, "Time,Setpoint,Position,Command\n0.00,50,0,\n0.01,50,1,10\n");
+    check("Empty last field rejected", replay_trace_load(&bad, BAD_PATH), -1, 0);
+    check("Empty last field line", bad.error_line, 2, 0);
+    write_text(BAD_PATH, "Time,Setpoint,Position,Command\n0.00,50,,10\n0.01,50,1,10\n");
+    check("Empty middle field rejected", replay_trace_load(&bad, BAD_PATH), -1, 0);
+    write_text(BAD_PATH, "Time,Setpoint,Position,Command\n0.00,50,0,10\n0.01,50,1e");
+    check("Truncated last row rejected", replay_trace_load(&bad, BAD_PATH), -1, 0);
+    check("Truncated last row line", bad.error_line, 3, 0);
+    write_text(BAD_PATH, "Time,Setpoint,Position,Command\n0.00,50,0,1e1\n0.01,5e1,1,10\n");
+    check("Exponent fields parsed", replay_trace_load(&bad, BAD_PATH) == 0 &&
+          bad.command[0] == 10.0f && bad.setpoint[1] == 50.0f, 1, 0);
+    replay_trace_free(&bad);
+    write_text(BAD_PATH, "Time,Setpoint,Command\n0.00,50,10\n0.01,50,10\n");
+    check("Missing Position column rejected", replay_trace_load(&bad, BAD_PATH), -1, 0);
+    write_text(CANDIDATES_PATH, "good 5 4 0.1\nbad 5 four 0.1\n");
+    check("Bad candidate rejected", replay_load_candidates(CANDIDATES_PATH, &candidates, &error_line), -1, 0);
+    check("Bad candidate line", error_line, 2, 0);
+
+    remove(CSV_PATH);
+    remove(LOG_PATH);
+    remove(BAD_PATH);
+    remove(CANDIDATES_PATH);
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
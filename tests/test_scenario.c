@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <string.h>
+#include "pid_controller.h"
+#include "valve_simulator.h"
+#include "scenario.h"
+#include "step_profile.h"
+
+#define SCENARIO_PATH "test_scenario.scn"
+
+static int failed = 0;
+
+static void check(const char* name, int ok) {
+    printf("%-44s %s\n", name, ok ? "OK" : "FAIL");
+    if (!ok) failed = 1;
+}
+
+static void write_file(const char* text) {
+    FILE* f = fopen(SCENARIO_PATH, "w");
+    if (f != NULL) {
+        fputs(text, f);
+        fclose(f);
+    }
+}
+
+// Load text and return the reported error line (-1 if it loaded)
+static int load_error_line(const char* text) {
+    Scenario scenario;
+    write_file(text);
+    if (scenario_load(&scenario, SCENARIO_PATH) == 0) {
+        scenario_free(&scenario);
+        return -1;
+    }
+    return scenario.error_line;
+}
+
+int main() {
+    Scenario scenario;
+
+    printf("Testing Scenario Files and Runner\n\n");
+
+    // 1) Initial configuration, and events compiled into tick order
+    //    (same-tick events keep their file order)
+    write_file("# Comment line\n"
+               "name  two steps  \n"
+               "duration 12\n"
+               "sample_time 0.005\n"
+               "valve 0.3 0\n"
+               "gains 5 4 0.1   # trailing comment\n"
+               "setpoint 40\n"
+               "at 9 setpoint 20\n"
+               "at 3 setpoint 60\n"
+               "at 3 gains 4 2 0.05\n"
+               "\n"
+               "at 0.0149 disturbance 2\n");
+    int loaded = scenario_load(&scenario, SCENARIO_PATH) == 0;
+    check("Scenario loads", loaded);
+    if (!loaded) return 1;
+    check("Name keeps inner spaces", strcmp(scenario.name, "two steps") == 0);
+    check("Initial configuration", scenario.kp == 5.0f && scenario.ki == 4.0f &&
+          scenario.setpoint == 40.0f && scenario.valve_time_constant == 0.3f);
+    check("Duration in ticks", scenario.total_ticks == 2400);
+    check("Events sorted by tick",
+          scenario.num_events == 4 &&
+          scenario.events[0].tick == 3 && scenario.events[0].type == SCENARIO_DISTURBANCE &&
+          scenario.events[1].tick == 600 && scenario.events[1].type == SCENARIO_SETPOINT &&
+          scenario.events[2].tick == 600 && scenario.events[2].type == SCENARIO_GAINS &&
+          scenario.events[3].tick == 1800);
+
+    // The runner applies each event on its tick
+    ScenarioRunner runner;
+    int applied_on_time = 1;
+    scenario_runner_init(&runner, &scenario);
+    while (scenario_runner_step(&runner)) {
+        long tick = runner.tick - 1;
+        int expected = (tick == 3) ? 1 : (tick == 600) ? 2 : (tick == 1800) ? 1 : 0;
+        if (runner.events_applied != expected) applied_on_time = 0;
+        if (tick == 600 && (runner.pid.kp != 4.0f || runner.pid.setpoint != 60.0f)) applied_on_time = 0;
+    }
+    check("Events applied on their tick", applied_on_time);
+    check("Every setpoint step scored", runner.steps == 3 && runner.total_iae > 0.0);
+    scenario_free(&scenario);
+
+    // 2) Errors name the offending line
+    check("Unknown action reported", load_error_line("duration 5\nat 1 valve_open 3\n") == 2);
+    check("Missing argument reported", load_error_line("gains 1 2\n") == 1);
+    check("Extra argument reported", load_error_line("\nsetpoint 50 60\n") == 2);
+    check("Bad number reported", load_error_line("duration 5\nat 1x setpoint 3\n") == 2);
+    check("Initial ramp rejected", load_error_line("ramp 50\n") == 1);
+    check("Event after the end reported", load_error_line("at 20 setpoint 1\nduration 15\n") == 1);
+    check("Unordered gain point reported",
+          load_error_line("schedule position\ngain_point 60 5 4 0.1\ngain_point 40 3 2 0\n") == 3);
+    check("Gain point without integral reported",
+          load_error_line("schedule position\ngain_point 40 3 0 0\n") == 2);
+    check("Unknown schedule input reported", load_error_line("schedule pressure\n") == 1);
+    check("Seed with trailing junk reported", load_error_line("seed 42x\n") == 1);
+    check("Fractional seed reported", load_error_line("seed 4.2\n") == 1);
+    check("Negative seed reported", load_error_line("seed -1\n") == 1);
+    write_file("seed 18446744073709551615\n");
+    check("Full 64-bit seed kept", scenario_load(&scenario, SCENARIO_PATH) == 0 &&
+          scenario.seed == UINT64_MAX);
+    scenario_free(&scenario);
+    remove(SCENARIO_PATH);
+    check("Missing file reported as I/O error",
+          scenario_load(&scenario, SCENARIO_PATH) == -1 && scenario.error_line == 0);
+
+    // 3) The baseline scenario reproduces main.c's original hand-written loop
+    //    exactly, which is the step_profile.h loop the batch tools run
+    PIDController pid;
+    ValveSimulator valve;
+    int identical = scenario_load(&scenario, "scenarios/baseline.scn") == 0;
+    if (identical) {
+        scenario_runner_init(&runner, &scenario);
+        pid_init(&pid, STEP_PROFILE_KP, STEP_PROFILE_KI, STEP_PROFILE_KD, STEP_PROFILE_SAMPLE_TIME);
+        pid_set_setpoint(&pid, STEP_PROFILE_INITIAL_SETPOINT);
+        valve_init(&valve, STEP_PROFILE_VALVE_TAU, 0.0f);
+        for (int tick = 0; tick < STEP_PROFILE_TOTAL_STEPS; tick++) {
+            if (tick == STEP_PROFILE_STEP_TICK) pid_set_setpoint(&pid, STEP_PROFILE_STEP_SETPOINT);
+            float command = pid_compute(&pid, valve.position);
+            if (command < 0.0f) command = 0.0f;
+            if (command > 100.0f) command = 100.0f;
+            valve_update(&valve, command, STEP_PROFILE_SAMPLE_TIME);
+
+            if (!scenario_runner_step(&runner) || runner.command != command ||
+                runner.valve.position != valve.position) identical = 0;
+        }
+        if (scenario_runner_step(&runner)) identical = 0; // Ends on time
+        scenario_free(&scenario);
+    }
+    check("Baseline scenario matches the manual loop", identical);
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
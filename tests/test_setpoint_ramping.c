@@ -3,10 +3,11 @@
 #include <math.h>
 #include "pid_controller.h"
 #include "valve_simulator.h"
+#include "telemetry_log.h"
+#include "scenario.h"
 
 typedef struct {
-    PIDController pid;
-    ValveSimulator valve;
+    ScenarioRunner runner;
     bool running;
     float current_time;
     float position_error;
@@ -16,93 +17,89 @@ typedef struct {
 int main() {
     HydraulicSystem system;
     
-    FILE* log_file = fopen("setpoint_ramping_test.csv", "w");
-    if (log_file == NULL) {
-        printf("Error opening log file!\n");
+    // Gains, features and setpoint profile come from the scenario file
+    Scenario scenario;
+    if (scenario_load(&scenario, "scenarios/setpoint_ramping.scn") != 0) {
+        printf("Error loading scenarios/setpoint_ramping.scn!\n");
         return -1;
     }
-    fprintf(log_file, "Time,Setpoint,Position,Error,Command\n");
-    
-    // Initialize PID
-    pid_init(&system.pid, 5.0f, 4.0f, 0.1f, 0.01f);
-    
-    // Enable advanced features
-    pid_set_derivative_filter(&system.pid, 0.1f);
-    pid_set_rate_limit(&system.pid, 100.0f);
     
-    // NEW: Enable setpoint ramping at 10%/second
-    pid_set_ramp_rate(&system.pid, 10.0f);  // Ramp at 10%/second
-    
-    pid_set_setpoint(&system.pid, 50.0f);
+    // Open binary telemetry log (converted to CSV after the run)
+    TelemetryLog telemetry;
+    if (telemetry_log_open(&telemetry, "setpoint_ramping_test.bin", 4096) != 0) {
+        printf("Error opening log file!\n");
+        scenario_free(&scenario);
+        return -1;
+    }
     
-    // Initialize valve
-    system.valve.position = 0.0f;
-    system.valve.velocity = 0.0f;
-    system.valve.time_constant = 0.2f;
-    system.valve.deadband = 0.0f;
-    system.valve.command = 0.0f;
-    system.valve.disturbance = 0.0f;
+    scenario_runner_init(&system.runner, &scenario);
+    PIDController* pid = &system.runner.pid;
+    ValveSimulator* valve = &system.runner.valve;
     
     system.running = true;
     system.current_time = 0.0f;
     
     printf("Testing Setpoint Ramping\n");
-    printf("- Derivative filtering: 0.1\n");
-    printf("- Rate limiting: 100%%/second\n");
-    printf("- Setpoint ramp rate: 10%%/second\n\n");
+    printf("- Derivative filtering: %.1f\n", scenario.derivative_filter);
+    printf("- Rate limiting: %.0f%%/second\n", scenario.rate_limit);
+    printf("- Setpoint ramp rate: %.0f%%/second\n\n", scenario.ramp_rate);
     printf("Time(s)  Setpoint  Position  Error     Command\n");
     printf("-------  --------  --------  --------  --------\n");
     
-    float dt = system.pid.sample_time;
+    float previous_target = pid->setpoint_target;
+    long print_ticks = lroundf(0.5f / scenario.sample_time);
     
-    while (system.running && system.current_time < 10.0f) {
+    while (system.running && scenario_runner_step(&system.runner)) {
+        system.current_time = system.runner.time;
         
-        // Setpoint change at 5 seconds
-        if (system.current_time >= 5.0f && system.current_time < 5.01f) {
-            pid_set_setpoint_ramped(&system.pid, 75.0f);
-            printf("\n>>> Setpoint ramp to 75.0%% started (10%%/sec) <<<\n\n");
+        // Setpoint change (scheduled by the scenario)
+        if (pid->setpoint_target != previous_target) {
+            printf("\n>>> Setpoint ramp to %.1f%% started (%.0f%%/sec) <<<\n\n",
+                   pid->setpoint_target, scenario.ramp_rate);
+            previous_target = pid->setpoint_target;
         }
         
-        // Compute control signal
-        float control_signal = pid_compute(&system.pid, system.valve.position);
-        
-        // Clamp to valve range
-        if (control_signal < 0.0f) control_signal = 0.0f;
-        if (control_signal > 100.0f) control_signal = 100.0f;
-        
-        // Update valve
-        valve_update(&system.valve, control_signal, dt);
-        
         // Calculate monitoring values
-        system.position_error = system.pid.setpoint - system.valve.position;
-        system.control_effort = control_signal;
+        system.position_error = pid->setpoint - valve->position;
+        system.control_effort = system.runner.command;
         
         // Print every 0.5 seconds
-        if (fmod(system.current_time, 0.5f) < 0.01f) {
+        if ((system.runner.tick - 1) % print_ticks == 0) {
             printf("%.2f      %.1f     %.1f      %.1f       %.1f\n",
                 system.current_time, 
-                system.pid.setpoint,
-                system.valve.position, 
+                pid->setpoint,
+                valve->position, 
                 system.position_error, 
                 system.control_effort);
         }
         
         // Log every timestep
-        fprintf(log_file, "%.2f,%.1f,%.1f,%.1f,%.1f\n",
-                system.current_time, 
-                system.pid.setpoint,
-                system.valve.position, 
-                system.position_error, 
-                system.control_effort);
-        
-        system.current_time += dt;
+        TelemetryRecord record = {
+            .time = system.current_time,
+            .setpoint = pid->setpoint,
+            .position = valve->position,
+            .error = system.position_error,
+            .command = system.control_effort,
+            .integral = pid->integral,
+            .derivative_filtered = pid->derivative_filtered
+        };
+        telemetry_log_push(&telemetry, &record);
     }
     
     printf("\n=== Test Complete ===\n");
-    printf("Final Position: %.1f%%\n", system.valve.position);
+    printf("Final Position: %.1f%%\n", valve->position);
     printf("Final Error: %.1f%%\n", system.position_error);
     
-    fclose(log_file);
+    int log_status = telemetry_log_close(&telemetry);
+    scenario_free(&scenario);
+    if (log_status != 0) {
+        printf("Error writing setpoint_ramping_test.bin!\n");
+        return -1;
+    }
+    if (telemetry_export_csv("setpoint_ramping_test.bin", "setpoint_ramping_test.csv", 0) < 0) {
+        printf("Error writing setpoint_ramping_test.csv!\n");
+        return -1;
+    }
     printf("\nData logged to setpoint_ramping_test.csv\n");
     
     return 0;
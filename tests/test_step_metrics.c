@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <math.h>
+#include "pid_controller.h"
+#include "step_metrics.h"
+#include "test_check.h"
+
+#define SAMPLE_TIME 0.01f
+#define TAU         0.5f
+
+int main() {
+    PIDController pid;
+    StepMetrics metrics;
+
+    printf("Testing Streaming Step-Response Metrics\n\n");
+    printf("Metric                                 Measured    Expected\n");
+    printf("-------------------------------------  ----------  ----------\n");
+
+    pid_init(&pid, 1.0f, 0.0f, 0.0f, SAMPLE_TIME);
+    step_metrics_init(&metrics, 0.01f, 0.95f, 0.0f, 100.0f);
+
+    // 1) Ideal first-order rise from 50% to 75%: analytic metrics known
+    pid_set_setpoint(&pid, 75.0f);
+    for (int k = 0; k < 1000; k++) {
+        float t = k * SAMPLE_TIME;
+        float y = 50.0f + 25.0f * (1.0f - expf(-t / TAU));
+        step_metrics_update(&metrics, &pid, y, k < 10 ? 100.0f : 60.0f);
+    }
+    check("Rise time 95% (s)", metrics.rise_time, -TAU * logf(0.05f), SAMPLE_TIME);
+    check("Settling time +/-1% (s)", metrics.settling_time, TAU * logf(25.0f / 0.75f), SAMPLE_TIME);
+    check("Overshoot (%)", metrics.overshoot, 0.0f, 1e-6f);
+    // Rectangular rule overestimates by about error(0)^n * dt / 2
+    check("IAE", (float)metrics.iae, 25.0f * TAU, 0.2f);
+    check("ISE", (float)metrics.ise, 625.0f * TAU / 2.0f, 4.0f);
+    check("ITAE", (float)metrics.itae, 25.0f * TAU * TAU, 0.2f);
+    check("Saturation time (s)", metrics.saturation_time, 10 * SAMPLE_TIME, 1e-4f);
+
+    // 2) Falling step with a 10% undershoot past the target, then settle
+    pid_set_setpoint(&pid, 25.0f);
+    check("Reset on setpoint change", (float)metrics.samples, 1000.0f, 0.0f);
+    step_metrics_update(&metrics, &pid, 75.0f, 0.0f);
+    check("Samples after reset", (float)metrics.samples, 1.0f, 0.0f);
+    step_metrics_update(&metrics, &pid, 40.0f, 0.0f);
+    step_metrics_update(&metrics, &pid, 20.0f, 0.0f);
+    for (int k = 0; k < 100; k++) step_metrics_update(&metrics, &pid, 25.0f, 25.0f);
+    check("Falling rise time (s)", metrics.rise_time, 2 * SAMPLE_TIME, 1e-6f);
+    check("Falling overshoot (%)", metrics.overshoot, 10.0f, 1e-4f);
+    check("Falling settling time (s)", metrics.settling_time, 3 * SAMPLE_TIME, 1e-6f);
+    check("Steady-state error", metrics.final_error, 0.0f, 1e-6f);
+
+    // 3) Ramped setpoint change also restarts the metrics
+    pid_set_ramp_rate(&pid, 10.0f);
+    pid_set_setpoint_ramped(&pid, 60.0f);
+    step_metrics_update(&metrics, &pid, 25.0f, 30.0f);
+    check("Ramped target", metrics.target, 60.0f, 0.0f);
+    check("Ramped start position", metrics.start_position, 25.0f, 0.0f);
+
+    // 4) A step to 0% settles once inside the minimum band
+    pid_set_ramp_rate(&pid, 0.0f);
+    pid_set_setpoint(&pid, 0.0f);
+    step_metrics_update(&metrics, &pid, 25.0f, 0.0f);
+    for (int k = 0; k < 100; k++) step_metrics_update(&metrics, &pid, 0.05f, 0.0f);
+    check("Settling time to 0% (s)", metrics.settling_time, 1 * SAMPLE_TIME, 1e-6f);
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
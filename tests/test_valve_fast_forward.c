@@ -0,0 +1,170 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "pid_controller.h"
+#include "valve_simulator.h"
+
+#define SAMPLE_TIME     0.01f
+#define HORIZON_S       3600.0       // One hour of simulated operation
+#define EVENT_PERIOD_S  600.0        // Setpoint change every 10 minutes
+#define QUIET_STEPS     50           // Steps of steady state before fast-forwarding
+#define QUIET_ERROR     0.001f       // |error| considered steady (%)
+#define QUIET_DELTA     0.0001f      // |command change| considered steady (%)
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static float clamp_command(float c) {
+    if (c < 0.0f) c = 0.0f;
+    if (c > 100.0f) c = 100.0f;
+    return c;
+}
+
+// 1) valve_fast_forward() must match repeated valve_update() calls
+static float check_fast_forward(float deadband) {
+    static const float commands[] = {30.0f, 120.0f, -20.0f, 100.0f, 55.5f};
+    static const float starts[] = {0.0f, 50.0f, 100.0f, 80.0f, 12.0f};
+    static const long counts[] = {2, 10, 1000, 100000};
+    float worst = 0.0f;
+
+    for (int c = 0; c < 5; c++) {
+        for (int n = 0; n < 4; n++) {
+            ValveSimulator stepped, jumped;
+            valve_init(&stepped, 0.2f, deadband);
+            stepped.position = starts[c];
+            jumped = stepped;
+
+            for (long i = 0; i < counts[n]; i++) valve_update(&stepped, commands[c], SAMPLE_TIME);
+            valve_fast_forward(&jumped, commands[c], SAMPLE_TIME, counts[n]);
+
+            float diff = fabsf(stepped.position - jumped.position);
+            if (diff > worst) worst = diff;
+            diff = fabsf(stepped.velocity - jumped.velocity) * SAMPLE_TIME;
+            if (diff > worst) worst = diff;
+        }
+    }
+    return worst;
+}
+
+// 2) Exact discretization matches the continuous solution even for dt > tau
+static float check_large_step(void) {
+    ValveSimulator valve;
+    valve_init(&valve, 0.2f, 0.0f);
+    valve_update(&valve, 50.0f, 0.5f);
+    float analytic = 50.0f * (1.0f - expf(-0.5f / 0.2f));
+    return fabsf(valve.position - analytic);
+}
+
+// 3) One hour closed loop: full rate vs multi-rate with fast-forward
+typedef struct {
+    float final_position;
+    float event_positions[8];
+    long plant_steps;
+    double seconds;
+} HorizonRun;
+
+static float setpoint_for_event(int e) {
+    static const float setpoints[] = {50.0f, 75.0f, 30.0f, 60.0f, 45.0f, 90.0f};
+    return setpoints[e % 6];
+}
+
+static void run_horizon(HorizonRun* run, int fast_forward) {
+    PIDController pid;
+    ValveSimulator valve;
+
+    pid_init(&pid, 5.0f, 4.0f, 0.1f, SAMPLE_TIME);
+    valve_init(&valve, 0.2f, 0.0f);
+
+    long total_ticks = (long)(HORIZON_S / SAMPLE_TIME + 0.5);
+    long event_ticks = (long)(EVENT_PERIOD_S / SAMPLE_TIME + 0.5);
+    int quiet = 0;
+    float prev_command = 0.0f;
+    run->plant_steps = 0;
+
+    double t0 = now_s();
+    long tick = 0;
+    while (tick < total_ticks) {
+        if (tick % event_ticks == 0) {
+            int e = (int)(tick / event_ticks);
+            if (e > 0 && e <= 8) run->event_positions[e - 1] = valve.position;
+            pid_set_setpoint(&pid, setpoint_for_event(e));
+            quiet = 0;
+        }
+
+        float command = clamp_command(pid_compute(&pid, valve.position));
+
+        if (fabsf(pid.setpoint - valve.position) < QUIET_ERROR &&
+            fabsf(command - prev_command) < QUIET_DELTA) {
+            quiet++;
+        } else {
+            quiet = 0;
+        }
+        prev_command = command;
+
+        if (fast_forward && quiet >= QUIET_STEPS) {
+            // Steady state: hold the command and jump to the next event
+            long next_event = (tick / event_ticks + 1) * event_ticks;
+            if (next_event > total_ticks) next_event = total_ticks;
+            valve_fast_forward(&valve, command, SAMPLE_TIME, next_event - tick);
+            run->plant_steps++;
+            tick = next_event;
+            continue;
+        }
+
+        valve_update(&valve, command, SAMPLE_TIME);
+        run->plant_steps++;
+        tick++;
+    }
+    run->seconds = now_s() - t0;
+    run->final_position = valve.position;
+}
+
+int main() {
+    int failed = 0;
+
+    printf("Testing Exact Valve Discretization and Fast-Forward\n\n");
+
+    float ff_error = check_fast_forward(0.0f);
+    printf("Fast-forward vs stepping, max difference: %g%%\n", ff_error);
+    if (ff_error > 1e-3f) failed = 1;
+
+    float db_error = check_fast_forward(0.5f);
+    printf("Same with 0.5%% deadband, max difference: %g%%\n", db_error);
+    if (db_error > 1e-3f) failed = 1;
+
+    float large_error = check_large_step();
+    printf("dt = 2.5 tau step vs analytic solution:   %g%%\n", large_error);
+    if (large_error > 1e-4f) failed = 1;
+
+    HorizonRun full, multi;
+    run_horizon(&full, 0);
+    run_horizon(&multi, 1);
+
+    float max_diff = fabsf(full.final_position - multi.final_position);
+    for (int e = 0; e < 5; e++) {
+        float d = fabsf(full.event_positions[e] - multi.event_positions[e]);
+        if (d > max_diff) max_diff = d;
+    }
+
+    printf("\nOne hour closed loop (setpoint change every 10 min)\n");
+    printf("Mode        Plant steps  Wall time (ms)  Final position\n");
+    printf("----------  -----------  --------------  --------------\n");
+    printf("Full rate   %-11ld  %-14.3f  %.4f\n", full.plant_steps, full.seconds * 1000.0, full.final_position);
+    printf("Multi-rate  %-11ld  %-14.3f  %.4f\n", multi.plant_steps, multi.seconds * 1000.0, multi.final_position);
+    printf("\nSimulated/real time: full %.0fx, multi-rate %.0fx\n",
+           HORIZON_S / full.seconds, HORIZON_S / multi.seconds);
+    printf("Max position difference at events: %g%%\n", max_diff);
+    if (max_diff > 0.01f) failed = 1;
+
+    if (failed) {
+        printf("\n=== Test FAILED ===\n");
+        return 1;
+    }
+    printf("\n=== Test Complete ===\n");
+    return 0;
+}
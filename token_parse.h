@@ -0,0 +1,20 @@
+#ifndef TOKEN_PARSE_H
+#define TOKEN_PARSE_H
+
+#include <stdlib.h>
+#include <string.h>
+
+// Whitespace-separated text formats (.scn scenarios, replay candidates)
+// Lines are split with strtok_r(), so include this after defining
+// _POSIX_C_SOURCE.
+
+// Parse the next token as a number (returns 0 on success, -1 if missing or not a number)
+static inline int token_next_number(char** save, float* value) {
+    char* token = strtok_r(NULL, " \t\r\n", save);
+    if (token == NULL) return -1;
+    char* end;
+    *value = strtof(token, &end);
+    return (*end == '\0') ? 0 : -1;
+}
+
+#endif // TOKEN_PARSE_H
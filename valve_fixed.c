@@ -0,0 +1,35 @@
+#include <math.h>
+#include "valve_fixed.h"
+
+// Initialize fixed-point valve at 0% with precomputed lag coefficient
+// Same zero-order-hold discretization as valve_update(): alpha = 1 - exp(-dt/tau)
+void valve_q16_init(ValveSimulatorQ16* valve, float time_constant, float deadband, float dt) {
+    valve->position = 0;
+    valve->velocity = 0;
+    valve->time_constant = time_constant;
+    valve->deadband = deadband;
+    valve->dt = dt;
+    valve->c_alpha = Q16_FROM_FLOAT(1.0f - expf(-dt / time_constant));
+    valve->c_inv_dt = Q16_FROM_FLOAT(1.0f / dt);
+    valve->c_deadband = Q16_FROM_FLOAT(deadband);
+    valve->command = 0;
+    valve->disturbance = 0;
+}
+
+// Update valve physics for one fixed time step (first-order lag)
+void valve_q16_update(ValveSimulatorQ16* valve, q16_t command) {
+    valve->command = command;
+
+    q16_t effective_command = q16_add(valve->command, valve->disturbance);
+    q16_t gap = q16_sub(effective_command, valve->position);
+    if (gap < valve->c_deadband && gap > -valve->c_deadband) gap = 0; // Inside deadband
+    q16_t position_change = q16_mul(gap, valve->c_alpha);
+
+    valve->position = q16_clamp(q16_add(valve->position, position_change), 0, 100 * Q16_ONE);
+    valve->velocity = q16_mul(position_change, valve->c_inv_dt);
+}
+
+// Get current valve position (0-100%)
+q16_t valve_q16_get_position(const ValveSimulatorQ16* valve) {
+    return valve->position;
+}
@@ -0,0 +1,33 @@
+#ifndef VALVE_FIXED_H
+#define VALVE_FIXED_H
+
+#include "fixed_point.h"
+
+// Fixed-point (Q16.16) counterpart of ValveSimulator
+// The step size is fixed at init so the lag coefficient 1 - exp(-dt / tau)
+// and 1 / dt are precomputed.
+typedef struct {
+    // Current state
+    q16_t position; // Current valve position (0-100%)
+    q16_t velocity; // Rate of change (%/s)
+
+    // Physical parameters
+    float time_constant; // First-order lag time constant (seconds)
+    float deadband;      // Deadband zone (%)
+    float dt;            // Step size (seconds)
+
+    // Precomputed coefficients
+    q16_t c_alpha;    // 1 - exp(-dt / time_constant)
+    q16_t c_inv_dt;   // 1 / dt
+    q16_t c_deadband; // Deadband (%)
+
+    // Command input
+    q16_t command;     // Control signal from PID (%)
+    q16_t disturbance; // External force (%)
+} ValveSimulatorQ16;
+
+void valve_q16_init(ValveSimulatorQ16* valve, float time_constant, float deadband, float dt);
+void valve_q16_update(ValveSimulatorQ16* valve, q16_t command);
+q16_t valve_q16_get_position(const ValveSimulatorQ16* valve);
+
+#endif // VALVE_FIXED_H
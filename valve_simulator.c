@@ -1,3 +1,4 @@
+#include <math.h>
 #include "valve_simulator.h"
 
 // Initialize valve simulator with physical parameters
@@ -8,19 +9,40 @@ void valve_init(ValveSimulator* valve, float time_constant, float deadband) {
     valve->time_constant = time_constant;
     valve->deadband = deadband;
     valve->command = 0.0f;
+    valve->disturbance = 0.0f;
+    valve->cached_dt = 0.0f; // Forces the decay to be computed on first update
+    valve->cached_time_constant = 0.0f;
+    valve->decay = 0.0f;
+}
+
+// Rebuild the exact discretization for a new step size or time constant
+static void valve_update_decay(ValveSimulator* valve, float dt) {
+    valve->cached_dt = dt;
+    valve->cached_time_constant = valve->time_constant;
+    valve->decay = expf(-dt / valve->time_constant);
 }
 
 //Update valve physics for one time step using first-order lag model
 // Input: control command (-100 to +100%)
-// Update position and velocity based on time constant
+// Zero-order-hold discretization: with the command held over the step,
+// position moves exactly (1 - exp(-dt/tau)) of the way to the command.
+// Unlike forward Euler this stays accurate and stable for any dt.
 void valve_update(ValveSimulator* valve, float command, float dt) {
     valve->command = command;
 
+    if (dt != valve->cached_dt || valve->time_constant != valve->cached_time_constant) {
+        valve_update_decay(valve, dt);
+    }
+
     // Apply disturbance to the effective command
     float effective_command = valve->command + valve->disturbance;
 
+    // Deadband: the valve does not respond to commands within +/-deadband of its position
+    float gap = effective_command - valve->position;
+    if (fabsf(gap) < valve->deadband) gap = 0.0f;
+
     // First-order lag: position moves toward command exponentially
-    float position_change = (effective_command - valve->position) * (dt / valve->time_constant);
+    float position_change = gap * (1.0f - valve->decay);
     
     // Update position
     valve->position += position_change;
@@ -33,6 +55,55 @@ void valve_update(ValveSimulator* valve, float command, float dt) {
     valve->velocity = position_change / dt;
 }
 
+// Advance many samples with the command held constant
+// The unclamped trajectory u + (p0 - u) * decay^n approaches u monotonically,
+// so clamping the closed form once gives the same result as clamping every
+// step: the valve rises (or falls) until it hits 100% (0%) and stays there.
+// With a deadband the valve stops after the first step that brings it inside
+// +/-deadband of the command; that step count is also known in closed form.
+void valve_fast_forward(ValveSimulator* valve, float command, float dt, long steps) {
+    if (steps <= 0) return;
+    if (steps == 1) {
+        valve_update(valve, command, dt);
+        return;
+    }
+
+    valve->command = command;
+
+    double u = (double)command + valve->disturbance;
+    double p0 = valve->position;
+    double rate = (double)dt / valve->time_constant;
+
+    if (valve->deadband > 0.0f) {
+        double gap = fabs(u - p0);
+        if (gap < valve->deadband) {
+            valve->velocity = 0.0f;
+            return;
+        }
+        // Steps until gap * exp(-rate * k) < deadband
+        double moving = floor(log(gap / valve->deadband) / rate) + 1.0;
+        if (moving < (double)steps) {
+            valve_fast_forward(valve, command, dt, (long)moving);
+            double remaining = fabs(u - valve->position);
+            if (remaining < valve->deadband) valve->velocity = 0.0f;
+            return;
+        }
+    }
+
+    double before = u + (p0 - u) * exp(-rate * (double)(steps - 1));
+    if (before < 0.0) before = 0.0;
+    if (before > 100.0) before = 100.0;
+
+    // Last step taken from the clamped position, exactly as valve_update() does
+    double position_change = (u - before) * (1.0 - exp(-rate));
+    double after = before + position_change;
+    if (after < 0.0) after = 0.0;
+    if (after > 100.0) after = 100.0;
+
+    valve->position = (float)after;
+    valve->velocity = (float)(position_change / dt);
+}
+
 // Get current valve position (0-100%)
 float valve_get_position(ValveSimulator* valve) {
     return valve->position;
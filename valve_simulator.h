@@ -15,9 +15,19 @@ typedef struct {
     
     // External disturbance
     float disturbance; // External force a(%))
+
+    // Cached discretization (recomputed only when dt or time_constant change)
+    float cached_dt;            // Step size the cache was built for
+    float cached_time_constant; // Time constant the cache was built for
+    float decay;                // exp(-dt / time_constant)
 } ValveSimulator;
 
 void valve_update(ValveSimulator* valve, float command, float dt);
 float valve_get_position(ValveSimulator* valve);
 void valve_init(ValveSimulator* valve, float time_constant, float deadband);
-#endif // VALVE_SIMULATOR_H
\ No newline at end of file
+
+// Advance by steps samples of constant command in one call
+// Gives the same result as calling valve_update() steps times (including
+// saturation at 0/100%), in constant time.
+void valve_fast_forward(ValveSimulator* valve, float command, float dt, long steps);
+#endif // VALVE_SIMULATOR_H
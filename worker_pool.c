@@ -0,0 +1,54 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include "worker_pool.h"
+
+typedef struct {
+    WorkerItemFunction item;
+    void* context;
+    long count;
+    atomic_long next;
+} WorkerPool;
+
+int worker_pool_threads(int requested, long count) {
+    int threads = (requested >= 1) ? requested : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads > WORKER_POOL_MAX_THREADS) threads = WORKER_POOL_MAX_THREADS;
+    if (threads > count) threads = (int)count;
+    if (threads < 1) threads = 1;
+    return threads;
+}
+
+static void* worker_pool_thread(void* arg) {
+    WorkerPool* pool = (WorkerPool*)arg;
+    long i;
+    while ((i = atomic_fetch_add_explicit(&pool->next, 1, memory_order_relaxed)) < pool->count) {
+        pool->item(pool->context, i);
+    }
+    return NULL;
+}
+
+int worker_pool_run(long count, int num_threads, WorkerItemFunction item, void* context) {
+    WorkerPool pool;
+    pool.item = item;
+    pool.context = context;
+    pool.count = count;
+    atomic_init(&pool.next, 0);
+
+    if (num_threads > WORKER_POOL_MAX_THREADS) num_threads = WORKER_POOL_MAX_THREADS;
+
+    // The calling thread is one of the workers; stop at the first failure
+    pthread_t threads[WORKER_POOL_MAX_THREADS];
+    int started = 0;
+    while (started < num_threads - 1 &&
+           pthread_create(&threads[started], NULL, worker_pool_thread, &pool) == 0) {
+        started++;
+    }
+
+    worker_pool_thread(&pool);
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    return started + 1;
+}
@@ -0,0 +1,23 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+// Run independent work items on a handful of threads
+// Items are handed out one at a time from a shared counter, so long and
+// short items balance out. The calling thread works too: if a thread cannot
+// be started the run still completes, just with less parallelism, and only
+// the threads that did start are joined.
+
+#define WORKER_POOL_MAX_THREADS 64
+
+// Process item index (called concurrently for different indices)
+typedef void (*WorkerItemFunction)(void* context, long index);
+
+// Thread count for count items: requested, or one per online CPU when
+// requested < 1, limited to WORKER_POOL_MAX_THREADS and to count
+int worker_pool_threads(int requested, long count);
+
+// Call item(context, i) for every i in [0, count) on up to num_threads threads
+// Returns when all items are done, with the number of threads that ran them
+int worker_pool_run(long count, int num_threads, WorkerItemFunction item, void* context);
+
+#endif // WORKER_POOL_H